@@ -0,0 +1,91 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal adc 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_adc [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 adc 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_read_raw(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_resolution(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_sample_rate(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_read_raw(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_adc_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_adc_read_raw",        bench_read_raw},
+    {"xf_hal_adc_set_resolution",  bench_set_resolution},
+    {"xf_hal_adc_set_sample_rate", bench_set_sample_rate},
+    {"xf_hal_adc_handle_read_raw", bench_handle_read_raw},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_adc_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_adc_init(i);
+        s_handles[i] = xf_hal_adc_get_handle(i);
+    }
+
+    bench_suite_run("adc", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_read_raw(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_adc_read_raw(dev);
+    return 0;
+}
+
+static int bench_set_resolution(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_adc_set_resolution(dev, 12) != XF_OK;
+}
+
+static int bench_set_sample_rate(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_adc_set_sample_rate(dev, 1000) != XF_OK;
+}
+
+static int bench_handle_read_raw(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_adc_handle_read_raw(s_handles[dev]);
+    return 0;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file bench.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 主机端性能测试运行器。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "bench.h"
+#include <pthread.h>
+#include <stdio.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _worker_t {
+    pthread_t thread;
+    bench_fn_t fn;
+    uint32_t index;
+    uint32_t dev_num;
+    uint32_t dev_start;
+    uint32_t iters;
+    uint32_t errors;
+    void *scratch[BENCH_SCRATCH_SIZE / sizeof(void *)];
+} worker_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void *bench_worker(void *arg);
+static void bench_case_run(const char *name, bench_fn_t fn, const bench_opts_t *opts, bool *first);
+static int bench_nop(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_opts_parse(bench_opts_t *opts, int argc, char *argv[], uint32_t dev_num, uint32_t iters)
+{
+    uint32_t values[3] = {dev_num, 8, iters};
+    uint32_t count = 0;
+
+    opts->json = false;
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--json") == 0) {
+            opts->json = true;
+        } else if (count < 3) {
+            values[count++] = (uint32_t)strtoul(argv[i], NULL, 0);
+        }
+    }
+
+    opts->dev_num = values[0] ? values[0] : 1;
+    opts->max_threads = values[1] ? values[1] : 1;
+    opts->iters = values[2] ? values[2] : 1;
+}
+
+void bench_suite_run(const char *suite, const bench_case_t *cases, size_t case_num, const bench_opts_t *opts)
+{
+    bool first = true;
+
+    if (opts->json) {
+        printf("{\"suite\":\"%s\",\"devices\":%u,\"iterations\":%u,\"results\":[\n",
+               suite, opts->dev_num, opts->iters);
+    } else {
+        printf("suite:%s devices:%u iterations/thread:%u\n", suite, opts->dev_num, opts->iters);
+        printf("%-36s %8s %12s %12s %8s\n", "case", "threads", "Mcall/s", "ns/call", "errors");
+    }
+
+    bench_case_run("loop_overhead", bench_nop, opts, &first);
+    for (size_t i = 0; i < case_num; i++) {
+        bench_case_run(cases[i].name, cases[i].fn, opts, &first);
+    }
+
+    if (opts->json) {
+        printf("\n]}\n");
+    }
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void *bench_worker(void *arg)
+{
+    worker_t *worker = (worker_t *)arg;
+    bench_fn_t fn = worker->fn;
+    uint32_t index = worker->index;
+    uint32_t dev = worker->dev_start;
+    uint32_t errors = 0;
+
+    for (uint32_t i = 0; i < worker->iters; i++) {
+        if (fn(dev, index, worker->scratch) != 0) {
+            errors++;
+        }
+        if (++dev == worker->dev_num) {
+            dev = 0;
+        }
+    }
+    worker->errors = errors;
+
+    return NULL;
+}
+
+static void bench_case_run(const char *name, bench_fn_t fn, const bench_opts_t *opts, bool *first)
+{
+    for (uint32_t threads = 1; threads <= opts->max_threads; threads *= 2) {
+        worker_t *workers = calloc(threads, sizeof(worker_t));
+        uint32_t errors = 0;
+        uint64_t start = bench_now_ns();
+
+        // 各线程从不同设备开始轮换，减少多个线程同时访问同一设备
+        for (uint32_t t = 0; t < threads; t++) {
+            workers[t].fn = fn;
+            workers[t].index = t;
+            workers[t].dev_num = opts->dev_num;
+            workers[t].dev_start = (uint32_t)((uint64_t)t * opts->dev_num / threads);
+            workers[t].iters = opts->iters;
+            pthread_create(&workers[t].thread, NULL, bench_worker, &workers[t]);
+        }
+        for (uint32_t t = 0; t < threads; t++) {
+            pthread_join(workers[t].thread, NULL);
+            errors += workers[t].errors;
+        }
+
+        uint64_t elapsed = bench_now_ns() - start;
+        double total = (double)threads * opts->iters;
+        double mops = total * 1000.0 / elapsed;
+        double ns = (double)elapsed * threads / total;
+
+        if (opts->json) {
+            printf("%s{\"name\":\"%s\",\"threads\":%u,\"ns_per_call\":%.2f,\"mcall_per_s\":%.2f,\"errors\":%u}",
+                   *first ? "" : ",\n", name, threads, ns, mops, errors);
+            *first = false;
+        } else {
+            printf("%-36s %8u %12.2f %12.2f %8u\n", name, threads, mops, ns, errors);
+        }
+        free(workers);
+    }
+}
+
+static int bench_nop(uint32_t dev, uint32_t thread, void *scratch)
+{
+    (void)dev;
+    (void)thread;
+    (void)scratch;
+    return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * @file bench.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 主机端性能测试公共接口。
+ * @version 0.1
+ * @date 2024-07-15
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <time.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define BENCH_SCRATCH_SIZE  256     /*!< 每个线程的临时缓冲区大小 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 命令行参数：[设备数] [最大线程数] [每线程调用次数] [--json]
+ */
+typedef struct _bench_opts_t {
+    uint32_t dev_num;       /*!< 打开的设备数 */
+    uint32_t max_threads;   /*!< 线程数从 1 倍增到该值 */
+    uint32_t iters;         /*!< 每个线程调用次数 */
+    bool json;              /*!< 输出 JSON，否则输出表格 */
+} bench_opts_t;
+
+/**
+ * @brief 被测调用。
+ *
+ * @param dev 本次使用的设备序号，在 [0, dev_num) 之间轮换。
+ * @param thread 当前线程序号。
+ * @param scratch 当前线程独占的 BENCH_SCRATCH_SIZE 字节临时缓冲区，已按指针对齐。
+ * @return int 0 表示成功，非 0 计入错误次数
+ */
+typedef int (*bench_fn_t)(uint32_t dev, uint32_t thread, void *scratch);
+
+typedef struct _bench_case_t {
+    const char *name;
+    bench_fn_t fn;
+} bench_case_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 注册所有设备类型的空驱动。空驱动不访问任何硬件，读写直接返回 count。
+ */
+void bench_port_init(void);
+
+/**
+ * @brief 解析命令行参数，未给出的参数使用默认值。
+ */
+void bench_opts_parse(bench_opts_t *opts, int argc, char *argv[], uint32_t dev_num, uint32_t iters);
+
+/**
+ * @brief 依次运行测试用例，每个用例在 1 到 max_threads 个线程下各运行一次，
+ *        结果输出到标准输出。第一行为空调用的循环开销。
+ *
+ * @param suite 测试集名称。
+ * @param cases 测试用例。
+ * @param case_num 测试用例数量。
+ * @param opts 命令行参数。
+ */
+void bench_suite_run(const char *suite, const bench_case_t *cases, size_t case_num, const bench_opts_t *opts);
+
+/* ==================== [Macros] ============================================ */
+
+static inline uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+static inline uint32_t bench_arg(int argc, char *argv[], int index, uint32_t def)
+{
+    return (argc > index) ? (uint32_t)strtoul(argv[index], NULL, 0) : def;
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __BENCH_H__
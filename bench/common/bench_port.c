@@ -0,0 +1,116 @@
+/**
+ * @file bench_port.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 性能测试使用的空驱动，用于测量 xf_hal 自身的开销。
+ * @version 0.1
+ * @date 2024-07-15
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "bench.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int null_open(xf_hal_dev_t *dev);
+static int null_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int null_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int null_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int null_close(xf_hal_dev_t *dev);
+static int null_dac_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int null_dac_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+
+/* ==================== [Static Variables] ================================== */
+
+static const xf_driver_ops_t null_ops = {
+    .open = null_open,
+    .ioctl = null_ioctl,
+    .write = null_write,
+    .read = null_read,
+    .close = null_close,
+};
+
+// dac 需要对接层在默认参数中给出数值范围，写入成功时返回 0
+static const xf_driver_ops_t null_dac_ops = {
+    .open = null_open,
+    .ioctl = null_dac_ioctl,
+    .write = null_dac_write,
+    .read = null_read,
+    .close = null_close,
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void bench_port_init(void)
+{
+    xf_hal_gpio_register(&null_ops);
+    xf_hal_tim_register(&null_ops);
+    xf_hal_pwm_register(&null_ops);
+    xf_hal_adc_register(&null_ops);
+    xf_hal_dac_register(&null_dac_ops);
+    xf_hal_uart_register(&null_ops);
+    xf_hal_i2c_register(&null_ops);
+    xf_hal_spi_register(&null_ops);
+}
+
+// 开启静态分发时各类型同样绑定到空驱动
+XF_HAL_PORT_EXPORT(GPIO, null_ioctl, null_read, null_write)
+XF_HAL_PORT_EXPORT(TIM, null_ioctl, null_read, null_write)
+XF_HAL_PORT_EXPORT(PWM, null_ioctl, null_read, null_write)
+XF_HAL_PORT_EXPORT(ADC, null_ioctl, null_read, null_write)
+XF_HAL_PORT_EXPORT(DAC, null_dac_ioctl, null_read, null_dac_write)
+XF_HAL_PORT_EXPORT(UART, null_ioctl, null_read, null_write)
+XF_HAL_PORT_EXPORT(I2C, null_ioctl, null_read, null_write)
+XF_HAL_PORT_EXPORT(SPI, null_ioctl, null_read, null_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int null_open(xf_hal_dev_t *dev)
+{
+    return 0;
+}
+
+static int null_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    return 0;
+}
+
+static int null_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    return (int)count;
+}
+
+static int null_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    return (int)count;
+}
+
+static int null_close(xf_hal_dev_t *dev)
+{
+    return 0;
+}
+
+static int null_dac_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    if (cmd == XF_HAL_DAC_CMD_DEFAULT) {
+        xf_hal_dac_config_t *dac_config = (xf_hal_dac_config_t *)config;
+        dac_config->value_max = 4095;
+        dac_config->verf_mv = 3300;
+    }
+    return 0;
+}
+
+static int null_dac_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    return 0;
+}
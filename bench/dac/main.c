@@ -0,0 +1,96 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal dac 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_dac [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 dac 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_write_mv(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_resolution(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_speed(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_dac_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_dac_write",          bench_write},
+    {"xf_hal_dac_write_mv",       bench_write_mv},
+    {"xf_hal_dac_set_resolution", bench_set_resolution},
+    {"xf_hal_dac_set_speed",      bench_set_speed},
+    {"xf_hal_dac_handle_write",   bench_handle_write},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_dac_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_dac_init(i);
+        s_handles[i] = xf_hal_dac_get_handle(i);
+    }
+
+    bench_suite_run("dac", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_dac_write(dev, 100) != XF_OK;
+}
+
+static int bench_write_mv(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_dac_write_mv(dev, 1000) != XF_OK;
+}
+
+static int bench_set_resolution(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_dac_set_resolution(dev, 12) != XF_OK;
+}
+
+static int bench_set_speed(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_dac_set_speed(dev, 1000) != XF_OK;
+}
+
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_dac_handle_write(s_handles[dev], 100) != XF_OK;
+}
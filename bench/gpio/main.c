@@ -0,0 +1,129 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal gpio 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_gpio [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 gpio 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_set_level(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_get_level(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_direction(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_pull(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_speed(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_intr_type(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_config_commit(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_set_level(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_get_level(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_gpio_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_gpio_set_level",        bench_set_level},
+    {"xf_hal_gpio_get_level",        bench_get_level},
+    {"xf_hal_gpio_set_direction",    bench_set_direction},
+    {"xf_hal_gpio_set_pull",         bench_set_pull},
+    {"xf_hal_gpio_set_speed",        bench_set_speed},
+    {"xf_hal_gpio_set_intr_type",    bench_set_intr_type},
+    {"xf_hal_gpio_config_commit",    bench_config_commit},
+    {"xf_hal_gpio_handle_set_level", bench_handle_set_level},
+    {"xf_hal_gpio_handle_get_level", bench_handle_get_level},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_gpio_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_gpio_init(i, XF_HAL_GPIO_DIR_OUT);
+        s_handles[i] = xf_hal_gpio_get_handle(i);
+    }
+
+    bench_suite_run("gpio", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_set_level(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_gpio_set_level(dev, dev & 0x01) < XF_OK;
+}
+
+static int bench_get_level(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_gpio_get_level(dev);
+    return 0;
+}
+
+static int bench_set_direction(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_gpio_set_direction(dev, XF_HAL_GPIO_DIR_OUT) != XF_OK;
+}
+
+static int bench_set_pull(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_gpio_set_pull(dev, XF_HAL_GPIO_PULL_UP) != XF_OK;
+}
+
+static int bench_set_speed(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_gpio_set_speed(dev, 1000000) != XF_OK;
+}
+
+static int bench_set_intr_type(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_gpio_set_intr_type(dev, XF_HAL_GPIO_INTR_TYPE_RISING) != XF_OK;
+}
+
+static int bench_config_commit(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_gpio_config_begin(dev);
+    xf_hal_gpio_set_pull(dev, XF_HAL_GPIO_PULL_UP);
+    xf_hal_gpio_set_speed(dev, 1000000);
+    return xf_hal_gpio_config_commit(dev) != XF_OK;
+}
+
+static int bench_handle_set_level(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_gpio_handle_set_level(s_handles[dev], dev & 0x01) < XF_OK;
+}
+
+static int bench_handle_get_level(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_gpio_handle_get_level(s_handles[dev]);
+    return 0;
+}
@@ -0,0 +1,152 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal i2c 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_i2c [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 i2c 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define DATA_SIZE   16
+#define TIMEOUT_MS  100
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_write_mem(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_read_mem(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_writev(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_address(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_address_width(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_mem_addr_width(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_read(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_write_mem(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_read_mem(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_i2c_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_i2c_write",              bench_write},
+    {"xf_hal_i2c_read",               bench_read},
+    {"xf_hal_i2c_write_mem",          bench_write_mem},
+    {"xf_hal_i2c_read_mem",           bench_read_mem},
+    {"xf_hal_i2c_writev",             bench_writev},
+    {"xf_hal_i2c_set_address",        bench_set_address},
+    {"xf_hal_i2c_set_address_width",  bench_set_address_width},
+    {"xf_hal_i2c_set_mem_addr_width", bench_set_mem_addr_width},
+    {"xf_hal_i2c_handle_write",       bench_handle_write},
+    {"xf_hal_i2c_handle_read",        bench_handle_read},
+    {"xf_hal_i2c_handle_write_mem",   bench_handle_write_mem},
+    {"xf_hal_i2c_handle_read_mem",    bench_handle_read_mem},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_i2c_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_i2c_init(i, XF_HAL_I2C_HOSTS_MASTER, 400000);
+        s_handles[i] = xf_hal_i2c_get_handle(i);
+    }
+
+    bench_suite_run("i2c", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_write(dev, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_read(dev, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_write_mem(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_write_mem(dev, 0x10, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_read_mem(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_read_mem(dev, 0x10, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_writev(uint32_t dev, uint32_t thread, void *scratch)
+{
+    uint8_t *buf = scratch;
+    xf_hal_iovec_t iov[] = {
+        {buf, 2}, {buf + 2, DATA_SIZE - 2},
+    };
+    return xf_hal_i2c_writev(dev, iov, 2, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_set_address(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_set_address(dev, 0x50) != XF_OK;
+}
+
+static int bench_set_address_width(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_set_address_width(dev, XF_HAL_I2C_ADDRESS_WIDTH_7BIT) != XF_OK;
+}
+
+static int bench_set_mem_addr_width(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_set_mem_addr_width(dev, XF_HAL_I2C_MEM_ADDR_WIDTH_8BIT) != XF_OK;
+}
+
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_handle_write(s_handles[dev], scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_handle_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_handle_read(s_handles[dev], scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_handle_write_mem(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_handle_write_mem(s_handles[dev], 0x10, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_handle_read_mem(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_i2c_handle_read_mem(s_handles[dev], 0x10, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
@@ -0,0 +1,153 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal kernel 查找与分发路径性能测试。
+ * @version 0.1
+ * @date 2024-07-15
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_kernel [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 线程数从 1 开始倍增到最大线程数，输出每种线程数下的吞吐量与单次耗时。
+ * 另有一个线程持续打开、关闭一个额外设备，用于模拟注册表的并发修改。
+ * find(index) 只查找 id 小于 XF_HAL_DEV_INDEX_SIZE 的设备，find(hash) 只查找经哈希桶的设备，
+ * 设备数不超过直接索引表时自动增加到其两倍。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "../../src/kernel/xf_hal_dev.h"
+#include "../../src/kernel/xf_hal_atomic.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <pthread.h>
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define CHURN_ID    0xFFFF
+#define MISS_ID     0xFFFE
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void *churn_worker(void *arg);
+static int bench_find(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_find_index(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_find_hash(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_find_miss(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_driver_ioctl(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_driver_read(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_driver_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_dev_write(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static int s_running = 0;
+static xf_hal_dev_t **s_devs = NULL;
+static uint32_t s_dev_num = 0;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_device_find",          bench_find},
+    {"xf_hal_device_find(index)",   bench_find_index},
+    {"xf_hal_device_find(hash)",    bench_find_hash},
+    {"xf_hal_device_find(miss)",    bench_find_miss},
+    {"xf_hal_driver_ioctl",         bench_driver_ioctl},
+    {"xf_hal_driver_read",          bench_driver_read},
+    {"xf_hal_driver_write",         bench_driver_write},
+    {"xf_hal_dev_write",            bench_dev_write},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+    pthread_t churn;
+
+    bench_opts_parse(&opts, argc, argv, 128, 2000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    // 哈希查找的用例需要 id 超出直接索引表的设备
+    if (opts.dev_num <= XF_HAL_DEV_INDEX_SIZE) {
+        opts.dev_num = XF_HAL_DEV_INDEX_SIZE * 2;
+    }
+
+    s_dev_num = opts.dev_num;
+    s_devs = calloc(opts.dev_num, sizeof(xf_hal_dev_t *));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_gpio_init(i, XF_HAL_GPIO_DIR_OUT);
+        s_devs[i] = xf_hal_device_find(XF_HAL_GPIO, i);
+    }
+
+    XF_HAL_ATOMIC_STORE(&s_running, 1);
+    pthread_create(&churn, NULL, churn_worker, NULL);
+
+    bench_suite_run("kernel", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    XF_HAL_ATOMIC_STORE(&s_running, 0);
+    pthread_join(churn, NULL);
+    free(s_devs);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void *churn_worker(void *arg)
+{
+    while (XF_HAL_ATOMIC_LOAD(&s_running)) {
+        xf_hal_gpio_init(CHURN_ID, XF_HAL_GPIO_DIR_OUT);
+        xf_hal_gpio_deinit(CHURN_ID);
+    }
+
+    return NULL;
+}
+
+static int bench_find(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_device_find(XF_HAL_GPIO, dev) == NULL;
+}
+
+static int bench_find_index(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_device_find(XF_HAL_GPIO, dev % XF_HAL_DEV_INDEX_SIZE) == NULL;
+}
+
+static int bench_find_hash(uint32_t dev, uint32_t thread, void *scratch)
+{
+    uint32_t id = XF_HAL_DEV_INDEX_SIZE + dev % (s_dev_num - XF_HAL_DEV_INDEX_SIZE);
+    return xf_hal_device_find(XF_HAL_GPIO, id) == NULL;
+}
+
+static int bench_find_miss(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_device_find(XF_HAL_GPIO, MISS_ID - dev) != NULL;
+}
+
+static int bench_driver_ioctl(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_dev_t *d = s_devs[dev];
+    return xf_hal_driver_ioctl(d, 0x01, (uint8_t *)d + sizeof(xf_hal_dev_t)) != XF_OK;
+}
+
+static int bench_driver_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_driver_read(s_devs[dev], scratch, 1) != 1;
+}
+
+static int bench_driver_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_driver_write(s_devs[dev], scratch, 1) != 1;
+}
+
+static int bench_dev_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_dev_write(s_devs[dev], scratch, 1) != 1;
+}
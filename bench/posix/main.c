@@ -0,0 +1,146 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal posix 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_posix [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 posix 层（路径解析、fd 表查找）的开销。
+ * 需要以 XF_HAL_POSIX_DISABLE=0 编译，常驻设备与每个线程的 open/close 各占一个 fd，
+ * 设备数会被限制在 XF_HAL_POSIX_FD_MAX - 线程数以内。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "../../src/kernel/xf_hal_posix.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define DATA_SIZE   16
+#define CYCLE_ID    0x8000  /*!< open/close 测试使用的设备 id 起点，避免与常驻设备冲突 */
+#define DEV_NUM_MAX 0x0400  /*!< 每个线程 open/close 测试使用的设备 id 数量，最多支持 32 个线程 */
+#define POLL_NFDS   8       /*!< 每次 poll 检查的 fd 数量 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_ioctl(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_open_close(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_open_dup(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_poll(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static int *s_fds = NULL;
+static char (*s_paths)[DATA_SIZE] = NULL;
+static uint32_t s_dev_num = 0;
+
+static const bench_case_t s_cases[] = {
+    {"write",       bench_write},
+    {"read",        bench_read},
+    {"ioctl",       bench_ioctl},
+    {"open(close)", bench_open_close},
+    {"open(dup)",   bench_open_dup},
+    {"poll(8)",     bench_poll},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+    if (opts.dev_num > DEV_NUM_MAX) {
+        opts.dev_num = DEV_NUM_MAX;
+    }
+    if (opts.dev_num + opts.max_threads > XF_HAL_POSIX_FD_MAX) {
+        opts.dev_num = (XF_HAL_POSIX_FD_MAX > opts.max_threads) ? XF_HAL_POSIX_FD_MAX - opts.max_threads : 1;
+    }
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_dev_num = opts.dev_num;
+    s_fds = calloc(opts.dev_num, sizeof(int));
+    s_paths = calloc(opts.dev_num, sizeof(s_paths[0]));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        snprintf(s_paths[i], sizeof(s_paths[i]), "UART%u", i);
+        s_fds[i] = open(s_paths[i], O_RDWR);
+    }
+
+    bench_suite_run("posix", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        close(s_fds[i]);
+    }
+    free(s_fds);
+    free(s_paths);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return write(s_fds[dev], scratch, DATA_SIZE) != DATA_SIZE;
+}
+
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return read(s_fds[dev], scratch, DATA_SIZE) != DATA_SIZE;
+}
+
+static int bench_ioctl(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return ioctl(s_fds[dev], XF_HAL_UART_CMD_BAUDRATE, scratch) != 0;
+}
+
+static int bench_open_close(uint32_t dev, uint32_t thread, void *scratch)
+{
+    char *path = scratch;
+
+    // 每个线程使用各自的设备 id 范围，避免重复打开
+    snprintf(path, DATA_SIZE, "UART%u", CYCLE_ID + thread * DEV_NUM_MAX + dev);
+    int fd = open(path, O_RDWR);
+    if (fd < 0) {
+        return 1;
+    }
+    return close(fd) != 0;
+}
+
+static int bench_open_dup(uint32_t dev, uint32_t thread, void *scratch)
+{
+    // 设备已常驻，只测路径解析与 fd 分配
+    int fd = open(s_paths[dev], O_RDWR);
+    if (fd < 0) {
+        return 1;
+    }
+    return close(fd) != 0;
+}
+
+static int bench_poll(uint32_t dev, uint32_t thread, void *scratch)
+{
+    struct pollfd fds[POLL_NFDS];
+
+    // 示例对接层不上报就绪状态，设备始终可读写，测得的是扫描开销
+    for (uint32_t i = 0; i < POLL_NFDS; i++) {
+        fds[i].fd = s_fds[(dev + i) % s_dev_num];
+        fds[i].events = POLLIN | POLLOUT;
+    }
+
+    return poll(fds, POLL_NFDS, 0) != POLL_NFDS;
+}
@@ -0,0 +1,129 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal pwm 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_pwm [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 pwm 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_set_duty(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_freq(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_duty_resolution(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_gpio(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_get_freq(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_get_duty(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_is_enable(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_enable_disable(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_set_duty(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_pwm_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_pwm_set_duty",            bench_set_duty},
+    {"xf_hal_pwm_set_freq",            bench_set_freq},
+    {"xf_hal_pwm_set_duty_resolution", bench_set_duty_resolution},
+    {"xf_hal_pwm_set_gpio",            bench_set_gpio},
+    {"xf_hal_pwm_get_freq",            bench_get_freq},
+    {"xf_hal_pwm_get_duty",            bench_get_duty},
+    {"xf_hal_pwm_is_enable",           bench_is_enable},
+    {"xf_hal_pwm_enable(disable)",     bench_enable_disable},
+    {"xf_hal_pwm_handle_set_duty",     bench_handle_set_duty},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_pwm_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_pwm_init(i, 1000, 512);
+        s_handles[i] = xf_hal_pwm_get_handle(i);
+    }
+
+    bench_suite_run("pwm", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_set_duty(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_pwm_set_duty(dev, 256) != XF_OK;
+}
+
+static int bench_set_freq(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_pwm_set_freq(dev, 2000) != XF_OK;
+}
+
+static int bench_set_duty_resolution(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_pwm_set_duty_resolution(dev, 10) != XF_OK;
+}
+
+static int bench_set_gpio(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_pwm_set_gpio(dev, 1) != XF_OK;
+}
+
+static int bench_get_freq(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_pwm_get_freq(dev) == 0;
+}
+
+static int bench_get_duty(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_pwm_get_duty(dev);
+    return 0;
+}
+
+static int bench_is_enable(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_pwm_is_enable(dev);
+    return 0;
+}
+
+static int bench_enable_disable(uint32_t dev, uint32_t thread, void *scratch)
+{
+    if (xf_hal_pwm_enable(dev) != XF_OK) {
+        return 1;
+    }
+    return xf_hal_pwm_disable(dev) != XF_OK;
+}
+
+static int bench_handle_set_duty(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_pwm_handle_set_duty(s_handles[dev], 256) != XF_OK;
+}
@@ -0,0 +1,315 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 仿真对接层上的线上吞吐测试。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_sim [每次传输的固定开销 ns]
+ * 时间均为 port_sim 的虚拟时间，结果只取决于配置参数与传输方式，与主机性能无关。
+ * 最后在虚拟外设上跑一遍完整的读写流程（eeprom 页写 + 应答轮询与排队的异步读、nor 擦写、uart 自环），
+ * 耗时包含器件本身的写周期。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_xf_lock.h"
+#include "port.h"
+#include "port_sim_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define TOTAL_SIZE  4096
+
+#define MODEL_EEPROM_I2C    1
+#define MODEL_EEPROM_ADDR   0x50
+#define MODEL_NOR_SPI       1
+#define MODEL_NOR_CS        10
+#define MODEL_LOOP_UART     2
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef int (*sim_xfer_t)(uint32_t num, const uint8_t *buf, uint32_t size);
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void sim_report(const char *name, uint32_t chunk, uint64_t bytes, uint64_t start);
+static void sim_chunked(const char *name, uint32_t num, sim_xfer_t xfer, uint32_t chunk);
+static int sim_uart_write(uint32_t num, const uint8_t *buf, uint32_t size);
+static int sim_spi_write(uint32_t num, const uint8_t *buf, uint32_t size);
+static int sim_i2c_write_mem(uint32_t num, const uint8_t *buf, uint32_t size);
+static void sim_async_overlap(void);
+static void sim_models(void);
+static void sim_eeprom(void);
+static void sim_nor(void);
+static uint8_t sim_nor_cmd(uint8_t cmd, uint32_t addr, const uint8_t *tx, uint8_t *rx, uint32_t size);
+static void sim_nor_wait(void);
+static void sim_uart_loopback(void);
+static void sim_check(const char *name, const uint8_t *a, const uint8_t *b, uint32_t size, uint64_t start);
+
+/* ==================== [Static Variables] ================================== */
+
+static uint8_t s_buf[TOTAL_SIZE];
+static const uint32_t s_chunks[] = {1, 16, 256, TOTAL_SIZE};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    uint32_t setup_ns = (argc > 1) ? (uint32_t)strtoul(argv[1], NULL, 0) : 2000;
+
+    port_xf_lock();
+    port_init();
+
+    port_sim_set_setup_ns(XF_HAL_UART, setup_ns);
+    port_sim_set_setup_ns(XF_HAL_SPI, setup_ns);
+    port_sim_set_setup_ns(XF_HAL_I2C, setup_ns);
+
+    printf("setup: %u ns per transfer, %u bytes per case\n", (unsigned)setup_ns, TOTAL_SIZE);
+    printf("%-24s %8s %12s %12s\n", "case", "chunk", "time(us)", "B/s");
+
+    xf_hal_uart_init(0, 115200);
+    for (size_t i = 0; i < sizeof(s_chunks) / sizeof(s_chunks[0]); i++) {
+        sim_chunked("uart 115200 8N1", 0, sim_uart_write, s_chunks[i]);
+    }
+
+    xf_hal_uart_set_baudrate(0, 921600);
+    xf_hal_uart_set_config(0, XF_HAL_UART_DATA_BIT_8, XF_HAL_UART_STOP_BIT_2, XF_HAL_UART_PARITY_BITS_EVEN);
+    for (size_t i = 0; i < sizeof(s_chunks) / sizeof(s_chunks[0]); i++) {
+        sim_chunked("uart 921600 8E2", 0, sim_uart_write, s_chunks[i]);
+    }
+
+    xf_hal_spi_init(0, XF_HAL_SPI_HOSTS_MASTER, 10 * 1000 * 1000);
+    for (size_t i = 0; i < sizeof(s_chunks) / sizeof(s_chunks[0]); i++) {
+        sim_chunked("spi 10MHz 8bit", 0, sim_spi_write, s_chunks[i]);
+    }
+
+    xf_hal_spi_set_data_width(0, XF_HAL_SPI_DATA_WIDTH_32_BITS);
+    for (size_t i = 0; i < sizeof(s_chunks) / sizeof(s_chunks[0]); i++) {
+        sim_chunked("spi 10MHz 32bit", 0, sim_spi_write, s_chunks[i]);
+    }
+
+    xf_hal_i2c_init(0, XF_HAL_I2C_HOSTS_MASTER, 400000);
+    xf_hal_i2c_set_mem_addr_width(0, XF_HAL_I2C_MEM_ADDR_WIDTH_16BIT);
+    for (size_t i = 0; i < sizeof(s_chunks) / sizeof(s_chunks[0]); i++) {
+        sim_chunked("i2c 400k mem16", 0, sim_i2c_write_mem, s_chunks[i]);
+    }
+
+    xf_hal_adc_init(0);
+    xf_hal_adc_set_sample_rate(0, 100000);
+    uint64_t start = port_sim_now();
+    for (uint32_t i = 0; i < 1000; i++) {
+        xf_hal_adc_read_raw(0);
+    }
+    sim_report("adc 100ksps", 1, 1000, start);
+
+    sim_async_overlap();
+
+    sim_models();
+
+    printf("\n");
+    port_sim_dump();
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void sim_report(const char *name, uint32_t chunk, uint64_t bytes, uint64_t start)
+{
+    uint64_t ns = port_sim_now() - start;
+    double rate = (ns == 0) ? 0.0 : (double)bytes * 1e9 / (double)ns;
+    printf("%-24s %8u %12llu %12.0f\n", name, (unsigned)chunk, (unsigned long long)(ns / 1000), rate);
+}
+
+static void sim_chunked(const char *name, uint32_t num, sim_xfer_t xfer, uint32_t chunk)
+{
+    uint64_t start = port_sim_now();
+
+    for (uint32_t off = 0; off < TOTAL_SIZE; off += chunk) {
+        xfer(num, s_buf + off, chunk);
+    }
+
+    sim_report(name, chunk, TOTAL_SIZE, start);
+}
+
+static int sim_uart_write(uint32_t num, const uint8_t *buf, uint32_t size)
+{
+    return xf_hal_uart_write(num, buf, size);
+}
+
+static int sim_spi_write(uint32_t num, const uint8_t *buf, uint32_t size)
+{
+    return xf_hal_spi_write(num, buf, size, 1000);
+}
+
+static int sim_i2c_write_mem(uint32_t num, const uint8_t *buf, uint32_t size)
+{
+    return xf_hal_i2c_write_mem(num, (uint32_t)(buf - s_buf), buf, size, 1000);
+}
+
+static void sim_async_overlap(void)
+{
+    xf_hal_req_t req[2];
+
+    // 两个 uart 同时发送，虚拟时间上互相重叠，总耗时约等于单个传输
+    xf_hal_uart_init(1, 115200);
+    xf_hal_uart_set_baudrate(0, 115200);
+    xf_hal_uart_set_config(0, XF_HAL_UART_DATA_BIT_8, XF_HAL_UART_STOP_BIT_1, XF_HAL_UART_PARITY_BITS_NONE);
+
+    uint64_t start = port_sim_now();
+    for (uint32_t i = 0; i < 2; i++) {
+        xf_hal_req_init(&req[i], XF_HAL_REQ_DIR_WRITE, s_buf, TOTAL_SIZE, NULL, NULL);
+        xf_hal_uart_submit(i, &req[i]);
+    }
+    while (port_sim_run_next()) {
+    }
+    sim_report("uart0+1 async 115200", TOTAL_SIZE, 2 * TOTAL_SIZE, start);
+}
+
+static void sim_models(void)
+{
+    for (uint32_t i = 0; i < TOTAL_SIZE; i++) {
+        s_buf[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    printf("\n%-24s %8s %12s %12s\n", "model", "bytes", "time(us)", "result");
+    sim_eeprom();
+    sim_nor();
+    sim_uart_loopback();
+}
+
+static void sim_eeprom(void)
+{
+    port_sim_eeprom_config_t config = PORT_SIM_EEPROM_CONFIG_24C256();
+    port_sim_eeprom_t *eeprom = port_sim_eeprom_create(&config);
+    uint8_t back[256];
+
+    port_sim_i2c_attach(MODEL_EEPROM_I2C, MODEL_EEPROM_ADDR, port_sim_eeprom_model(eeprom));
+    xf_hal_i2c_init(MODEL_EEPROM_I2C, XF_HAL_I2C_HOSTS_MASTER, 400000);
+    xf_hal_i2c_set_address(MODEL_EEPROM_I2C, MODEL_EEPROM_ADDR);
+    xf_hal_i2c_set_mem_addr_width(MODEL_EEPROM_I2C, XF_HAL_I2C_MEM_ADDR_WIDTH_16BIT);
+
+    // 逐页写入，写周期内器件不应答，这里直接等待 tWR，避免应答轮询刷屏错误日志
+    uint64_t start = port_sim_now();
+    for (uint32_t off = 0; off < sizeof(back); off += config.page_size) {
+        xf_hal_i2c_write_mem(MODEL_EEPROM_I2C, off, s_buf + off, config.page_size, 1000);
+        port_sim_advance(config.write_ns);
+    }
+    xf_hal_i2c_read_mem(MODEL_EEPROM_I2C, 0, back, sizeof(back), 1000);
+    sim_check("eeprom 24c256 400k", s_buf, back, sizeof(back), start);
+
+    // 两个不同内存地址的读请求同时排队，各自按请求中的地址读取
+    xf_hal_req_t req[2];
+    uint32_t half = sizeof(back) / 2;
+    start = port_sim_now();
+    memset(back, 0, sizeof(back));
+    for (uint32_t i = 0; i < 2; i++) {
+        xf_hal_req_init(&req[i], XF_HAL_REQ_DIR_READ, back + (1 - i) * half, half, NULL, NULL);
+        xf_hal_i2c_submit_mem(MODEL_EEPROM_I2C, (1 - i) * half, &req[i], 1000);
+    }
+    while (port_sim_run_next()) {
+    }
+    bool done = (req[0].result == (int)half) && (req[1].result == (int)half);
+    sim_check("eeprom queued mem read", s_buf, back, done ? sizeof(back) : 0, start);
+
+    port_sim_i2c_attach(MODEL_EEPROM_I2C, MODEL_EEPROM_ADDR, NULL);
+    port_sim_eeprom_destroy(eeprom);
+}
+
+static void sim_nor(void)
+{
+    port_sim_nor_config_t config = PORT_SIM_NOR_CONFIG_W25Q64();
+    port_sim_nor_t *nor = port_sim_nor_create(&config);
+    uint8_t back[256];
+    uint8_t id[3];
+
+    xf_hal_gpio_init(MODEL_NOR_CS, XF_HAL_GPIO_DIR_OUT);
+    xf_hal_gpio_set_level(MODEL_NOR_CS, true);
+    port_sim_spi_attach(MODEL_NOR_SPI, MODEL_NOR_CS, port_sim_nor_model(nor));
+    xf_hal_spi_init(MODEL_NOR_SPI, XF_HAL_SPI_HOSTS_MASTER, 40 * 1000 * 1000);
+
+    uint64_t start = port_sim_now();
+    sim_nor_cmd(0x9F, UINT32_MAX, NULL, id, sizeof(id));
+    sim_check("nor rdid", config.jedec_id, id, sizeof(id), start);
+
+    start = port_sim_now();
+    sim_nor_cmd(0x06, UINT32_MAX, NULL, NULL, 0);
+    sim_nor_cmd(0x20, 0, NULL, NULL, 0);
+    sim_nor_wait();
+    sim_nor_cmd(0x06, UINT32_MAX, NULL, NULL, 0);
+    sim_nor_cmd(0x02, 0, s_buf, NULL, sizeof(back));
+    sim_nor_wait();
+    sim_nor_cmd(0x03, 0, NULL, back, sizeof(back));
+    sim_check("nor erase+pp 40MHz", s_buf, back, sizeof(back), start);
+
+    port_sim_spi_attach(MODEL_NOR_SPI, PORT_SIM_PIN_NONE, NULL);
+    port_sim_nor_destroy(nor);
+}
+
+static uint8_t sim_nor_cmd(uint8_t cmd, uint32_t addr, const uint8_t *tx, uint8_t *rx, uint32_t size)
+{
+    uint8_t head[4] = {cmd, (uint8_t)(addr >> 16), (uint8_t)(addr >> 8), (uint8_t)addr};
+    uint8_t status = 0;
+
+    xf_hal_gpio_set_level(MODEL_NOR_CS, false);
+    xf_hal_spi_write(MODEL_NOR_SPI, head, (addr == UINT32_MAX) ? 1 : sizeof(head), 1000);
+    if (tx != NULL) {
+        xf_hal_spi_write(MODEL_NOR_SPI, tx, size, 1000);
+    }
+    if (rx != NULL) {
+        xf_hal_spi_read(MODEL_NOR_SPI, rx, size, 1000);
+        status = rx[0];
+    }
+    xf_hal_gpio_set_level(MODEL_NOR_CS, true);
+
+    return status;
+}
+
+static void sim_nor_wait(void)
+{
+    uint8_t status;
+
+    while (sim_nor_cmd(0x05, UINT32_MAX, NULL, &status, 1) & 0x01) {
+        port_sim_advance(1000 * 1000);
+    }
+}
+
+static void sim_uart_loopback(void)
+{
+    port_sim_uart_link_t *link = port_sim_uart_loopback_create();
+    uint8_t back[256];
+    xf_hal_req_t req;
+
+    port_sim_uart_attach(MODEL_LOOP_UART, port_sim_uart_link_model(link));
+    xf_hal_uart_init(MODEL_LOOP_UART, 921600);
+
+    // 先提交异步读，再发送，读请求在最后一个字节到达时完成
+    uint64_t start = port_sim_now();
+    memset(back, 0, sizeof(back));
+    xf_hal_req_init(&req, XF_HAL_REQ_DIR_READ, back, sizeof(back), NULL, NULL);
+    xf_hal_uart_submit(MODEL_LOOP_UART, &req);
+    xf_hal_uart_write(MODEL_LOOP_UART, s_buf, sizeof(back));
+    while (port_sim_run_next()) {
+    }
+    sim_check("uart loopback 921600", s_buf, back, (req.result == sizeof(back)) ? sizeof(back) : 0, start);
+
+    port_sim_uart_attach(MODEL_LOOP_UART, NULL);
+    port_sim_uart_link_destroy(link);
+}
+
+static void sim_check(const char *name, const uint8_t *a, const uint8_t *b, uint32_t size, uint64_t start)
+{
+    uint64_t ns = port_sim_now() - start;
+    bool ok = (size > 0) && (memcmp(a, b, size) == 0);
+
+    printf("%-24s %8u %12llu %12s\n", name, (unsigned)size, (unsigned long long)(ns / 1000), ok ? "ok" : "mismatch");
+}
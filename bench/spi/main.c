@@ -0,0 +1,131 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal spi 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_spi [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 spi 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define DATA_SIZE   16
+#define TIMEOUT_MS  100
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_writev(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_mode(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_speed(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_bit_order(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_data_width(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_read(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_spi_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_spi_write",          bench_write},
+    {"xf_hal_spi_read",           bench_read},
+    {"xf_hal_spi_writev",         bench_writev},
+    {"xf_hal_spi_set_mode",       bench_set_mode},
+    {"xf_hal_spi_set_speed",      bench_set_speed},
+    {"xf_hal_spi_set_bit_order",  bench_set_bit_order},
+    {"xf_hal_spi_set_data_width", bench_set_data_width},
+    {"xf_hal_spi_handle_write",   bench_handle_write},
+    {"xf_hal_spi_handle_read",    bench_handle_read},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_spi_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_spi_init(i, XF_HAL_SPI_HOSTS_MASTER, 1000000);
+        s_handles[i] = xf_hal_spi_get_handle(i);
+    }
+
+    bench_suite_run("spi", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_write(dev, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_read(dev, scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_writev(uint32_t dev, uint32_t thread, void *scratch)
+{
+    uint8_t *buf = scratch;
+    xf_hal_iovec_t iov[] = {
+        {buf, 1}, {buf + 1, 3}, {buf + 4, DATA_SIZE - 4},
+    };
+    return xf_hal_spi_writev(dev, iov, 3, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_set_mode(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_set_mode(dev, XF_HAL_SPI_MODE_0) != XF_OK;
+}
+
+static int bench_set_speed(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_set_speed(dev, 1000000) != XF_OK;
+}
+
+static int bench_set_bit_order(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_set_bit_order(dev, XF_HAL_SPI_BIT_ORDER_MSB_FIRST) != XF_OK;
+}
+
+static int bench_set_data_width(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_set_data_width(dev, XF_HAL_SPI_DATA_WIDTH_8_BITS) != XF_OK;
+}
+
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_handle_write(s_handles[dev], scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
+
+static int bench_handle_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_spi_handle_read(s_handles[dev], scratch, DATA_SIZE, TIMEOUT_MS) != DATA_SIZE;
+}
@@ -0,0 +1,101 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal tim 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_tim [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 tim 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_set_raw_ticks(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_get_raw_ticks(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_start_stop(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_set_raw_ticks(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_get_raw_ticks(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_tim_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_tim_set_raw_ticks",        bench_set_raw_ticks},
+    {"xf_hal_tim_get_raw_ticks",        bench_get_raw_ticks},
+    {"xf_hal_tim_start(stop)",          bench_start_stop},
+    {"xf_hal_tim_handle_set_raw_ticks", bench_handle_set_raw_ticks},
+    {"xf_hal_tim_handle_get_raw_ticks", bench_handle_get_raw_ticks},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_tim_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_tim_init(i, 1000000, XF_HAL_TIM_COUNT_DIR_UP, true);
+        s_handles[i] = xf_hal_tim_get_handle(i);
+    }
+
+    bench_suite_run("tim", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_set_raw_ticks(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_tim_set_raw_ticks(dev, 100) < XF_OK;
+}
+
+static int bench_get_raw_ticks(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_tim_get_raw_ticks(dev);
+    return 0;
+}
+
+static int bench_start_stop(uint32_t dev, uint32_t thread, void *scratch)
+{
+    if (xf_hal_tim_start(dev, 1000) != XF_OK) {
+        return 1;
+    }
+    return xf_hal_tim_stop(dev) != XF_OK;
+}
+
+static int bench_handle_set_raw_ticks(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_tim_handle_set_raw_ticks(s_handles[dev], 100) < XF_OK;
+}
+
+static int bench_handle_get_raw_ticks(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_tim_handle_get_raw_ticks(s_handles[dev]);
+    return 0;
+}
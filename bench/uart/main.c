@@ -0,0 +1,139 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal uart 接口性能测试。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用法：bench_uart [设备数] [最大线程数] [每线程调用次数] [--json]
+ * 使用空驱动测量 uart 各接口自身的开销。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "bench.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define DATA_SIZE   16
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_writev(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_submit(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_baudrate(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_get_baudrate(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_set_config(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch);
+static int bench_handle_read(uint32_t dev, uint32_t thread, void *scratch);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_uart_handle_t *s_handles = NULL;
+
+static const bench_case_t s_cases[] = {
+    {"xf_hal_uart_write",        bench_write},
+    {"xf_hal_uart_read",         bench_read},
+    {"xf_hal_uart_writev",       bench_writev},
+    {"xf_hal_uart_submit",       bench_submit},
+    {"xf_hal_uart_set_baudrate", bench_set_baudrate},
+    {"xf_hal_uart_get_baudrate", bench_get_baudrate},
+    {"xf_hal_uart_set_config",   bench_set_config},
+    {"xf_hal_uart_handle_write", bench_handle_write},
+    {"xf_hal_uart_handle_read",  bench_handle_read},
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(int argc, char *argv[])
+{
+    bench_opts_t opts;
+
+    bench_opts_parse(&opts, argc, argv, 32, 1000000);
+
+    port_xf_lock();
+    bench_port_init();
+
+    s_handles = calloc(opts.dev_num, sizeof(xf_hal_uart_handle_t));
+    for (uint32_t i = 0; i < opts.dev_num; i++) {
+        xf_hal_uart_init(i, 115200);
+        s_handles[i] = xf_hal_uart_get_handle(i);
+    }
+
+    bench_suite_run("uart", s_cases, sizeof(s_cases) / sizeof(s_cases[0]), &opts);
+
+    free(s_handles);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int bench_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_write(dev, scratch, DATA_SIZE) != DATA_SIZE;
+}
+
+static int bench_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_read(dev, scratch, DATA_SIZE) != DATA_SIZE;
+}
+
+static int bench_writev(uint32_t dev, uint32_t thread, void *scratch)
+{
+    uint8_t *buf = scratch;
+    xf_hal_iovec_t iov[] = {
+        {buf, 4}, {buf + 4, DATA_SIZE - 6}, {buf + DATA_SIZE - 2, 2},
+    };
+    return xf_hal_uart_writev(dev, iov, 3) != DATA_SIZE;
+}
+
+static int bench_submit(uint32_t dev, uint32_t thread, void *scratch)
+{
+    xf_hal_req_t *req = (xf_hal_req_t *)scratch;
+    xf_hal_req_init(req, XF_HAL_REQ_DIR_WRITE, req + 1, DATA_SIZE, NULL, NULL);
+    if (xf_hal_uart_submit(dev, req) != XF_OK) {
+        return 1;
+    }
+    // 其他线程同时提交到同一设备时，请求可能由该线程完成
+    while (req->state != XF_HAL_REQ_STATE_DONE) {
+    }
+    return req->result != DATA_SIZE;
+}
+
+static int bench_set_baudrate(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_set_baudrate(dev, 115200) != XF_OK;
+}
+
+static int bench_get_baudrate(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_get_baudrate(dev) == 0;
+}
+
+static int bench_set_config(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_set_config(dev, XF_HAL_UART_DATA_BIT_8, XF_HAL_UART_STOP_BIT_1,
+                                  XF_HAL_UART_PARITY_BITS_NONE) != XF_OK;
+}
+
+static int bench_handle_write(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_handle_write(s_handles[dev], scratch, DATA_SIZE) != DATA_SIZE;
+}
+
+static int bench_handle_read(uint32_t dev, uint32_t thread, void *scratch)
+{
+    return xf_hal_uart_handle_read(s_handles[dev], scratch, DATA_SIZE) != DATA_SIZE;
+}
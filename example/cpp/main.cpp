@@ -0,0 +1,34 @@
+#include "xf_hal.hpp"
+#include "port.h"
+#include "port_xf_lock.h"
+
+using namespace xf::hal;
+
+// 配置在编译期确定
+static constexpr GpioConfig s_led_config = GpioConfig(XF_HAL_GPIO_DIR_OUT).pull(XF_HAL_GPIO_PULL_NONE);
+static constexpr SpiConfig s_spi_config = SpiConfig(XF_HAL_SPI_HOSTS_MASTER, 1000000)
+                                          .mode(XF_HAL_SPI_MODE_0)
+                                          .gpio(10, 11, 12, 13);
+
+int main()
+{
+    uint8_t data[4] = {0x01, 0x02, 0x03, 0x04};
+    port_xf_lock();
+    port_init();
+
+    using Led = Gpio<1>;
+    using Flash = Spi<1>;
+    using Console = Uart<1>;
+
+    Led::init(s_led_config);
+    Led::set_level(true);
+    printf("led level:%d\n", Led::get_level());
+
+    Flash::init(s_spi_config);
+    Flash::write(data, sizeof(data), 100);
+
+    Console::init(UartConfig(115200).gpio(2, 3));
+    Console::write(data, sizeof(data));
+
+    return 0;
+}
@@ -0,0 +1,87 @@
+#include "xf_hal.hpp"
+#include "port.h"
+#include "port_xf_lock.h"
+#include <deque>
+
+using namespace xf::hal;
+
+using Flash = Spi<1>;
+using Eeprom = I2c<1>;
+using Console = Uart<1>;
+
+// 最简单的协程类型：创建后立即运行，结束时自动销毁
+struct Task {
+    struct promise_type {
+        Task get_return_object()
+        {
+            return {};
+        }
+        std::suspend_never initial_suspend() noexcept
+        {
+            return {};
+        }
+        std::suspend_never final_suspend() noexcept
+        {
+            return {};
+        }
+        void return_void()
+        {
+        }
+        void unhandled_exception()
+        {
+        }
+    };
+};
+
+// 单线程执行器：完成回调只把协程放入就绪队列，由主循环恢复
+static std::deque<std::coroutine_handle<>> s_ready;
+static int s_running = 0;
+
+static void resume_later(std::coroutine_handle<> handle)
+{
+    s_ready.push_back(handle);
+}
+
+static Task worker(int id)
+{
+    uint8_t page[16] = {0};
+    uint8_t cmd[4] = {0x03, 0x00, 0x00, (uint8_t)id};
+
+    s_running++;
+
+    int n = co_await Eeprom::read_mem_async(id * sizeof(page), page, sizeof(page), 100);
+    printf("worker %d: eeprom read %d\n", id, n);
+
+    n = co_await Flash::write_async(cmd, sizeof(cmd), 100);
+    printf("worker %d: flash write %d\n", id, n);
+
+    n = co_await Console::write_async(page, sizeof(page));
+    printf("worker %d: uart write %d\n", id, n);
+
+    s_running--;
+}
+
+int main()
+{
+    port_xf_lock();
+    port_init();
+
+    Flash::init(SpiConfig(XF_HAL_SPI_HOSTS_MASTER, 1000000));
+    Eeprom::init(I2cConfig(XF_HAL_I2C_HOSTS_MASTER, 400000).address(0x50));
+    Console::init(UartConfig(115200));
+
+    set_resume_hook(resume_later);
+
+    for (int i = 0; i < 4; i++) {
+        worker(i);
+    }
+
+    // 对接层不支持异步时请求在提交中完成，worker 在上面已经运行结束
+    while (s_running > 0 && !s_ready.empty()) {
+        std::coroutine_handle<> handle = s_ready.front();
+        s_ready.pop_front();
+        handle.resume();
+    }
+
+    return 0;
+}
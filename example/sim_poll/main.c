@@ -0,0 +1,93 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 在仿真对接层上使用 posix poll 等待 uart 数据。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details uart1 与 uart2 互连，uart1 异步发送，主线程 poll uart2，
+ * 等待期间由 port_sim_poll_wait 推进虚拟时钟，数据按帧时间到达后 poll 返回。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "port.h"
+#include "port_sim_model.h"
+#include <stdio.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define SIM_POLL_BAUDRATE   115200
+#define SIM_POLL_LINES      3
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+static const char s_line[] = "hello poll\n";
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(void)
+{
+    port_xf_lock();
+    port_init();
+
+    port_sim_uart_link_t *a = NULL;
+    port_sim_uart_link_t *b = NULL;
+    port_sim_uart_pair_create(&a, &b);
+    port_sim_uart_attach(1, port_sim_uart_link_model(a));
+    port_sim_uart_attach(2, port_sim_uart_link_model(b));
+
+    xf_hal_uart_init(1, SIM_POLL_BAUDRATE);
+    xf_hal_uart_init(2, SIM_POLL_BAUDRATE);
+    xf_hal_poll_set_waiter(port_sim_poll_wait, NULL);
+
+    int fd = open("UART2", O_RDWR | O_NONBLOCK);
+    if (fd < 0) {
+        printf("open UART2 failed: %d\n", fd);
+        return -1;
+    }
+
+    for (int i = 0; i < SIM_POLL_LINES; i++) {
+        xf_hal_req_t req;
+        xf_hal_req_init(&req, XF_HAL_REQ_DIR_WRITE, (void *)s_line, sizeof(s_line) - 1, NULL, NULL);
+        xf_hal_uart_submit(1, &req);
+
+        size_t got = 0;
+        char buf[sizeof(s_line)] = {0};
+        while (got < sizeof(s_line) - 1) {
+            struct pollfd pfd = {.fd = fd, .events = POLLIN};
+            if (poll(&pfd, 1, 100) <= 0) {
+                printf("poll timeout\n");
+                break;
+            }
+            int n = read(fd, buf + got, sizeof(s_line) - 1 - got);
+            if (n > 0) {
+                got += n;
+            }
+        }
+
+        printf("[%llu us] %s", (unsigned long long)(port_sim_now() / 1000), buf);
+    }
+
+    close(fd);
+    xf_hal_uart_deinit(1);
+    xf_hal_uart_deinit(2);
+    port_sim_uart_attach(1, NULL);
+    port_sim_uart_attach(2, NULL);
+    port_sim_uart_link_destroy(a);
+    port_sim_uart_link_destroy(b);
+
+    return 0;
+}
+
+/* ==================== [Static Functions] ================================== */
@@ -0,0 +1,115 @@
+/**
+ * @file main.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 在仿真对接层上使用发送缓冲区异步发送 uart 数据。
+ * @version 0.1
+ * @date 2024-07-26
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details uart1 与 uart2 互连，uart1 设置 64 字节的发送缓冲区，用 xf_hal_uart_write_async
+ * 写入远大于缓冲区的数据，缓冲区满时推进虚拟时钟等待回调腾出空间；uart2 用一个异步读请求
+ * 接收全部数据，最后检查回调次数与收到的数据。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "port_xf_lock.h"
+#include "port.h"
+#include "port_sim_model.h"
+#include <stdio.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define SIM_TX_BAUDRATE     921600
+#define SIM_TX_RING_SIZE    64
+#define SIM_TX_TOTAL        1000
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void sim_tx_cb(xf_uart_num_t uart_num, uint32_t free_size, void *user_data);
+
+/* ==================== [Static Variables] ================================== */
+
+static uint8_t s_ring[SIM_TX_RING_SIZE];
+static uint8_t s_tx[SIM_TX_TOTAL];
+static uint8_t s_rx[SIM_TX_TOTAL];
+static uint32_t s_cb_count = 0;
+static uint32_t s_cb_free = 0;
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+int main(void)
+{
+    port_xf_lock();
+    port_init();
+
+    port_sim_uart_link_t *a = NULL;
+    port_sim_uart_link_t *b = NULL;
+    port_sim_uart_pair_create(&a, &b);
+    port_sim_uart_attach(1, port_sim_uart_link_model(a));
+    port_sim_uart_attach(2, port_sim_uart_link_model(b));
+
+    xf_hal_uart_init(1, SIM_TX_BAUDRATE);
+    xf_hal_uart_init(2, SIM_TX_BAUDRATE);
+    xf_hal_uart_set_tx_buffer(1, s_ring, sizeof(s_ring), sim_tx_cb, NULL);
+
+    for (uint32_t i = 0; i < SIM_TX_TOTAL; i++) {
+        s_tx[i] = (uint8_t)(i * 7 + 3);
+    }
+
+    // 读请求在最后一个字节到达时完成
+    xf_hal_req_t rx_req;
+    xf_hal_req_init(&rx_req, XF_HAL_REQ_DIR_READ, s_rx, sizeof(s_rx), NULL, NULL);
+    xf_hal_uart_submit(2, &rx_req);
+
+    // 缓冲区满时只写入能容纳的部分，推进虚拟时钟直到回调腾出空间
+    uint32_t sent = 0;
+    while (sent < SIM_TX_TOTAL) {
+        int n = xf_hal_uart_write_async(1, s_tx + sent, SIM_TX_TOTAL - sent);
+        if (n < 0) {
+            printf("write async failed: %d\n", n);
+            return -1;
+        }
+        sent += n;
+        if (sent < SIM_TX_TOTAL && !port_sim_run_next()) {
+            printf("tx stalled at %u bytes\n", (unsigned)sent);
+            return -1;
+        }
+    }
+    while (port_sim_run_next()) {
+    }
+
+    // 每段最多发送缓冲区的一半，回调至少触发 总长 / 半个缓冲区 次，结束时缓冲区全空
+    uint32_t min_cb = (SIM_TX_TOTAL + SIM_TX_RING_SIZE / 2 - 1) / (SIM_TX_RING_SIZE / 2);
+    bool cb_ok = (s_cb_count >= min_cb) && (s_cb_free == SIM_TX_RING_SIZE);
+    bool rx_ok = (rx_req.result == SIM_TX_TOTAL) && (memcmp(s_tx, s_rx, SIM_TX_TOTAL) == 0);
+
+    printf("[%llu us] sent %u bytes through a %u byte ring, %u callbacks (>= %u), free %u: %s\n",
+           (unsigned long long)(port_sim_now() / 1000), (unsigned)sent, (unsigned)SIM_TX_RING_SIZE,
+           (unsigned)s_cb_count, (unsigned)min_cb, (unsigned)s_cb_free, cb_ok ? "ok" : "mismatch");
+    printf("received %d bytes: %s\n", rx_req.result, rx_ok ? "ok" : "mismatch");
+
+    xf_hal_uart_deinit(1);
+    xf_hal_uart_deinit(2);
+    port_sim_uart_attach(1, NULL);
+    port_sim_uart_attach(2, NULL);
+    port_sim_uart_link_destroy(a);
+    port_sim_uart_link_destroy(b);
+
+    return (cb_ok && rx_ok) ? 0 : -1;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void sim_tx_cb(xf_uart_num_t uart_num, uint32_t free_size, void *user_data)
+{
+    s_cb_count++;
+    s_cb_free = free_size;
+}
@@ -54,6 +54,9 @@ static void _adc_disable(uint32_t adc_port);
 static void _adc_read(uint32_t adc_port, uint32_t *buffer, uint32_t count);
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_adc_pool, sizeof(port_adc_t), XF_HAL_ADC_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -67,14 +70,17 @@ void xf_hal_ADC_reg(void)
         .read = port_adc_read,
         .close = port_adc_close,
     };
+    xf_hal_pool_init(&s_port_adc_pool);
     xf_hal_adc_register(&ops);
 }
 
 
+XF_HAL_PORT_EXPORT(ADC, port_adc_ioctl, port_adc_read, port_adc_write)
+
 /* ==================== [Static Functions] ================================== */
 static int port_adc_open(xf_hal_dev_t *dev)
 {
-    port_adc_t *adc = (port_adc_t *)malloc(sizeof(port_adc_t));
+    port_adc_t *adc = (port_adc_t *)xf_hal_pool_alloc(&s_port_adc_pool);
     if (adc == NULL) {
         return -1;
     }
@@ -138,7 +144,7 @@ static int port_adc_close(xf_hal_dev_t *dev)
 {
     port_adc_t *adc = (port_adc_t *)dev->platform_data;
     _adc_deinit(adc->port);
-    free(adc);
+    xf_hal_pool_free(&s_port_adc_pool, adc);
     return 0;
 }
 
@@ -58,6 +58,9 @@ static void _dac_write(uint32_t dac_port, uint32_t value);
 
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_dac_pool, sizeof(port_dac_t), XF_HAL_DAC_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -71,14 +74,17 @@ void xf_hal_DAC_reg(void)
         .read = port_dac_read,
         .close = port_dac_close,
     };
+    xf_hal_pool_init(&s_port_dac_pool);
     xf_hal_dac_register(&ops);
 }
 
+XF_HAL_PORT_EXPORT(DAC, port_dac_ioctl, port_dac_read, port_dac_write)
+
 /* ==================== [Static Functions] ================================== */
 
 static int port_dac_open(xf_hal_dev_t *dev)
 {
-    port_dac_t *dac = (port_dac_t *)malloc(sizeof(port_dac_t));
+    port_dac_t *dac = (port_dac_t *)xf_hal_pool_alloc(&s_port_dac_pool);
     if (dac == NULL) {
         return -1;
     }
@@ -143,7 +149,7 @@ static int port_dac_close(xf_hal_dev_t *dev)
 {
     port_dac_t *dac = (port_dac_t *)dev->platform_data;
     _dac_deinit(dac->port);
-    free(dac);
+    xf_hal_pool_free(&s_port_dac_pool, dac);
     return 0;
 }
 
@@ -63,6 +63,9 @@ static void xf_hal_gpio_intr_type_cb(xf_gpio_num_t gpio_num, bool level, void *u
 
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_gpio_pool, sizeof(port_gpio_t), XF_HAL_GPIO_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_GPIO_UNUSED(x)   (void)(x)
@@ -78,13 +81,16 @@ void xf_hal_GPIO_reg(void)
         .read = port_gpio_read,
         .close = port_gpio_close,
     };
+    xf_hal_pool_init(&s_port_gpio_pool);
     xf_hal_gpio_register(&ops);
 }
 
+XF_HAL_PORT_EXPORT(GPIO, port_gpio_ioctl, port_gpio_read, port_gpio_write)
+
 /* ==================== [Static Functions] ================================== */
 static int port_gpio_open(xf_hal_dev_t *dev)
 {
-    port_gpio_t *gpio = (port_gpio_t *)malloc(sizeof(port_gpio_t));
+    port_gpio_t *gpio = (port_gpio_t *)xf_hal_pool_alloc(&s_port_gpio_pool);
     if (gpio == NULL) {
         return -1;
     }
@@ -159,7 +165,7 @@ static int port_gpio_close(xf_hal_dev_t *dev)
 {
     port_gpio_t *gpio = (port_gpio_t *)dev->platform_data;
     _gpio_deinit(gpio->port);
-    free(gpio);
+    xf_hal_pool_free(&s_port_gpio_pool, gpio);
     return 0;
 }
 
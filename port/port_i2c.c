@@ -59,6 +59,7 @@ static int port_i2c_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
 static int port_i2c_read(xf_hal_dev_t *dev, void *buf, size_t count);
 static int port_i2c_write(xf_hal_dev_t *dev, const void *buf, size_t count);
 static int port_i2c_close(xf_hal_dev_t *dev);
+static int port_i2c_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
 
 // 用户实现id的转换方式
 static uint32_t _i2c_id_to_port(uint32_t id);
@@ -76,6 +77,20 @@ static void _i2c_master_read_from_dev(uint32_t i2c_num,
                                       uint8_t *read_buffer,
                                       size_t read_size,
                                       uint32_t timeout_ms);
+static void _i2c_master_write_mem_to_dev(uint32_t i2c_num,
+                                         uint8_t device_address,
+                                         uint32_t mem_addr,
+                                         size_t mem_addr_size,
+                                         const uint8_t *write_buffer,
+                                         size_t write_size,
+                                         uint32_t timeout_ms);
+static void _i2c_master_read_mem_from_dev(uint32_t i2c_num,
+                                          uint8_t device_address,
+                                          uint32_t mem_addr,
+                                          size_t mem_addr_size,
+                                          uint8_t *read_buffer,
+                                          size_t read_size,
+                                          uint32_t timeout_ms);
 
 int _i2c_slave_write_buffer(uint32_t i2c_num, const uint8_t *data, int size,
                             uint32_t timeout_ms);
@@ -84,6 +99,9 @@ int _i2c_slave_read_buffer(uint32_t i2c_num, uint8_t *data, size_t max_size,
                            uint32_t timeout_ms);
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_i2c_pool, sizeof(port_i2c_t), XF_HAL_I2C_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -96,15 +114,19 @@ void xf_hal_I2C_reg(void)
         .write = port_i2c_write,
         .read = port_i2c_read,
         .close = port_i2c_close,
+        .writev = port_i2c_writev,
     };
+    xf_hal_pool_init(&s_port_i2c_pool);
     xf_hal_i2c_register(&ops);
 }
 
+XF_HAL_PORT_EXPORT(I2C, port_i2c_ioctl, port_i2c_read, port_i2c_write)
+
 /* ==================== [Static Functions] ================================== */
 
 static int port_i2c_open(xf_hal_dev_t *dev)
 {
-    port_i2c_t *i2c = (port_i2c_t *)malloc(sizeof(port_i2c_t));
+    port_i2c_t *i2c = (port_i2c_t *)xf_hal_pool_alloc(&s_port_i2c_pool);
     if (i2c == NULL) {
         return -1;
     }
@@ -166,12 +188,15 @@ static int port_i2c_read(xf_hal_dev_t *dev, void *buf, size_t count)
     port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
     xf_hal_i2c_config_t *i2c_config = (xf_hal_i2c_config_t *)i2c->config;
 
-    if (i2c_config->mem_addr_en != XF_HAL_I2C_MEM_ADDR_DISABLE) {
+    // 从机模式没有内存地址
+    if (i2c_config->mem_addr_en != XF_HAL_I2C_MEM_ADDR_DISABLE && i2c_config->hosts != XF_HAL_I2C_HOSTS_MASTER) {
         return -1;
     }
 
-
-    if (i2c_config->hosts == XF_HAL_I2C_HOSTS_MASTER) {
+    if (i2c_config->mem_addr_en != XF_HAL_I2C_MEM_ADDR_DISABLE) {
+        _i2c_master_read_mem_from_dev(i2c->port, i2c_config->address, i2c_config->mem_addr,
+                                      i2c_config->mem_addr_width + 1, buf, count, i2c_config->timeout_ms);
+    } else if (i2c_config->hosts == XF_HAL_I2C_HOSTS_MASTER) {
         _i2c_master_read_from_dev(i2c->port, i2c_config->address, buf, count,
                                   i2c_config->timeout_ms);
     } else {
@@ -188,12 +213,15 @@ static int port_i2c_write(xf_hal_dev_t *dev, const void *buf, size_t count)
     xf_hal_i2c_config_t *i2c_config = (xf_hal_i2c_config_t *)i2c->config;
 
 
-    if (i2c_config->mem_addr_en !=  XF_HAL_I2C_MEM_ADDR_DISABLE) {
+    // 从机模式没有内存地址
+    if (i2c_config->mem_addr_en != XF_HAL_I2C_MEM_ADDR_DISABLE && i2c_config->hosts != XF_HAL_I2C_HOSTS_MASTER) {
         return -1;
     }
 
-
-    if (i2c_config->hosts == XF_HAL_I2C_HOSTS_MASTER) {
+    if (i2c_config->mem_addr_en != XF_HAL_I2C_MEM_ADDR_DISABLE) {
+        _i2c_master_write_mem_to_dev(i2c->port, i2c_config->address, i2c_config->mem_addr,
+                                     i2c_config->mem_addr_width + 1, buf, count, i2c_config->timeout_ms);
+    } else if (i2c_config->hosts == XF_HAL_I2C_HOSTS_MASTER) {
         _i2c_master_write_to_dev(i2c->port, i2c_config->address, buf, count,
                                  i2c_config->timeout_ms);
     } else {
@@ -203,11 +231,35 @@ static int port_i2c_write(xf_hal_dev_t *dev, const void *buf, size_t count)
     return 0;
 }
 
+static int port_i2c_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    xf_hal_i2c_config_t *i2c_config = (xf_hal_i2c_config_t *)i2c->config;
+    int total = 0;
+
+    if (i2c_config->mem_addr_en !=  XF_HAL_I2C_MEM_ADDR_DISABLE) {
+        return -1;
+    }
+
+    // 实际对接时应将各段数据放在同一个起始/停止条件之间（如 esp-idf 的 i2c_cmd_link）
+    for (size_t i = 0; i < iovcnt; i++) {
+        if (i2c_config->hosts == XF_HAL_I2C_HOSTS_MASTER) {
+            _i2c_master_write_to_dev(i2c->port, i2c_config->address, iov[i].buf, iov[i].count,
+                                     i2c_config->timeout_ms);
+        } else {
+            _i2c_slave_write_buffer(i2c->port, iov[i].buf, iov[i].count, i2c_config->timeout_ms);
+        }
+        total += iov[i].count;
+    }
+
+    return total;
+}
+
 static int port_i2c_close(xf_hal_dev_t *dev)
 {
     port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
     _i2c_deinit(i2c->port);
-    free(i2c);
+    xf_hal_pool_free(&s_port_i2c_pool, i2c);
     return 0;
 }
 
@@ -250,6 +302,36 @@ static void _i2c_master_read_from_dev(uint32_t i2c_num,
     strncpy((char *)read_buffer, buffer, read_size);
 }
 
+// 内存地址高字节在前，与数据在同一个起始/停止条件之间发送
+static void _i2c_master_write_mem_to_dev(uint32_t i2c_num,
+                                         uint8_t device_address,
+                                         uint32_t mem_addr,
+                                         size_t mem_addr_size,
+                                         const uint8_t *write_buffer,
+                                         size_t write_size,
+                                         uint32_t timeout_ms)
+{
+    printf("master write mem 0x%0*x:", (int)mem_addr_size * 2, (unsigned int)mem_addr);
+    for (int i = 0; i < write_size; i++) {
+        printf("%c", write_buffer[i]);
+    }
+    printf("\n");
+}
+
+// 写入内存地址后重复起始再读取（如 esp-idf 的 i2c_master_write_read_device）
+static void _i2c_master_read_mem_from_dev(uint32_t i2c_num,
+                                          uint8_t device_address,
+                                          uint32_t mem_addr,
+                                          size_t mem_addr_size,
+                                          uint8_t *read_buffer,
+                                          size_t read_size,
+                                          uint32_t timeout_ms)
+{
+    printf("master read mem 0x%0*x\n", (int)mem_addr_size * 2, (unsigned int)mem_addr);
+    const char *buffer = "hello!";
+    strncpy((char *)read_buffer, buffer, read_size);
+}
+
 int _i2c_slave_write_buffer(uint32_t i2c_num, const uint8_t *data, int size,
                             uint32_t timeout_ms)
 {
@@ -53,6 +53,9 @@ static void _pwm_disable(uint32_t pwm_port);
 
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_pwm_pool, sizeof(port_pwm_t), XF_HAL_PWM_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -66,14 +69,17 @@ void xf_hal_PWM_reg(void)
         .read = port_pwm_read,
         .close = port_pwm_close,
     };
+    xf_hal_pool_init(&s_port_pwm_pool);
     xf_hal_pwm_register(&ops);
 }
 
+XF_HAL_PORT_EXPORT(PWM, port_pwm_ioctl, port_pwm_read, port_pwm_write)
+
 /* ==================== [Static Functions] ================================== */
 
 static int port_pwm_open(xf_hal_dev_t *dev)
 {
-    port_pwm_t *pwm = (port_pwm_t *)malloc(sizeof(port_pwm_t));
+    port_pwm_t *pwm = (port_pwm_t *)xf_hal_pool_alloc(&s_port_pwm_pool);
     if (pwm == NULL) {
         return -1;
     }
@@ -139,7 +145,7 @@ static int port_pwm_close(xf_hal_dev_t *dev)
 {
     port_pwm_t *pwm = (port_pwm_t *)dev->platform_data;
     _pwm_deinit(pwm->port);
-    free(pwm);
+    xf_hal_pool_free(&s_port_pwm_pool, pwm);
     return 0;
 }
 
@@ -73,6 +73,7 @@ static int port_spi_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
 static int port_spi_read(xf_hal_dev_t *dev, void *buf, size_t count);
 static int port_spi_write(xf_hal_dev_t *dev, const void *buf, size_t count);
 static int port_spi_close(xf_hal_dev_t *dev);
+static int port_spi_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
 
 // 用户实现id的转换方式
 static uint32_t _spi_id_to_port(uint32_t id);
@@ -87,6 +88,9 @@ static int spi_device_polling_transmit(uint32_t spi_port, const void *tx_buffer,
 
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_spi_pool, sizeof(port_spi_t), XF_HAL_SPI_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -99,16 +103,20 @@ void xf_hal_SPI_reg(void)
         .write = port_spi_write,
         .read = port_spi_read,
         .close = port_spi_close,
+        .writev = port_spi_writev,
     };
+    xf_hal_pool_init(&s_port_spi_pool);
     xf_hal_spi_register(&ops);
 }
 
 
+XF_HAL_PORT_EXPORT(SPI, port_spi_ioctl, port_spi_read, port_spi_write)
+
 /* ==================== [Static Functions] ================================== */
 
 static int port_spi_open(xf_hal_dev_t *dev)
 {
-    port_spi_t *spi = (port_spi_t *)malloc(sizeof(port_spi_t));
+    port_spi_t *spi = (port_spi_t *)xf_hal_pool_alloc(&s_port_spi_pool);
     if (spi == NULL) {
         return -1;
     }
@@ -180,10 +188,24 @@ static int port_spi_write(xf_hal_dev_t *dev, const void *buf, size_t count)
     return 0;
 }
 
+static int port_spi_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+    int total = 0;
+
+    // 实际对接时应在整个过程中保持片选有效（如 esp-idf 的 SPI_TRANS_CS_KEEP_ACTIVE）
+    for (size_t i = 0; i < iovcnt; i++) {
+        spi_device_polling_transmit(spi->port, iov[i].buf, NULL, iov[i].count);
+        total += iov[i].count;
+    }
+
+    return total;
+}
+
 static int port_spi_close(xf_hal_dev_t *dev)
 {
     port_spi_t *spi = (port_spi_t *)dev->platform_data;
-    free(spi);
+    xf_hal_pool_free(&s_port_spi_pool, spi);
     return 0;
 }
 
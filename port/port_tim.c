@@ -62,6 +62,9 @@ static void xf_hal_tim_event_cb(xf_tim_num_t tim_num, uint32_t ticks, void *user
 
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_tim_pool, sizeof(port_tim_t), XF_HAL_TIM_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 #define XF_HAL_TIM_UNUSED(x)   (void)(x)
 
@@ -77,14 +80,17 @@ void xf_hal_TIM_reg(void)
         .read = port_tim_read,
         .close = port_tim_close,
     };
+    xf_hal_pool_init(&s_port_tim_pool);
     xf_hal_tim_register(&ops);
 }
 
+XF_HAL_PORT_EXPORT(TIM, port_tim_ioctl, port_tim_read, port_tim_write)
+
 /* ==================== [Static Functions] ================================== */
 
 static int port_tim_open(xf_hal_dev_t *dev)
 {
-    port_tim_t *tim = (port_tim_t *)malloc(sizeof(port_tim_t));
+    port_tim_t *tim = (port_tim_t *)xf_hal_pool_alloc(&s_port_tim_pool);
     if (tim == NULL) {
         return -1;
     }
@@ -155,7 +161,7 @@ static int port_tim_close(xf_hal_dev_t *dev)
 {
     port_tim_t *tim = (port_tim_t *)dev->platform_data;
     _tim_deinit(tim->port);
-    free(tim);
+    xf_hal_pool_free(&s_port_tim_pool, tim);
     return 0;
 }
 
@@ -43,6 +43,7 @@ static int port_uart_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
 static int port_uart_read(xf_hal_dev_t *dev, void *buf, size_t count);
 static int port_uart_write(xf_hal_dev_t *dev, const void *buf, size_t count);
 static int port_uart_close(xf_hal_dev_t *dev);
+static int port_uart_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
 
 // 用户实现id的转换方式
 static uint32_t _uart_id_to_port(uint32_t id);
@@ -63,6 +64,9 @@ static void _uart_write(uint32_t uart_port, const uint8_t *buffer, uint32_t coun
 
 /* ==================== [Static Variables] ================================== */
 
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_uart_pool, sizeof(port_uart_t), XF_HAL_UART_POOL_SIZE);
+
 /* ==================== [Macros] ============================================ */
 
 /* ==================== [Global Functions] ================================== */
@@ -75,15 +79,19 @@ void xf_hal_UART_reg(void)
         .write = port_uart_write,
         .read = port_uart_read,
         .close = port_uart_close,
+        .writev = port_uart_writev,
     };
+    xf_hal_pool_init(&s_port_uart_pool);
     xf_hal_uart_register(&ops);
 }
 
+XF_HAL_PORT_EXPORT(UART, port_uart_ioctl, port_uart_read, port_uart_write)
+
 /* ==================== [Static Functions] ================================== */
 
 static int port_uart_open(xf_hal_dev_t *dev)
 {
-    port_uart_t *uart = (port_uart_t *)malloc(sizeof(port_uart_t));
+    port_uart_t *uart = (port_uart_t *)xf_hal_pool_alloc(&s_port_uart_pool);
     if (uart == NULL) {
         return -1;
     }
@@ -146,11 +154,25 @@ static int port_uart_write(xf_hal_dev_t *dev, const void *buf, size_t count)
     return 0;
 }
 
+static int port_uart_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    int total = 0;
+
+    // 实际对接时可将各段数据依次放入发送 FIFO 或组成 DMA 链表，一次启动发送
+    for (size_t i = 0; i < iovcnt; i++) {
+        _uart_write(uart->port, iov[i].buf, iov[i].count);
+        total += iov[i].count;
+    }
+
+    return total;
+}
+
 static int port_uart_close(xf_hal_dev_t *dev)
 {
     port_uart_t *uart = (port_uart_t *)dev->platform_data;
     _uart_deinit(uart->port);
-    free(uart);
+    xf_hal_pool_free(&s_port_uart_pool, uart);
     return 0;
 }
 
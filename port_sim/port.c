@@ -0,0 +1,58 @@
+/**
+ * @file port.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 仿真对接层入口。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+#include "port.h"
+#include "port_sim.h"
+#include "xf_hal_port.h"
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+extern void xf_hal_ADC_reg();
+extern void xf_hal_DAC_reg();
+extern void xf_hal_GPIO_reg();
+extern void xf_hal_I2C_reg();
+extern void xf_hal_PWM_reg();
+extern void xf_hal_SPI_reg();
+extern void xf_hal_TIM_reg();
+extern void xf_hal_UART_reg();
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void port_init(void)
+{
+    xf_hal_ADC_reg();
+    xf_hal_DAC_reg();
+    xf_hal_GPIO_reg();
+    xf_hal_I2C_reg();
+    xf_hal_PWM_reg();
+    xf_hal_SPI_reg();
+    xf_hal_TIM_reg();
+    xf_hal_UART_reg();
+
+    // 统计与追踪使用虚拟时钟，耗时即为线上时间
+#if XF_HAL_STATS_IS_ENABLE
+    xf_hal_stats_set_clock(port_sim_now_us);
+#endif
+#if XF_HAL_TRACE_IS_ENABLE
+    xf_hal_trace_set_clock(port_sim_now_us, 1000000);
+#endif
+}
+
+/* ==================== [Static Functions] ================================== */
@@ -0,0 +1,35 @@
+/**
+ * @file port.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 
+ * @version 0.1
+ * @date 2024-07-03
+ * 
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ * 
+ */
+
+#ifndef __PORT_H__
+#define __PORT_H__
+
+/* ==================== [Includes] ========================================== */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+void port_init(void);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __PORT_H__
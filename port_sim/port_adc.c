@@ -0,0 +1,137 @@
+/**
+ * @file port_adc.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief adc 仿真对接，按采样率计算转换时间。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 按单次转换建模：每个采样占 1 / sample_rate 的时间，连续读取时依次排队。
+ * 采样值为按分辨率回绕的锯齿波。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_ADC_DEFAULT_ENABLE       false
+#define XF_HAL_ADC_DEFAULT_RESOLUTION   12
+#define XF_HAL_ADC_DEFAULT_SAMPLE_RATE  100000
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_adc_t {
+    port_sim_bus_t bus;
+    uint32_t resolution;
+    uint32_t sample_rate;
+    uint32_t sample;
+} port_adc_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_adc_open(xf_hal_dev_t *dev);
+static int port_adc_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_adc_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_adc_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_adc_close(xf_hal_dev_t *dev);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_adc_pool, sizeof(port_adc_t), XF_HAL_ADC_POOL_SIZE);
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_ADC_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_adc_open,
+        .ioctl = port_adc_ioctl,
+        .write = port_adc_write,
+        .read = port_adc_read,
+        .close = port_adc_close,
+    };
+    xf_hal_pool_init(&s_port_adc_pool);
+    xf_hal_adc_register(&ops);
+}
+
+XF_HAL_PORT_EXPORT(ADC, port_adc_ioctl, port_adc_read, port_adc_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_adc_open(xf_hal_dev_t *dev)
+{
+    port_adc_t *adc = (port_adc_t *)xf_hal_pool_alloc(&s_port_adc_pool);
+    if (adc == NULL) {
+        return -1;
+    }
+
+    memset(adc, 0, sizeof(port_adc_t));
+    port_sim_bus_open(&adc->bus, XF_HAL_ADC, "adc", dev->id);
+
+    dev->platform_data = adc;
+
+    return 0;
+}
+
+static int port_adc_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_adc_config_t *adc_config = (xf_hal_adc_config_t *)config;
+    port_adc_t *adc = (port_adc_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_ADC_CMD_DEFAULT) {
+        adc_config->enable = XF_HAL_ADC_DEFAULT_ENABLE;
+        adc_config->resolution = XF_HAL_ADC_DEFAULT_RESOLUTION;
+        adc_config->sample_rate = XF_HAL_ADC_DEFAULT_SAMPLE_RATE;
+        cmd = XF_HAL_ADC_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_ADC_CMD_RESOLUTION) {
+        adc->resolution = adc_config->resolution;
+    }
+
+    if (cmd & XF_HAL_ADC_CMD_SAMPLE_RATE) {
+        adc->sample_rate = adc_config->sample_rate;
+    }
+
+    return 0;
+}
+
+static int port_adc_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_adc_t *adc = (port_adc_t *)dev->platform_data;
+    uint32_t *value = (uint32_t *)buf;
+    uint32_t mask = (adc->resolution >= 32) ? 0xFFFFFFFF : ((1u << adc->resolution) - 1);
+
+    // count 为采样个数
+    port_sim_bus_xfer(&adc->bus, port_sim_bits_to_ns(count, adc->sample_rate), count * sizeof(uint32_t));
+    for (size_t i = 0; i < count; i++) {
+        value[i] = adc->sample++ & mask;
+    }
+
+    return count;
+}
+
+static int port_adc_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    // no need
+    return 0;
+}
+
+static int port_adc_close(xf_hal_dev_t *dev)
+{
+    port_adc_t *adc = (port_adc_t *)dev->platform_data;
+    port_sim_bus_close(&adc->bus);
+    xf_hal_pool_free(&s_port_adc_pool, adc);
+    return 0;
+}
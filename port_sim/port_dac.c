@@ -0,0 +1,126 @@
+/**
+ * @file port_dac.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief dac 仿真对接，按输出速率计算每次更新的时间。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_DAC_DEFAULT_ENABLE       false
+#define XF_HAL_DAC_DEFAULT_RESOLUTION   12
+#define XF_HAL_DAC_DEFAULT_SPEED        1000000
+#define XF_HAL_DAC_DEFAULT_VERF_MV      3300
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_dac_t {
+    port_sim_bus_t bus;
+    uint32_t speed;
+    uint32_t value;
+} port_dac_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_dac_open(xf_hal_dev_t *dev);
+static int port_dac_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_dac_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_dac_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_dac_close(xf_hal_dev_t *dev);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_dac_pool, sizeof(port_dac_t), XF_HAL_DAC_POOL_SIZE);
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_DAC_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_dac_open,
+        .ioctl = port_dac_ioctl,
+        .write = port_dac_write,
+        .read = port_dac_read,
+        .close = port_dac_close,
+    };
+    xf_hal_pool_init(&s_port_dac_pool);
+    xf_hal_dac_register(&ops);
+}
+
+XF_HAL_PORT_EXPORT(DAC, port_dac_ioctl, port_dac_read, port_dac_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_dac_open(xf_hal_dev_t *dev)
+{
+    port_dac_t *dac = (port_dac_t *)xf_hal_pool_alloc(&s_port_dac_pool);
+    if (dac == NULL) {
+        return -1;
+    }
+
+    memset(dac, 0, sizeof(port_dac_t));
+    port_sim_bus_open(&dac->bus, XF_HAL_DAC, "dac", dev->id);
+
+    dev->platform_data = dac;
+
+    return 0;
+}
+
+static int port_dac_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_dac_config_t *dac_config = (xf_hal_dac_config_t *)config;
+    port_dac_t *dac = (port_dac_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_DAC_CMD_DEFAULT) {
+        dac_config->enable = XF_HAL_DAC_DEFAULT_ENABLE;
+        dac_config->resolution = XF_HAL_DAC_DEFAULT_RESOLUTION;
+        dac_config->speed = XF_HAL_DAC_DEFAULT_SPEED;
+        dac_config->value_max = (1u << XF_HAL_DAC_DEFAULT_RESOLUTION) - 1;
+        dac_config->verf_mv = XF_HAL_DAC_DEFAULT_VERF_MV;
+        cmd = XF_HAL_DAC_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_DAC_CMD_SPEED) {
+        dac->speed = dac_config->speed;
+    }
+
+    return 0;
+}
+
+static int port_dac_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    // no need
+    return 0;
+}
+
+static int port_dac_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_dac_t *dac = (port_dac_t *)dev->platform_data;
+    port_sim_bus_xfer(&dac->bus, port_sim_bits_to_ns(1, dac->speed), sizeof(uint32_t));
+    dac->value = *(const uint32_t *)buf;
+    return 0;
+}
+
+static int port_dac_close(xf_hal_dev_t *dev)
+{
+    port_dac_t *dac = (port_dac_t *)dev->platform_data;
+    port_sim_bus_close(&dac->bus);
+    xf_hal_pool_free(&s_port_dac_pool, dac);
+    return 0;
+}
@@ -0,0 +1,173 @@
+/**
+ * @file port_gpio.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief gpio 仿真对接，电平锁存，输出电平变化时按中断类型触发回调。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 读写不占用虚拟时间。写入的电平同时作为输入电平，可用于测试中断路径；
+ * 电平变化还会通知 port_sim_pin_watch 的监听者（如 spi 仿真外设的软件片选）。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_GPIO_DEFAULT_DIRECTION   XF_HAL_GPIO_DIR_IN
+#define XF_HAL_GPIO_DEFAULT_SPEED       1000000
+#define XF_HAL_GPIO_DEFAULT_PULL        XF_HAL_GPIO_PULL_NONE
+#define XF_HAL_GPIO_DEFAULT_INTR_ENABLE 0
+#define XF_HAL_GPIO_DEFAULT_INTR_TYPE   XF_HAL_GPIO_INTR_TYPE_DISABLE
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_gpio_t {
+    bool level;
+    bool intr_enable;
+    uint8_t intr_type;
+    xf_hal_gpio_callback_t cb;
+    xf_hal_gpio_callback_t isr;
+} port_gpio_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_gpio_open(xf_hal_dev_t *dev);
+static int port_gpio_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_gpio_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_gpio_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_gpio_close(xf_hal_dev_t *dev);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_gpio_pool, sizeof(port_gpio_t), XF_HAL_GPIO_POOL_SIZE);
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_GPIO_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_gpio_open,
+        .ioctl = port_gpio_ioctl,
+        .write = port_gpio_write,
+        .read = port_gpio_read,
+        .close = port_gpio_close,
+    };
+    xf_hal_pool_init(&s_port_gpio_pool);
+    xf_hal_gpio_register(&ops);
+}
+
+XF_HAL_PORT_EXPORT(GPIO, port_gpio_ioctl, port_gpio_read, port_gpio_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_gpio_open(xf_hal_dev_t *dev)
+{
+    port_gpio_t *gpio = (port_gpio_t *)xf_hal_pool_alloc(&s_port_gpio_pool);
+    if (gpio == NULL) {
+        return -1;
+    }
+
+    memset(gpio, 0, sizeof(port_gpio_t));
+
+    // 可读表示有未读取的中断边沿
+    xf_hal_driver_poll_clear(dev, XF_HAL_POLLIN);
+
+    dev->platform_data = gpio;
+
+    return 0;
+}
+
+static int port_gpio_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_gpio_config_t *gpio_config = (xf_hal_gpio_config_t *)config;
+    port_gpio_t *gpio = (port_gpio_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_GPIO_CMD_DEFAULT) {
+        gpio_config->direction      = XF_HAL_GPIO_DEFAULT_DIRECTION;
+        gpio_config->speed          = XF_HAL_GPIO_DEFAULT_SPEED;
+        gpio_config->pull           = XF_HAL_GPIO_DEFAULT_PULL;
+        gpio_config->intr_enable    = XF_HAL_GPIO_DEFAULT_INTR_ENABLE;
+        gpio_config->intr_type      = XF_HAL_GPIO_DEFAULT_INTR_TYPE;
+        cmd = XF_HAL_GPIO_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_GPIO_CMD_PULL) {
+        gpio->level = (gpio_config->pull == XF_HAL_GPIO_PULL_UP);
+    }
+
+    if (cmd & XF_HAL_GPIO_CMD_INTR_ENABLE) {
+        gpio->intr_enable = gpio_config->intr_enable;
+    }
+
+    if (cmd & XF_HAL_GPIO_CMD_INTR_TYPE) {
+        gpio->intr_type = gpio_config->intr_type;
+    }
+
+    if (cmd & XF_HAL_GPIO_CMD_INTR_CB) {
+        gpio->cb = gpio_config->cb;
+    }
+
+    if (cmd & XF_HAL_GPIO_CMD_INTR_ISR) {
+        gpio->isr = gpio_config->isr;
+    }
+
+    return 0;
+}
+
+static int port_gpio_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_gpio_t *gpio = (port_gpio_t *)dev->platform_data;
+    *(bool *)buf = gpio->level;
+    xf_hal_driver_poll_clear(dev, XF_HAL_POLLIN);
+    return 0;
+}
+
+static int port_gpio_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_gpio_t *gpio = (port_gpio_t *)dev->platform_data;
+    bool level = *(const bool *)buf;
+    bool edge = (level != gpio->level);
+
+    gpio->level = level;
+
+    if (edge) {
+        port_sim_pin_notify(dev->id, level);
+    }
+
+    if (!edge || !gpio->intr_enable) {
+        return 0;
+    }
+
+    if (gpio->intr_type == XF_HAL_GPIO_INTR_TYPE_ANY
+            || (gpio->intr_type == XF_HAL_GPIO_INTR_TYPE_RISING && level)
+            || (gpio->intr_type == XF_HAL_GPIO_INTR_TYPE_FALLING && !level)) {
+        xf_hal_driver_poll_set(dev, XF_HAL_POLLIN);
+        if (gpio->isr.callback) {
+            gpio->isr.callback(dev->id, level, gpio->isr.user_data);
+        }
+        if (gpio->cb.callback) {
+            gpio->cb.callback(dev->id, level, gpio->cb.user_data);
+        }
+    }
+
+    return 0;
+}
+
+static int port_gpio_close(xf_hal_dev_t *dev)
+{
+    port_gpio_t *gpio = (port_gpio_t *)dev->platform_data;
+    xf_hal_pool_free(&s_port_gpio_pool, gpio);
+    return 0;
+}
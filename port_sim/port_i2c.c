@@ -0,0 +1,400 @@
+/**
+ * @file port_i2c.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief i2c 仿真对接，按时钟频率计算含寻址与应答开销的线上时间。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 每个字节占 9 个时钟（8 位数据 + ACK），起始、重复起始与停止条件各按 1 个时钟计：
+ * - 写：S + 地址 + [内存地址] + 数据 + P
+ * - 读：S + 地址 + [内存地址 + Sr + 地址] + 数据 + P
+ * 10 位地址占 2 个地址字节。从机模式只计数据字节。
+ * 主机模式下，地址上挂载了模型（port_sim_i2c_attach）时，在传输结束时刻把整个事务交给模型，
+ * 从机不应答时返回 XF_FAIL；未挂载模型的地址视为有从机应答，读取到的数据均为 0xFF。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_I2C_DEFAULT_HOSTS            XF_HAL_I2C_HOSTS_MASTER
+#define XF_HAL_I2C_DEFAULT_ADDRESS_WIDTH    XF_HAL_I2C_ADDRESS_WIDTH_7BIT
+#define XF_HAL_I2C_DEFAULT_ADDRESS          0x56
+#define XF_HAL_I2C_DEFAULT_MEM_ADDR_EN      XF_HAL_I2C_MEM_ADDR_DISABLE
+#define XF_HAL_I2C_DEFAULT_MEM_ADDR_WIDTH   XF_HAL_I2C_MEM_ADDR_WIDTH_8BIT
+#define XF_HAL_I2C_DEFAULT_SPEED            400000
+#define XF_HAL_I2C_DEFAULT_TIMEOUT          1000
+#define XF_HAL_I2C_DEFAULT_SCL_NUM          1
+#define XF_HAL_I2C_DEFAULT_SDA_NUM          2
+
+#define I2C_BYTE_CLOCKS                     9
+#define I2C_COND_CLOCKS                     1
+#define I2C_MEM_ADDR_MAX_BYTES              4
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_i2c_t {
+    xf_hal_dev_t *dev;
+    port_sim_bus_t bus;
+    uint32_t speed;
+    uint8_t hosts;
+    uint8_t address_width;
+    uint8_t mem_addr_en;
+    uint8_t mem_addr_width;
+    uint16_t address;
+    uint32_t mem_addr;
+    port_sim_event_t done;
+    xf_hal_req_t *req;
+} port_i2c_t;
+
+typedef struct _port_i2c_slave_t {
+    uint32_t i2c_num;
+    uint16_t address;
+    port_sim_i2c_model_t *model;
+} port_i2c_slave_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_i2c_open(xf_hal_dev_t *dev);
+static int port_i2c_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_i2c_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_i2c_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_i2c_close(xf_hal_dev_t *dev);
+static int port_i2c_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
+static xf_err_t port_i2c_submit(xf_hal_dev_t *dev, xf_hal_req_t *req);
+static xf_err_t port_i2c_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req);
+
+// 线上时序模型
+static uint64_t _i2c_wire_ns(port_i2c_t *i2c, bool read, size_t count, bool mem_en);
+static bool _i2c_mem_en(port_i2c_t *i2c);
+static void _i2c_done(void *arg);
+
+// 从机模型
+static port_i2c_slave_t *_i2c_slave_find(uint32_t i2c_num, uint16_t address);
+static port_sim_i2c_model_t *_i2c_model(port_i2c_t *i2c);
+static bool _i2c_model_xfer(port_i2c_t *i2c, port_sim_i2c_model_t *model, bool mem_en, uint32_t mem_addr,
+                            uint8_t *rbuf, size_t rcount, const xf_hal_iovec_t *iov, size_t iovcnt);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_i2c_pool, sizeof(port_i2c_t), XF_HAL_I2C_POOL_SIZE);
+
+static port_i2c_slave_t s_i2c_slaves[PORT_SIM_MODEL_MAX] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_I2C_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_i2c_open,
+        .ioctl = port_i2c_ioctl,
+        .write = port_i2c_write,
+        .read = port_i2c_read,
+        .close = port_i2c_close,
+        .writev = port_i2c_writev,
+        .submit = port_i2c_submit,
+        .cancel = port_i2c_cancel,
+    };
+    xf_hal_pool_init(&s_port_i2c_pool);
+    xf_hal_i2c_register(&ops);
+}
+
+int port_sim_i2c_attach(uint32_t i2c_num, uint16_t address, port_sim_i2c_model_t *model)
+{
+    port_i2c_slave_t *slave = _i2c_slave_find(i2c_num, address);
+
+    if (model == NULL) {
+        if (slave != NULL) {
+            slave->model = NULL;
+        }
+        return XF_OK;
+    }
+
+    if (slave == NULL) {
+        for (size_t i = 0; slave == NULL && i < PORT_SIM_MODEL_MAX; i++) {
+            if (s_i2c_slaves[i].model == NULL) {
+                slave = &s_i2c_slaves[i];
+            }
+        }
+        if (slave == NULL) {
+            return XF_ERR_RESOURCE;
+        }
+    }
+
+    slave->i2c_num = i2c_num;
+    slave->address = address;
+    slave->model = model;
+
+    return XF_OK;
+}
+
+XF_HAL_PORT_EXPORT(I2C, port_i2c_ioctl, port_i2c_read, port_i2c_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_i2c_open(xf_hal_dev_t *dev)
+{
+    port_i2c_t *i2c = (port_i2c_t *)xf_hal_pool_alloc(&s_port_i2c_pool);
+    if (i2c == NULL) {
+        return -1;
+    }
+
+    memset(i2c, 0, sizeof(port_i2c_t));
+    i2c->dev = dev;
+    port_sim_bus_open(&i2c->bus, XF_HAL_I2C, "i2c", dev->id);
+
+    dev->platform_data = i2c;
+
+    return 0;
+}
+
+static int port_i2c_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_i2c_config_t *i2c_config = (xf_hal_i2c_config_t *)config;
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_I2C_CMD_DEFAULT) {
+        i2c_config->hosts = XF_HAL_I2C_DEFAULT_HOSTS;
+        i2c_config->address_width = XF_HAL_I2C_DEFAULT_ADDRESS_WIDTH;
+        i2c_config->address =  XF_HAL_I2C_DEFAULT_ADDRESS;
+        i2c_config->mem_addr_en = XF_HAL_I2C_DEFAULT_MEM_ADDR_EN;
+        i2c_config->mem_addr_width = XF_HAL_I2C_DEFAULT_MEM_ADDR_WIDTH;
+        i2c_config->speed = XF_HAL_I2C_DEFAULT_SPEED;
+        i2c_config->timeout_ms = XF_HAL_I2C_DEFAULT_TIMEOUT;
+        i2c_config->scl_num = XF_HAL_I2C_DEFAULT_SCL_NUM;
+        i2c_config->sda_num = XF_HAL_I2C_DEFAULT_SDA_NUM;
+        cmd = XF_HAL_I2C_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_HOSTS) {
+        i2c->hosts = i2c_config->hosts;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_ADDRESS_WIDTH) {
+        i2c->address_width = i2c_config->address_width;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_ADDRESS) {
+        i2c->address = i2c_config->address;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_MEM_ADDR_EN) {
+        i2c->mem_addr_en = i2c_config->mem_addr_en;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_MEM_ADDR_WIDTH) {
+        i2c->mem_addr_width = i2c_config->mem_addr_width;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_MEM_ADDR) {
+        i2c->mem_addr = i2c_config->mem_addr;
+    }
+
+    if (cmd & XF_HAL_I2C_CMD_SPEED) {
+        i2c->speed = i2c_config->speed;
+    }
+
+    return 0;
+}
+
+static int port_i2c_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    port_sim_i2c_model_t *model = _i2c_model(i2c);
+
+    port_sim_bus_xfer(&i2c->bus, _i2c_wire_ns(i2c, true, count, _i2c_mem_en(i2c)), count);
+
+    if (model != NULL) {
+        return _i2c_model_xfer(i2c, model, _i2c_mem_en(i2c), i2c->mem_addr, buf, count, NULL, 0) ? (int)count : XF_FAIL;
+    }
+
+    memset(buf, 0xFF, count);
+    return count;
+}
+
+static int port_i2c_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    port_sim_i2c_model_t *model = _i2c_model(i2c);
+
+    port_sim_bus_xfer(&i2c->bus, _i2c_wire_ns(i2c, false, count, _i2c_mem_en(i2c)), count);
+
+    if (model != NULL) {
+        xf_hal_iovec_t iov = {.buf = (void *)buf, .count = count};
+        return _i2c_model_xfer(i2c, model, _i2c_mem_en(i2c), i2c->mem_addr, NULL, 0, &iov, 1) ? (int)count : XF_FAIL;
+    }
+
+    return count;
+}
+
+static int port_i2c_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    size_t total = 0;
+
+    // 各段数据放在同一个起始/停止条件之间，只寻址一次
+    for (size_t i = 0; i < iovcnt; i++) {
+        total += iov[i].count;
+    }
+    port_sim_bus_xfer(&i2c->bus, _i2c_wire_ns(i2c, false, total, _i2c_mem_en(i2c)), total);
+
+    port_sim_i2c_model_t *model = _i2c_model(i2c);
+    if (model != NULL && !_i2c_model_xfer(i2c, model, _i2c_mem_en(i2c), i2c->mem_addr, NULL, 0, iov, iovcnt)) {
+        return XF_FAIL;
+    }
+
+    return total;
+}
+
+static xf_err_t port_i2c_submit(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    bool read = (req->dir == XF_HAL_REQ_DIR_READ);
+
+    // 内存地址随请求传入，不经过 ioctl，排队的请求各自使用自己的地址
+    i2c->req = req;
+    port_sim_schedule(&i2c->done,
+                      port_sim_bus_claim(&i2c->bus, _i2c_wire_ns(i2c, read, req->count, req->addr_en), req->count),
+                      _i2c_done, i2c);
+
+    return XF_OK;
+}
+
+static xf_err_t port_i2c_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    port_sim_cancel(&i2c->done);
+    return XF_OK;
+}
+
+static int port_i2c_close(xf_hal_dev_t *dev)
+{
+    port_i2c_t *i2c = (port_i2c_t *)dev->platform_data;
+    port_sim_cancel(&i2c->done);
+    port_sim_bus_close(&i2c->bus);
+    xf_hal_pool_free(&s_port_i2c_pool, i2c);
+    return 0;
+}
+
+static bool _i2c_mem_en(port_i2c_t *i2c)
+{
+    return i2c->mem_addr_en == XF_HAL_I2C_MEM_ADDR_ENABLE;
+}
+
+static uint64_t _i2c_wire_ns(port_i2c_t *i2c, bool read, size_t count, bool mem_en)
+{
+    uint64_t clocks = (uint64_t)count * I2C_BYTE_CLOCKS;
+
+    if (i2c->hosts == XF_HAL_I2C_HOSTS_MASTER) {
+        uint32_t addr_bytes = (i2c->address_width == XF_HAL_I2C_ADDRESS_WIDTH_10BIT) ? 2 : 1;
+
+        clocks += I2C_COND_CLOCKS + addr_bytes * I2C_BYTE_CLOCKS + I2C_COND_CLOCKS;
+
+        if (mem_en) {
+            clocks += (i2c->mem_addr_width + 1) * I2C_BYTE_CLOCKS;
+            // 读操作先写内存地址，再以重复起始条件切换为读
+            if (read) {
+                clocks += I2C_COND_CLOCKS + addr_bytes * I2C_BYTE_CLOCKS;
+            }
+        }
+    }
+
+    return port_sim_bits_to_ns(clocks, i2c->speed);
+}
+
+static void _i2c_done(void *arg)
+{
+    port_i2c_t *i2c = (port_i2c_t *)arg;
+    xf_hal_req_t *req = i2c->req;
+    port_sim_i2c_model_t *model = _i2c_model(i2c);
+    int result = req->count;
+
+    if (model != NULL) {
+        bool ack;
+        if (req->dir == XF_HAL_REQ_DIR_READ) {
+            ack = _i2c_model_xfer(i2c, model, req->addr_en, req->addr, req->buf, req->count, NULL, 0);
+        } else {
+            xf_hal_iovec_t iov = {.buf = req->buf, .count = req->count};
+            ack = _i2c_model_xfer(i2c, model, req->addr_en, req->addr, NULL, 0, &iov, 1);
+        }
+        result = ack ? result : XF_FAIL;
+    } else if (req->dir == XF_HAL_REQ_DIR_READ) {
+        memset(req->buf, 0xFF, req->count);
+    }
+
+    i2c->req = NULL;
+    xf_hal_driver_complete(i2c->dev, req, result);
+}
+
+static port_i2c_slave_t *_i2c_slave_find(uint32_t i2c_num, uint16_t address)
+{
+    for (size_t i = 0; i < PORT_SIM_MODEL_MAX; i++) {
+        if (s_i2c_slaves[i].model != NULL && s_i2c_slaves[i].i2c_num == i2c_num
+                && s_i2c_slaves[i].address == address) {
+            return &s_i2c_slaves[i];
+        }
+    }
+
+    return NULL;
+}
+
+static port_sim_i2c_model_t *_i2c_model(port_i2c_t *i2c)
+{
+    if (i2c->hosts != XF_HAL_I2C_HOSTS_MASTER) {
+        return NULL;
+    }
+
+    port_i2c_slave_t *slave = _i2c_slave_find(i2c->dev->id, i2c->address);
+
+    return (slave == NULL) ? NULL : slave->model;
+}
+
+static bool _i2c_model_xfer(port_i2c_t *i2c, port_sim_i2c_model_t *model, bool mem_en, uint32_t mem_addr,
+                            uint8_t *rbuf, size_t rcount, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    bool read = (rbuf != NULL);
+    bool ack = true;
+
+    // 带内存地址时先以写方向发送地址（高字节在前），读操作再以重复起始条件切换方向
+    if (mem_en) {
+        uint8_t mem[I2C_MEM_ADDR_MAX_BYTES];
+        size_t mem_bytes = i2c->mem_addr_width + 1;
+
+        for (size_t i = 0; i < mem_bytes; i++) {
+            mem[i] = (uint8_t)(mem_addr >> (8 * (mem_bytes - 1 - i)));
+        }
+
+        ack = model->start(model, false) && model->write(model, mem, mem_bytes);
+        if (ack && read) {
+            ack = model->start(model, true);
+        }
+    } else {
+        ack = model->start(model, read);
+    }
+
+    if (ack) {
+        if (read) {
+            model->read(model, rbuf, rcount);
+        } else {
+            for (size_t i = 0; ack && i < iovcnt; i++) {
+                ack = model->write(model, (const uint8_t *)iov[i].buf, iov[i].count);
+            }
+        }
+    }
+
+    model->stop(model);
+
+    return ack;
+}
@@ -0,0 +1,134 @@
+/**
+ * @file port_pwm.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief pwm 仿真对接，仅保存已下发的参数。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_PWM_DEFAULT_FREQ             1000
+#define XF_HAL_PWM_DEFAULT_DUTY             512
+#define XF_HAL_PWM_DEFAULT_DUTY_RESOLUTION  10
+#define XF_HAL_PWM_DEFAULT_ENABLE           false
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_pwm_t {
+    bool enable;
+    uint32_t freq;
+    uint32_t duty;
+    uint32_t duty_resolution;
+} port_pwm_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_pwm_open(xf_hal_dev_t *dev);
+static int port_pwm_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_pwm_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_pwm_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_pwm_close(xf_hal_dev_t *dev);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_pwm_pool, sizeof(port_pwm_t), XF_HAL_PWM_POOL_SIZE);
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_PWM_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_pwm_open,
+        .ioctl = port_pwm_ioctl,
+        .write = port_pwm_write,
+        .read = port_pwm_read,
+        .close = port_pwm_close,
+    };
+    xf_hal_pool_init(&s_port_pwm_pool);
+    xf_hal_pwm_register(&ops);
+}
+
+XF_HAL_PORT_EXPORT(PWM, port_pwm_ioctl, port_pwm_read, port_pwm_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_pwm_open(xf_hal_dev_t *dev)
+{
+    port_pwm_t *pwm = (port_pwm_t *)xf_hal_pool_alloc(&s_port_pwm_pool);
+    if (pwm == NULL) {
+        return -1;
+    }
+
+    memset(pwm, 0, sizeof(port_pwm_t));
+
+    dev->platform_data = pwm;
+
+    return 0;
+}
+
+static int port_pwm_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_pwm_config_t *pwm_config = (xf_hal_pwm_config_t *)config;
+    port_pwm_t *pwm = (port_pwm_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_PWM_CMD_DEFAULT) {
+        pwm_config->freq = XF_HAL_PWM_DEFAULT_FREQ;
+        pwm_config->duty = XF_HAL_PWM_DEFAULT_DUTY;
+        pwm_config->duty_resolution = XF_HAL_PWM_DEFAULT_DUTY_RESOLUTION;
+        pwm_config->enable = XF_HAL_PWM_DEFAULT_ENABLE;
+        cmd = XF_HAL_PWM_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_PWM_CMD_ENABLE) {
+        pwm->enable = pwm_config->enable;
+    }
+
+    if (cmd & XF_HAL_PWM_CMD_FREQ) {
+        pwm->freq = pwm_config->freq;
+    }
+
+    if (cmd & XF_HAL_PWM_CMD_DUTY) {
+        pwm->duty = pwm_config->duty;
+    }
+
+    if (cmd & XF_HAL_PWM_CMD_DUTY_RESOLUTION) {
+        pwm->duty_resolution = pwm_config->duty_resolution;
+    }
+
+    return 0;
+}
+
+static int port_pwm_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    // no need
+    return 0;
+}
+
+static int port_pwm_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    // no need
+    return 0;
+}
+
+static int port_pwm_close(xf_hal_dev_t *dev)
+{
+    port_pwm_t *pwm = (port_pwm_t *)dev->platform_data;
+    xf_hal_pool_free(&s_port_pwm_pool, pwm);
+    return 0;
+}
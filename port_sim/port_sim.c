@@ -0,0 +1,372 @@
+/**
+ * @file port_sim.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 仿真对接层的虚拟时钟与线上时序模型。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "port_sim.h"
+#include "xf_hal_port.h"
+#include <stdio.h>
+#include <pthread.h>
+#include <time.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _sim_pin_watch_t {
+    uint32_t pin;
+    port_sim_pin_cb_t cb;
+    void *arg;
+} sim_pin_watch_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void sim_event_remove(port_sim_event_t *ev);
+
+/* ==================== [Static Variables] ================================== */
+
+// 虚拟时钟、事件链表与总线链表共用一把锁，事件回调在锁外执行
+static pthread_mutex_t s_sim_mutex = PTHREAD_MUTEX_INITIALIZER;
+static uint64_t s_sim_now = 0;
+static port_sim_event_t *s_sim_events = NULL;  // 按 due 升序，相同 due 先登记先触发
+static port_sim_bus_t *s_sim_buses = NULL;
+static uint32_t s_sim_setup_ns[XF_HAL_TYPE_MAX] = {0};
+static sim_pin_watch_t s_sim_pins[PORT_SIM_PIN_WATCH_MAX] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+uint64_t port_sim_now(void)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+    uint64_t now = s_sim_now;
+    pthread_mutex_unlock(&s_sim_mutex);
+    return now;
+}
+
+uint32_t port_sim_now_us(void)
+{
+    return (uint32_t)(port_sim_now() / 1000);
+}
+
+void port_sim_advance(uint64_t ns)
+{
+    port_sim_run_until(port_sim_now() + ns);
+}
+
+void port_sim_run_until(uint64_t t)
+{
+    for (;;) {
+        pthread_mutex_lock(&s_sim_mutex);
+
+        port_sim_event_t *ev = s_sim_events;
+        if (ev == NULL || ev->due > t) {
+            if (t > s_sim_now) {
+                s_sim_now = t;
+            }
+            pthread_mutex_unlock(&s_sim_mutex);
+            return;
+        }
+
+        s_sim_events = ev->next;
+        ev->pending = false;
+        if (ev->due > s_sim_now) {
+            s_sim_now = ev->due;
+        }
+        port_sim_event_cb_t cb = ev->cb;
+        void *arg = ev->arg;
+
+        pthread_mutex_unlock(&s_sim_mutex);
+
+        // 回调中可能再次登记事件（如启动下一个请求），因此不能持锁
+        cb(arg);
+    }
+}
+
+bool port_sim_run_next(void)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    port_sim_event_t *ev = s_sim_events;
+    if (ev == NULL) {
+        pthread_mutex_unlock(&s_sim_mutex);
+        return false;
+    }
+
+    s_sim_events = ev->next;
+    ev->pending = false;
+    if (ev->due > s_sim_now) {
+        s_sim_now = ev->due;
+    }
+    port_sim_event_cb_t cb = ev->cb;
+    void *arg = ev->arg;
+
+    pthread_mutex_unlock(&s_sim_mutex);
+
+    cb(arg);
+
+    return true;
+}
+
+int port_sim_poll_wait(int timeout_ms)
+{
+    if (timeout_ms < 0) {
+        if (!port_sim_run_next()) {
+            // 不使用 unistd.h，启用 posix 层时其 read / write 声明与之冲突
+            struct timespec ts = {.tv_sec = 0, .tv_nsec = 1000000};
+            nanosleep(&ts, NULL);
+        }
+        return -1;
+    }
+
+    pthread_mutex_lock(&s_sim_mutex);
+    uint64_t deadline = s_sim_now + (uint64_t)timeout_ms * PORT_SIM_NS_PER_MS;
+    bool due = (s_sim_events != NULL && s_sim_events->due <= deadline);
+    pthread_mutex_unlock(&s_sim_mutex);
+
+    if (!due) {
+        port_sim_run_until(deadline);
+        return 0;
+    }
+
+    port_sim_run_next();
+
+    // 向上取整，不足 1ms 时仍按 1ms 继续等待，避免提前超时
+    uint64_t now = port_sim_now();
+    return (now >= deadline) ? 0 : (int)((deadline - now + PORT_SIM_NS_PER_MS - 1) / PORT_SIM_NS_PER_MS);
+}
+
+void port_sim_reset(void)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    while (s_sim_events != NULL) {
+        port_sim_event_t *ev = s_sim_events;
+        s_sim_events = ev->next;
+        ev->pending = false;
+    }
+
+    for (port_sim_bus_t *bus = s_sim_buses; bus != NULL; bus = bus->next) {
+        bus->busy_until = 0;
+        bus->busy_ns = 0;
+        bus->bytes = 0;
+        bus->xfers = 0;
+    }
+
+    s_sim_now = 0;
+
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+void port_sim_schedule(port_sim_event_t *ev, uint64_t due, port_sim_event_cb_t cb, void *arg)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    if (ev->pending) {
+        sim_event_remove(ev);
+    }
+
+    ev->due = due;
+    ev->cb = cb;
+    ev->arg = arg;
+    ev->pending = true;
+
+    port_sim_event_t **pos = &s_sim_events;
+    while (*pos != NULL && (*pos)->due <= due) {
+        pos = &(*pos)->next;
+    }
+    ev->next = *pos;
+    *pos = ev;
+
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+bool port_sim_cancel(port_sim_event_t *ev)
+{
+    bool pending;
+
+    pthread_mutex_lock(&s_sim_mutex);
+    pending = ev->pending;
+    if (pending) {
+        sim_event_remove(ev);
+    }
+    pthread_mutex_unlock(&s_sim_mutex);
+
+    return pending;
+}
+
+void port_sim_bus_open(port_sim_bus_t *bus, int type, const char *name, uint32_t id)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    bus->name = name;
+    bus->id = id;
+    bus->type = type;
+    bus->busy_until = s_sim_now;
+    bus->busy_ns = 0;
+    bus->bytes = 0;
+    bus->xfers = 0;
+    bus->next = s_sim_buses;
+    s_sim_buses = bus;
+
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+void port_sim_bus_close(port_sim_bus_t *bus)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    port_sim_bus_t **pos = &s_sim_buses;
+    while (*pos != NULL && *pos != bus) {
+        pos = &(*pos)->next;
+    }
+    if (*pos != NULL) {
+        *pos = bus->next;
+    }
+    bus->next = NULL;
+
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+uint64_t port_sim_bus_claim(port_sim_bus_t *bus, uint64_t wire_ns, size_t bytes)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    uint64_t start = (bus->busy_until > s_sim_now) ? bus->busy_until : s_sim_now;
+    uint64_t duration = wire_ns;
+    if (bus->type >= 0 && bus->type < XF_HAL_TYPE_MAX) {
+        duration += s_sim_setup_ns[bus->type];
+    }
+
+    bus->busy_until = start + duration;
+    bus->busy_ns += duration;
+    bus->bytes += bytes;
+    bus->xfers++;
+
+    uint64_t end = bus->busy_until;
+
+    pthread_mutex_unlock(&s_sim_mutex);
+
+    return end;
+}
+
+void port_sim_bus_xfer(port_sim_bus_t *bus, uint64_t wire_ns, size_t bytes)
+{
+    port_sim_run_until(port_sim_bus_claim(bus, wire_ns, bytes));
+}
+
+void port_sim_set_setup_ns(int type, uint32_t setup_ns)
+{
+    if (type < 0 || type >= XF_HAL_TYPE_MAX) {
+        return;
+    }
+
+    pthread_mutex_lock(&s_sim_mutex);
+    s_sim_setup_ns[type] = setup_ns;
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+uint32_t port_sim_get_setup_ns(int type)
+{
+    if (type < 0 || type >= XF_HAL_TYPE_MAX) {
+        return 0;
+    }
+
+    return s_sim_setup_ns[type];
+}
+
+int port_sim_pin_watch(uint32_t pin, port_sim_pin_cb_t cb, void *arg)
+{
+    int err = XF_ERR_RESOURCE;
+
+    pthread_mutex_lock(&s_sim_mutex);
+    for (size_t i = 0; i < PORT_SIM_PIN_WATCH_MAX; i++) {
+        if (s_sim_pins[i].cb == NULL) {
+            s_sim_pins[i].pin = pin;
+            s_sim_pins[i].arg = arg;
+            s_sim_pins[i].cb = cb;
+            err = XF_OK;
+            break;
+        }
+    }
+    pthread_mutex_unlock(&s_sim_mutex);
+
+    return err;
+}
+
+void port_sim_pin_unwatch(uint32_t pin, port_sim_pin_cb_t cb, void *arg)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+    for (size_t i = 0; i < PORT_SIM_PIN_WATCH_MAX; i++) {
+        if (s_sim_pins[i].cb == cb && s_sim_pins[i].pin == pin && s_sim_pins[i].arg == arg) {
+            s_sim_pins[i].cb = NULL;
+        }
+    }
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+void port_sim_pin_notify(uint32_t pin, bool level)
+{
+    sim_pin_watch_t hits[PORT_SIM_PIN_WATCH_MAX];
+    size_t n = 0;
+
+    // 先复制再在锁外回调，回调中会访问虚拟时钟
+    pthread_mutex_lock(&s_sim_mutex);
+    for (size_t i = 0; i < PORT_SIM_PIN_WATCH_MAX; i++) {
+        if (s_sim_pins[i].cb != NULL && s_sim_pins[i].pin == pin) {
+            hits[n++] = s_sim_pins[i];
+        }
+    }
+    pthread_mutex_unlock(&s_sim_mutex);
+
+    for (size_t i = 0; i < n; i++) {
+        hits[i].cb(hits[i].arg, pin, level);
+    }
+}
+
+void port_sim_dump(void)
+{
+    pthread_mutex_lock(&s_sim_mutex);
+
+    uint64_t now = s_sim_now;
+
+    printf("sim time: %llu us\n", (unsigned long long)(now / 1000));
+    printf("%-6s %4s %10s %12s %12s %7s %12s\n",
+           "bus", "id", "xfers", "bytes", "busy(us)", "util%", "B/s");
+
+    for (port_sim_bus_t *bus = s_sim_buses; bus != NULL; bus = bus->next) {
+        // 有效吞吐按总线实际占用时间计算，不受空闲时间影响
+        double util = (now == 0) ? 0.0 : 100.0 * (double)bus->busy_ns / (double)now;
+        double rate = (bus->busy_ns == 0) ? 0.0 : (double)bus->bytes * 1e9 / (double)bus->busy_ns;
+        printf("%-6s %4u %10u %12llu %12llu %7.2f %12.0f\n",
+               bus->name, (unsigned)bus->id, (unsigned)bus->xfers,
+               (unsigned long long)bus->bytes, (unsigned long long)(bus->busy_ns / 1000),
+               util, rate);
+    }
+
+    pthread_mutex_unlock(&s_sim_mutex);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void sim_event_remove(port_sim_event_t *ev)
+{
+    port_sim_event_t **pos = &s_sim_events;
+    while (*pos != NULL && *pos != ev) {
+        pos = &(*pos)->next;
+    }
+    if (*pos != NULL) {
+        *pos = ev->next;
+    }
+    ev->next = NULL;
+    ev->pending = false;
+}
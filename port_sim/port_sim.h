@@ -0,0 +1,210 @@
+/**
+ * @file port_sim.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 仿真对接层的虚拟时钟与线上时序模型。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 仿真对接层不访问任何硬件，而是按照设备配置计算每次传输在线上占用的时间，
+ * 并推进一个全局的虚拟时钟（单位 ns）：
+ * - 同步读写：传输从 max(当前时间, 总线空闲时间) 开始，返回时虚拟时钟推进到传输结束。
+ * - 异步提交：只占用总线并登记完成事件，不推进时钟；
+ *   由 port_sim_advance() / port_sim_run_next() 推进时钟时触发完成回调。
+ *   多个总线上的异步传输因此可以在虚拟时间上重叠。
+ *
+ * 虚拟时钟与主机真实时间无关，吞吐量 = 传输字节数 / 虚拟时间差。
+ */
+
+#ifndef __PORT_SIM_H__
+#define __PORT_SIM_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define PORT_SIM_NS_PER_SEC     1000000000ULL
+#define PORT_SIM_NS_PER_MS      1000000ULL
+
+#if !defined(PORT_SIM_PIN_WATCH_MAX)
+#define PORT_SIM_PIN_WATCH_MAX  8
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef void (*port_sim_event_cb_t)(void *arg);
+typedef void (*port_sim_pin_cb_t)(void *arg, uint32_t pin, bool level);
+
+/**
+ * @brief 虚拟时钟上的定时事件，由调用者提供存储。
+ */
+typedef struct _port_sim_event_t {
+    struct _port_sim_event_t *next;
+    uint64_t due;                   /*!< 触发时刻，单位 ns */
+    port_sim_event_cb_t cb;
+    void *arg;
+    bool pending;
+} port_sim_event_t;
+
+/**
+ * @brief 一条仿真总线的占用状态，由对接文件在 open 时登记、close 时注销。
+ */
+typedef struct _port_sim_bus_t {
+    struct _port_sim_bus_t *next;
+    const char *name;
+    uint32_t id;
+    int type;                       /*!< xf_hal_type_t，用于查找每次传输的固定开销 */
+    uint64_t busy_until;            /*!< 总线空闲时刻，单位 ns */
+    uint64_t busy_ns;               /*!< 累计占用时间 */
+    uint64_t bytes;                 /*!< 累计传输字节数 */
+    uint32_t xfers;                 /*!< 累计传输次数 */
+} port_sim_bus_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 获取虚拟时间。
+ *
+ * @return uint64_t 当前虚拟时间，单位 ns。
+ */
+uint64_t port_sim_now(void);
+
+/**
+ * @brief 获取虚拟时间（微秒，32 位回绕）。
+ *
+ * 可直接作为 xf_hal_stats_set_clock / xf_hal_trace_set_clock 的时钟。
+ */
+uint32_t port_sim_now_us(void);
+
+/**
+ * @brief 推进虚拟时钟，并按时间顺序触发期间到期的事件。
+ *
+ * @param ns 推进的时长，单位 ns。
+ */
+void port_sim_advance(uint64_t ns);
+
+/**
+ * @brief 推进虚拟时钟到指定时刻，早于当前时间时只触发已到期事件。
+ */
+void port_sim_run_until(uint64_t t);
+
+/**
+ * @brief 推进虚拟时钟到下一个事件并触发它。
+ *
+ * @return true 触发了一个事件；false 没有待触发事件。
+ */
+bool port_sim_run_next(void);
+
+/**
+ * @brief 供 xf_hal_poll_set_waiter 使用的等待函数：依次触发到期前的事件直到有事件被触发，
+ *        超时前没有事件时推进到超时时刻。
+ *        timeout_ms 为 -1 且没有待触发事件时（如只等待伪终端输入）让出 1ms 实际时间。
+ *        驱动虚拟时钟的就是 poll 线程，不需要唤醒函数。
+ *
+ * @param timeout_ms 最长等待的虚拟时间，-1 表示一直等待。
+ * @return int 剩余的等待时间，见 xf_hal_poll_wait_t。
+ */
+int port_sim_poll_wait(int timeout_ms);
+
+/**
+ * @brief 将虚拟时钟归零，丢弃所有待触发事件并清空各总线统计。
+ */
+void port_sim_reset(void);
+
+/**
+ * @brief 在虚拟时刻 due 登记事件，事件已登记时先取消再登记。
+ */
+void port_sim_schedule(port_sim_event_t *ev, uint64_t due, port_sim_event_cb_t cb, void *arg);
+
+/**
+ * @brief 取消事件。
+ *
+ * @return true 事件被取消；false 事件未登记或已触发。
+ */
+bool port_sim_cancel(port_sim_event_t *ev);
+
+/**
+ * @brief 登记 / 注销一条总线。
+ *
+ * @param bus 总线，通常放在对接文件的 platform_data 中。
+ * @param type xf_hal_type_t，如 XF_HAL_UART。
+ * @param name 总线名称，用于 port_sim_dump。
+ * @param id 设备号。
+ */
+void port_sim_bus_open(port_sim_bus_t *bus, int type, const char *name, uint32_t id);
+void port_sim_bus_close(port_sim_bus_t *bus);
+
+/**
+ * @brief 在总线上占用一段线上时间。
+ *
+ * @param bus 总线。
+ * @param wire_ns 线上时间，不含固定开销。
+ * @param bytes 传输字节数，仅用于统计。
+ * @return uint64_t 传输结束的虚拟时刻。
+ */
+uint64_t port_sim_bus_claim(port_sim_bus_t *bus, uint64_t wire_ns, size_t bytes);
+
+/**
+ * @brief 同步传输：占用总线并将虚拟时钟推进到传输结束。
+ */
+void port_sim_bus_xfer(port_sim_bus_t *bus, uint64_t wire_ns, size_t bytes);
+
+/**
+ * @brief 按 bits 与时钟频率换算线上时间。
+ *
+ * @param bits 线上时钟数（半位时传入 2 倍并令 hz 乘 2）。
+ * @param hz 时钟频率，为 0 时视为不耗时。
+ */
+static inline uint64_t port_sim_bits_to_ns(uint64_t bits, uint32_t hz)
+{
+    return (hz == 0) ? 0 : (bits * PORT_SIM_NS_PER_SEC + hz - 1) / hz;
+}
+
+/**
+ * @brief 设置各类总线的每次传输固定开销，用于比较合并传输的收益。
+ *
+ * @param type xf_hal_type_t，如 XF_HAL_UART。
+ * @param setup_ns 固定开销，单位 ns。
+ */
+void port_sim_set_setup_ns(int type, uint32_t setup_ns);
+uint32_t port_sim_get_setup_ns(int type);
+
+/**
+ * @brief 监听 gpio 输出电平，用于把 gpio 连到仿真外设（如软件片选）。
+ *
+ * @param pin gpio 号。
+ * @param cb 电平变化时在写 gpio 的线程中调用。
+ * @param arg 回调参数。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_RESOURCE       监听表已满，见 PORT_SIM_PIN_WATCH_MAX
+ */
+int port_sim_pin_watch(uint32_t pin, port_sim_pin_cb_t cb, void *arg);
+void port_sim_pin_unwatch(uint32_t pin, port_sim_pin_cb_t cb, void *arg);
+
+/**
+ * @brief 由 gpio 仿真对接在输出电平变化时调用。
+ */
+void port_sim_pin_notify(uint32_t pin, bool level);
+
+/**
+ * @brief 打印各总线的占用统计（传输次数、字节数、占用率、有效吞吐）。
+ */
+void port_sim_dump(void);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __PORT_SIM_H__
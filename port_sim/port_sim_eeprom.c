@@ -0,0 +1,169 @@
+/**
+ * @file port_sim_eeprom.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 24Cxx 系列 i2c eeprom 模型。
+ * @version 0.1
+ * @date 2024-07-22
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 写事务的前 addr_bytes 个字节为内存地址（高字节在前），其后的数据写入页缓存，
+ * 超出页边界时回到页首；停止条件时写入存储并进入写周期，写周期内不应答寻址。
+ * 读事务从当前地址开始顺序读，到达末尾后回到 0。
+ * 24C04 ~ 24C16 借用从机地址低位作为块选择的方式不做模拟，需要时按块挂载多个实例。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim_model.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+struct _port_sim_eeprom_t {
+    port_sim_i2c_model_t model;     // 必须为第一个成员
+    port_sim_eeprom_config_t config;
+    uint8_t *data;
+    uint8_t *page;                  // 页写缓存
+    uint32_t ptr;                   // 内部地址计数器
+    uint32_t page_base;
+    uint8_t addr_got;               // 本次写事务已收到的内存地址字节数
+    bool writing;                   // 页缓存中有待写入的数据
+    uint64_t busy_until;            // 写周期结束时刻
+};
+
+/* ==================== [Static Prototypes] ================================= */
+
+static bool eeprom_start(port_sim_i2c_model_t *model, bool read);
+static bool eeprom_write(port_sim_i2c_model_t *model, const uint8_t *buf, size_t count);
+static void eeprom_read(port_sim_i2c_model_t *model, uint8_t *buf, size_t count);
+static void eeprom_stop(port_sim_i2c_model_t *model);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+port_sim_eeprom_t *port_sim_eeprom_create(const port_sim_eeprom_config_t *config)
+{
+    if (config == NULL || config->size == 0 || config->page_size == 0 || config->addr_bytes == 0) {
+        return NULL;
+    }
+
+    port_sim_eeprom_t *eeprom = (port_sim_eeprom_t *)calloc(1, sizeof(port_sim_eeprom_t));
+    if (eeprom == NULL) {
+        return NULL;
+    }
+
+    eeprom->data = (uint8_t *)malloc(config->size);
+    eeprom->page = (uint8_t *)malloc(config->page_size);
+    if (eeprom->data == NULL || eeprom->page == NULL) {
+        port_sim_eeprom_destroy(eeprom);
+        return NULL;
+    }
+
+    memset(eeprom->data, 0xFF, config->size);
+    eeprom->config = *config;
+    eeprom->model.start = eeprom_start;
+    eeprom->model.write = eeprom_write;
+    eeprom->model.read = eeprom_read;
+    eeprom->model.stop = eeprom_stop;
+
+    return eeprom;
+}
+
+void port_sim_eeprom_destroy(port_sim_eeprom_t *eeprom)
+{
+    if (eeprom == NULL) {
+        return;
+    }
+
+    free(eeprom->data);
+    free(eeprom->page);
+    free(eeprom);
+}
+
+port_sim_i2c_model_t *port_sim_eeprom_model(port_sim_eeprom_t *eeprom)
+{
+    return &eeprom->model;
+}
+
+uint8_t *port_sim_eeprom_data(port_sim_eeprom_t *eeprom)
+{
+    return eeprom->data;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static bool eeprom_start(port_sim_i2c_model_t *model, bool read)
+{
+    port_sim_eeprom_t *eeprom = (port_sim_eeprom_t *)model;
+
+    // 写周期内芯片与总线断开，主机可据此做应答轮询
+    if (port_sim_now() < eeprom->busy_until) {
+        return false;
+    }
+
+    if (!read) {
+        eeprom->addr_got = 0;
+    }
+
+    return true;
+}
+
+static bool eeprom_write(port_sim_i2c_model_t *model, const uint8_t *buf, size_t count)
+{
+    port_sim_eeprom_t *eeprom = (port_sim_eeprom_t *)model;
+    uint32_t page_size = eeprom->config.page_size;
+
+    for (size_t i = 0; i < count; i++) {
+        if (eeprom->addr_got < eeprom->config.addr_bytes) {
+            eeprom->ptr = (eeprom->addr_got == 0) ? buf[i] : ((eeprom->ptr << 8) | buf[i]);
+            if (++eeprom->addr_got == eeprom->config.addr_bytes) {
+                eeprom->ptr %= eeprom->config.size;
+            }
+            continue;
+        }
+
+        if (!eeprom->writing) {
+            eeprom->page_base = eeprom->ptr - eeprom->ptr % page_size;
+            memcpy(eeprom->page, eeprom->data + eeprom->page_base, page_size);
+            eeprom->writing = true;
+        }
+
+        // 页内回绕：超过页大小的数据会覆盖本页开头
+        uint32_t col = eeprom->ptr - eeprom->page_base;
+        eeprom->page[col] = buf[i];
+        eeprom->ptr = eeprom->page_base + (col + 1) % page_size;
+    }
+
+    return true;
+}
+
+static void eeprom_read(port_sim_i2c_model_t *model, uint8_t *buf, size_t count)
+{
+    port_sim_eeprom_t *eeprom = (port_sim_eeprom_t *)model;
+
+    for (size_t i = 0; i < count; i++) {
+        buf[i] = eeprom->data[eeprom->ptr];
+        eeprom->ptr = (eeprom->ptr + 1) % eeprom->config.size;
+    }
+}
+
+static void eeprom_stop(port_sim_i2c_model_t *model)
+{
+    port_sim_eeprom_t *eeprom = (port_sim_eeprom_t *)model;
+
+    if (!eeprom->writing) {
+        return;
+    }
+
+    memcpy(eeprom->data + eeprom->page_base, eeprom->page, eeprom->config.page_size);
+    eeprom->writing = false;
+    eeprom->busy_until = port_sim_now() + eeprom->config.write_ns;
+}
@@ -0,0 +1,215 @@
+/**
+ * @file port_sim_model.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 挂载在仿真总线上的虚拟外设。
+ * @version 0.1
+ * @date 2024-07-22
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 仿真对接层（port_i2c.c / port_spi.c / port_uart.c）在总线上找到挂载的模型时，
+ * 按线上的事务顺序调用模型接口，未挂载模型时保持原有行为。
+ * 模型结构体需把接口结构体放在第一个成员，接口函数通过强制转换取得模型本身。
+ *
+ * 内置模型：
+ * - 24Cxx 系列 i2c eeprom：内存地址宽度、页内回绕、写周期内不应答（可用于 ACK 轮询）
+ * - JEDEC spi nor flash：RDID / RDSR / WREN / WRDI / READ / FAST_READ / PP / SE / BE / CE，
+ *   编程与擦除按虚拟时钟计时，期间 WIP 置位
+ * - uart 链路：自环、两个 uart 互连、主机伪终端（pty）
+ */
+
+#ifndef __PORT_SIM_MODEL_H__
+#define __PORT_SIM_MODEL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "port_sim.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#if !defined(PORT_SIM_MODEL_MAX)
+#define PORT_SIM_MODEL_MAX          8       /*!< 每类总线可挂载的模型数量 */
+#endif
+
+#if !defined(PORT_SIM_UART_FIFO_SIZE)
+#define PORT_SIM_UART_FIFO_SIZE     4096    /*!< uart 链路接收 FIFO 大小，溢出时丢弃新数据 */
+#endif
+
+#define PORT_SIM_PIN_NONE           ((uint32_t)-1)
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief i2c 从机模型接口，按事务顺序调用。
+ */
+typedef struct _port_sim_i2c_model_t port_sim_i2c_model_t;
+struct _port_sim_i2c_model_t {
+    bool (*start)(port_sim_i2c_model_t *model, bool read);  /*!< 起始或重复起始条件，返回 false 表示地址不应答 */
+    bool (*write)(port_sim_i2c_model_t *model, const uint8_t *buf, size_t count);  /*!< 主机写，返回 false 表示数据不应答 */
+    void (*read)(port_sim_i2c_model_t *model, uint8_t *buf, size_t count);  /*!< 主机读 */
+    void (*stop)(port_sim_i2c_model_t *model);  /*!< 停止条件 */
+};
+
+/**
+ * @brief spi 从机模型接口，select 与 deselect 之间为一帧。
+ */
+typedef struct _port_sim_spi_model_t port_sim_spi_model_t;
+struct _port_sim_spi_model_t {
+    void (*select)(port_sim_spi_model_t *model);
+    void (*xfer)(port_sim_spi_model_t *model, const uint8_t *tx, uint8_t *rx, size_t count);  /*!< tx / rx 可为 NULL */
+    void (*deselect)(port_sim_spi_model_t *model);
+};
+
+/**
+ * @brief uart 对端模型接口。
+ */
+typedef struct _port_sim_uart_model_t port_sim_uart_model_t;
+struct _port_sim_uart_model_t {
+    /**
+     * @brief 发送：第 i 个字节在 start + (i + 1) * frame_ns 时刻离开线路。
+     */
+    void (*tx)(port_sim_uart_model_t *model, const uint8_t *buf, size_t count, uint64_t start, uint64_t frame_ns);
+    /**
+     * @brief 接收：取出在 now 之前到达的数据。
+     *
+     * @param next 返回下一个未到达字节的到达时刻，没有时为 UINT64_MAX。
+     * @return size_t 取出的字节数。
+     */
+    size_t (*rx)(port_sim_uart_model_t *model, uint8_t *buf, size_t count, uint64_t now, uint64_t *next);
+    /**
+     * @brief 第 count 个排队字节的到达时刻，排队不足 count 字节时为 UINT64_MAX。
+     */
+    uint64_t (*rx_ready)(port_sim_uart_model_t *model, size_t count);
+
+    void (*rx_notify)(void *arg);   /*!< 由 port_sim_uart_attach 设置，模型排入新数据后调用，可在其他线程调用 */
+    void *rx_notify_arg;
+};
+
+/**
+ * @brief 24Cxx eeprom 参数。
+ */
+typedef struct _port_sim_eeprom_config_t {
+    uint32_t size;              /*!< 容量，单位字节 */
+    uint16_t page_size;         /*!< 页大小，页写超出时在页内回绕 */
+    uint8_t addr_bytes;         /*!< 内存地址字节数，需与 xf_hal_i2c_config_t.mem_addr_width 一致 */
+    uint32_t write_ns;          /*!< 写周期 tWR */
+} port_sim_eeprom_config_t;
+
+/**
+ * @brief spi nor flash 参数。
+ */
+typedef struct _port_sim_nor_config_t {
+    uint8_t jedec_id[3];        /*!< 厂商 id、存储类型、容量 */
+    uint32_t size;              /*!< 容量，单位字节，最大 16MB（3 字节地址） */
+    uint64_t page_program_ns;   /*!< 页编程时间 tPP */
+    uint64_t sector_erase_ns;   /*!< 4KB 扇区擦除时间 tSE */
+    uint64_t block_erase_ns;    /*!< 64KB 块擦除时间 tBE */
+    uint64_t chip_erase_ns;     /*!< 整片擦除时间 tCE */
+} port_sim_nor_config_t;
+
+typedef struct _port_sim_eeprom_t port_sim_eeprom_t;
+typedef struct _port_sim_nor_t port_sim_nor_t;
+typedef struct _port_sim_uart_link_t port_sim_uart_link_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 在 i2c 总线上挂载从机模型，主机以 xf_hal_i2c_config_t.address 寻址。
+ *
+ * @param i2c_num i2c 号。
+ * @param address 从机地址。
+ * @param model 模型，为 NULL 时卸载。
+ * @return int XF_OK 或 XF_ERR_RESOURCE。
+ */
+int port_sim_i2c_attach(uint32_t i2c_num, uint16_t address, port_sim_i2c_model_t *model);
+
+/**
+ * @brief 在 spi 总线上挂载从机模型。
+ *
+ * @param spi_num spi 号。
+ * @param cs_pin 为 PORT_SIM_PIN_NONE 时每次读写自动成帧（硬件片选）；
+ *        否则由该 gpio 的输出电平控制片选（低有效），可在一帧内先写命令再读数据。
+ * @param model 模型，为 NULL 时卸载。
+ * @return int XF_OK 或 XF_ERR_RESOURCE。
+ */
+int port_sim_spi_attach(uint32_t spi_num, uint32_t cs_pin, port_sim_spi_model_t *model);
+
+/**
+ * @brief 把 uart 连接到对端模型，为 NULL 时断开。
+ */
+int port_sim_uart_attach(uint32_t uart_num, port_sim_uart_model_t *model);
+
+/**
+ * @brief 创建 24Cxx eeprom，初始内容为 0xFF。
+ */
+port_sim_eeprom_t *port_sim_eeprom_create(const port_sim_eeprom_config_t *config);
+void port_sim_eeprom_destroy(port_sim_eeprom_t *eeprom);
+port_sim_i2c_model_t *port_sim_eeprom_model(port_sim_eeprom_t *eeprom);
+uint8_t *port_sim_eeprom_data(port_sim_eeprom_t *eeprom);
+
+/**
+ * @brief 创建 spi nor flash，初始内容为 0xFF。
+ */
+port_sim_nor_t *port_sim_nor_create(const port_sim_nor_config_t *config);
+void port_sim_nor_destroy(port_sim_nor_t *nor);
+port_sim_spi_model_t *port_sim_nor_model(port_sim_nor_t *nor);
+uint8_t *port_sim_nor_data(port_sim_nor_t *nor);
+
+/**
+ * @brief 创建 uart 链路端点。
+ *
+ * - loopback：发送的数据回到自身接收端
+ * - pair：a 发送的数据到达 b，b 发送的数据到达 a
+ * - pty：发送的数据写入主机伪终端，外部程序写入伪终端的数据在当前虚拟时刻到达，
+ *   path 返回伪终端从设备路径（如 /dev/pts/3）；启用 posix 层（XF_HAL_POSIX_DISABLE=0）时不可用，返回 NULL
+ */
+port_sim_uart_link_t *port_sim_uart_loopback_create(void);
+int port_sim_uart_pair_create(port_sim_uart_link_t **a, port_sim_uart_link_t **b);
+port_sim_uart_link_t *port_sim_uart_pty_create(char *path, size_t path_size);
+void port_sim_uart_link_destroy(port_sim_uart_link_t *link);
+port_sim_uart_model_t *port_sim_uart_link_model(port_sim_uart_link_t *link);
+uint32_t port_sim_uart_link_overrun(port_sim_uart_link_t *link);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 24C256：32KB，64 字节页，16 位内存地址，tWR 5ms。
+ */
+#define PORT_SIM_EEPROM_CONFIG_24C256() { \
+    .size = 32 * 1024, \
+    .page_size = 64, \
+    .addr_bytes = 2, \
+    .write_ns = 5000000, \
+}
+
+/**
+ * @brief 24C02：256 字节，8 字节页，8 位内存地址，tWR 5ms。
+ */
+#define PORT_SIM_EEPROM_CONFIG_24C02() { \
+    .size = 256, \
+    .page_size = 8, \
+    .addr_bytes = 1, \
+    .write_ns = 5000000, \
+}
+
+/**
+ * @brief W25Q64 典型值：8MB，tPP 0.4ms，tSE 45ms，tBE 150ms，tCE 20s。
+ */
+#define PORT_SIM_NOR_CONFIG_W25Q64() { \
+    .jedec_id = {0xEF, 0x40, 0x17}, \
+    .size = 8 * 1024 * 1024, \
+    .page_program_ns = 400000ULL, \
+    .sector_erase_ns = 45000000ULL, \
+    .block_erase_ns = 150000000ULL, \
+    .chip_erase_ns = 20000000000ULL, \
+}
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif // __PORT_SIM_MODEL_H__
@@ -0,0 +1,264 @@
+/**
+ * @file port_sim_nor.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief JEDEC spi nor flash 模型。
+ * @version 0.1
+ * @date 2024-07-22
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 支持的命令（3 字节地址）：
+ * - 0x9F RDID、0x05 RDSR（bit0 WIP，bit1 WEL）
+ * - 0x06 WREN、0x04 WRDI
+ * - 0x03 READ、0x0B FAST_READ（1 个空字节）
+ * - 0x02 PP：256 字节页内回绕，只能把 1 写成 0，片选无效时生效
+ * - 0x20 SE（4KB）、0xD8 BE（64KB）、0xC7 / 0x60 CE
+ * 编程与擦除需先 WREN，执行后 WEL 清零，WIP 在对应时间内置位，期间只响应 RDSR。
+ * 4 字节地址、QSPI 与 SFDP 不做模拟。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim_model.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define NOR_CMD_NONE        0x00
+#define NOR_CMD_RDID        0x9F
+#define NOR_CMD_RDSR        0x05
+#define NOR_CMD_WREN        0x06
+#define NOR_CMD_WRDI        0x04
+#define NOR_CMD_READ        0x03
+#define NOR_CMD_FAST_READ   0x0B
+#define NOR_CMD_PP          0x02
+#define NOR_CMD_SE          0x20
+#define NOR_CMD_BE          0xD8
+#define NOR_CMD_CE          0xC7
+#define NOR_CMD_CE_ALT      0x60
+
+#define NOR_SR_WIP          (0x1 << 0)
+#define NOR_SR_WEL          (0x1 << 1)
+
+#define NOR_ADDR_BYTES      3
+#define NOR_PAGE_SIZE       256
+#define NOR_SECTOR_SIZE     (4 * 1024)
+#define NOR_BLOCK_SIZE      (64 * 1024)
+
+/* ==================== [Typedefs] ========================================== */
+
+struct _port_sim_nor_t {
+    port_sim_spi_model_t model;     // 必须为第一个成员
+    port_sim_nor_config_t config;
+    uint8_t *data;
+    uint8_t page[NOR_PAGE_SIZE];    // 页编程缓存，未写入的位置为 0xFF
+    uint8_t cmd;
+    uint32_t pos;                   // 本帧已传输的字节数
+    uint32_t addr;
+    bool wel;
+    uint64_t busy_until;
+};
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void nor_select(port_sim_spi_model_t *model);
+static void nor_xfer(port_sim_spi_model_t *model, const uint8_t *tx, uint8_t *rx, size_t count);
+static void nor_deselect(port_sim_spi_model_t *model);
+static uint8_t nor_byte(port_sim_nor_t *nor, uint8_t in);
+static void nor_erase(port_sim_nor_t *nor, uint32_t size, uint64_t ns);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+port_sim_nor_t *port_sim_nor_create(const port_sim_nor_config_t *config)
+{
+    if (config == NULL || config->size == 0 || config->size > (1UL << (8 * NOR_ADDR_BYTES))) {
+        return NULL;
+    }
+
+    port_sim_nor_t *nor = (port_sim_nor_t *)calloc(1, sizeof(port_sim_nor_t));
+    if (nor == NULL) {
+        return NULL;
+    }
+
+    nor->data = (uint8_t *)malloc(config->size);
+    if (nor->data == NULL) {
+        free(nor);
+        return NULL;
+    }
+
+    memset(nor->data, 0xFF, config->size);
+    nor->config = *config;
+    nor->model.select = nor_select;
+    nor->model.xfer = nor_xfer;
+    nor->model.deselect = nor_deselect;
+
+    return nor;
+}
+
+void port_sim_nor_destroy(port_sim_nor_t *nor)
+{
+    if (nor == NULL) {
+        return;
+    }
+
+    free(nor->data);
+    free(nor);
+}
+
+port_sim_spi_model_t *port_sim_nor_model(port_sim_nor_t *nor)
+{
+    return &nor->model;
+}
+
+uint8_t *port_sim_nor_data(port_sim_nor_t *nor)
+{
+    return nor->data;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void nor_select(port_sim_spi_model_t *model)
+{
+    port_sim_nor_t *nor = (port_sim_nor_t *)model;
+
+    nor->cmd = NOR_CMD_NONE;
+    nor->pos = 0;
+    nor->addr = 0;
+}
+
+static void nor_xfer(port_sim_spi_model_t *model, const uint8_t *tx, uint8_t *rx, size_t count)
+{
+    port_sim_nor_t *nor = (port_sim_nor_t *)model;
+
+    // 只读时 MOSI 保持高电平
+    for (size_t i = 0; i < count; i++) {
+        uint8_t out = nor_byte(nor, (tx != NULL) ? tx[i] : 0xFF);
+        if (rx != NULL) {
+            rx[i] = out;
+        }
+    }
+}
+
+static void nor_deselect(port_sim_spi_model_t *model)
+{
+    port_sim_nor_t *nor = (port_sim_nor_t *)model;
+    uint32_t addr_end = 1 + NOR_ADDR_BYTES;
+
+    // 写类命令在片选无效时才执行，且必须按字节边界完整结束
+    switch (nor->cmd) {
+    case NOR_CMD_WREN:
+        nor->wel = true;
+        break;
+    case NOR_CMD_WRDI:
+        nor->wel = false;
+        break;
+    case NOR_CMD_PP:
+        if (nor->wel && nor->pos > addr_end) {
+            uint32_t base = nor->addr - nor->addr % NOR_PAGE_SIZE;
+            for (uint32_t i = 0; i < NOR_PAGE_SIZE; i++) {
+                nor->data[base + i] &= nor->page[i];
+            }
+            nor->wel = false;
+            nor->busy_until = port_sim_now() + nor->config.page_program_ns;
+        }
+        break;
+    case NOR_CMD_SE:
+        if (nor->wel && nor->pos == addr_end) {
+            nor_erase(nor, NOR_SECTOR_SIZE, nor->config.sector_erase_ns);
+        }
+        break;
+    case NOR_CMD_BE:
+        if (nor->wel && nor->pos == addr_end) {
+            nor_erase(nor, NOR_BLOCK_SIZE, nor->config.block_erase_ns);
+        }
+        break;
+    case NOR_CMD_CE:
+    case NOR_CMD_CE_ALT:
+        if (nor->wel && nor->pos == 1) {
+            nor->addr = 0;
+            nor_erase(nor, nor->config.size, nor->config.chip_erase_ns);
+        }
+        break;
+    default:
+        break;
+    }
+
+    nor->cmd = NOR_CMD_NONE;
+}
+
+static uint8_t nor_byte(port_sim_nor_t *nor, uint8_t in)
+{
+    uint32_t pos = nor->pos++;
+    uint8_t out = 0xFF;
+
+    if (pos == 0) {
+        // 忙时只响应读状态寄存器
+        nor->cmd = (port_sim_now() < nor->busy_until && in != NOR_CMD_RDSR) ? NOR_CMD_NONE : in;
+        if (nor->cmd == NOR_CMD_PP) {
+            memset(nor->page, 0xFF, NOR_PAGE_SIZE);
+        }
+        return out;
+    }
+
+    switch (nor->cmd) {
+    case NOR_CMD_RDID:
+        out = (pos <= sizeof(nor->config.jedec_id)) ? nor->config.jedec_id[pos - 1] : 0xFF;
+        return out;
+    case NOR_CMD_RDSR:
+        out = ((port_sim_now() < nor->busy_until) ? NOR_SR_WIP : 0) | (nor->wel ? NOR_SR_WEL : 0);
+        return out;
+    case NOR_CMD_READ:
+    case NOR_CMD_FAST_READ:
+    case NOR_CMD_PP:
+    case NOR_CMD_SE:
+    case NOR_CMD_BE:
+        break;
+    default:
+        return out;
+    }
+
+    if (pos <= NOR_ADDR_BYTES) {
+        nor->addr = ((nor->addr << 8) | in);
+        if (pos == NOR_ADDR_BYTES) {
+            nor->addr %= nor->config.size;
+        }
+        return out;
+    }
+
+    uint32_t data_pos = pos - NOR_ADDR_BYTES - 1;
+
+    switch (nor->cmd) {
+    case NOR_CMD_FAST_READ:
+        if (data_pos == 0) {
+            break;
+        }
+    // fall through
+    case NOR_CMD_READ:
+        out = nor->data[nor->addr];
+        nor->addr = (nor->addr + 1) % nor->config.size;
+        break;
+    case NOR_CMD_PP:
+        // 页内回绕，同一位置多次写入以最后一次为准
+        nor->page[(nor->addr + data_pos) % NOR_PAGE_SIZE] = in;
+        break;
+    default:
+        break;
+    }
+
+    return out;
+}
+
+static void nor_erase(port_sim_nor_t *nor, uint32_t size, uint64_t ns)
+{
+    uint32_t base = nor->addr - nor->addr % size;
+
+    memset(nor->data + base, 0xFF, size);
+    nor->wel = false;
+    nor->busy_until = port_sim_now() + ns;
+}
@@ -0,0 +1,313 @@
+/**
+ * @file port_sim_uart_link.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief uart 链路模型：自环、两个 uart 互连与主机伪终端。
+ * @version 0.1
+ * @date 2024-07-22
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 每个端点有一个接收 FIFO，记录每个字节及其到达时刻，对端发送时按帧时间排入。
+ * FIFO 满时丢弃新数据并计入溢出次数。
+ * 伪终端端点由后台线程读取主机侧写入的数据，到达时刻为读到时的虚拟时间；
+ * 发送的数据直接写入伪终端，不等待虚拟时间。伪终端只在 POSIX 主机上可用；
+ * 启用 xf_hal 的 posix 层时，其全局 open / read / write / poll 会替换 libc 的同名函数，伪终端不可用。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#define _GNU_SOURCE
+
+#include "xf_hal_port.h"
+#include "port_sim_model.h"
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define UART_LINK_PTY_IS_ENABLE (!XF_HAL_POSIX_IS_ENABLE)
+#define UART_LINK_PTY_POLL_MS   50
+
+#if UART_LINK_PTY_IS_ENABLE
+#include <fcntl.h>
+#include <poll.h>
+#include <termios.h>
+#include <unistd.h>
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+struct _port_sim_uart_link_t {
+    port_sim_uart_model_t model;    // 必须为第一个成员
+    port_sim_uart_link_t *peer;     // 发送的数据到达的端点，伪终端端点为 NULL
+    pthread_mutex_t mutex;          // 保护接收 FIFO，伪终端读线程与虚拟时钟线程会同时访问
+    uint8_t data[PORT_SIM_UART_FIFO_SIZE];
+    uint64_t at[PORT_SIM_UART_FIFO_SIZE];
+    size_t head;
+    size_t count;
+    uint32_t overrun;
+
+    int pty_master;
+    int pty_slave;                  // 保持打开，主机侧程序未连接时读主设备不会返回错误
+    pthread_t pty_thread;
+    volatile bool pty_running;
+};
+
+/* ==================== [Static Prototypes] ================================= */
+
+static port_sim_uart_link_t *link_alloc(void);
+static void link_tx(port_sim_uart_model_t *model, const uint8_t *buf, size_t count, uint64_t start,
+                    uint64_t frame_ns);
+static size_t link_rx(port_sim_uart_model_t *model, uint8_t *buf, size_t count, uint64_t now, uint64_t *next);
+static uint64_t link_rx_ready(port_sim_uart_model_t *model, size_t count);
+static void link_push(port_sim_uart_link_t *link, const uint8_t *buf, size_t count, uint64_t start,
+                      uint64_t frame_ns);
+#if UART_LINK_PTY_IS_ENABLE
+static void *link_pty_thread(void *arg);
+#endif
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+port_sim_uart_link_t *port_sim_uart_loopback_create(void)
+{
+    port_sim_uart_link_t *link = link_alloc();
+    if (link != NULL) {
+        link->peer = link;
+    }
+
+    return link;
+}
+
+int port_sim_uart_pair_create(port_sim_uart_link_t **a, port_sim_uart_link_t **b)
+{
+    *a = link_alloc();
+    *b = link_alloc();
+    if (*a == NULL || *b == NULL) {
+        port_sim_uart_link_destroy(*a);
+        port_sim_uart_link_destroy(*b);
+        *a = NULL;
+        *b = NULL;
+        return XF_ERR_NO_MEM;
+    }
+
+    (*a)->peer = *b;
+    (*b)->peer = *a;
+
+    return XF_OK;
+}
+
+port_sim_uart_link_t *port_sim_uart_pty_create(char *path, size_t path_size)
+{
+#if !UART_LINK_PTY_IS_ENABLE
+    UNUSED(path);
+    UNUSED(path_size);
+    return NULL;
+#else
+    port_sim_uart_link_t *link = link_alloc();
+    if (link == NULL) {
+        return NULL;
+    }
+
+    link->pty_master = posix_openpt(O_RDWR | O_NOCTTY);
+    if (link->pty_master < 0 || grantpt(link->pty_master) != 0 || unlockpt(link->pty_master) != 0) {
+        port_sim_uart_link_destroy(link);
+        return NULL;
+    }
+
+    const char *name = ptsname(link->pty_master);
+    if (name == NULL || (link->pty_slave = open(name, O_RDWR | O_NOCTTY)) < 0) {
+        port_sim_uart_link_destroy(link);
+        return NULL;
+    }
+
+    // 原始模式，不做行缓冲、回显与换行转换
+    struct termios tio;
+    if (tcgetattr(link->pty_slave, &tio) == 0) {
+        cfmakeraw(&tio);
+        tcsetattr(link->pty_slave, TCSANOW, &tio);
+    }
+
+    if (path != NULL && path_size > 0) {
+        strncpy(path, name, path_size - 1);
+        path[path_size - 1] = '\0';
+    }
+
+    link->pty_running = true;
+    if (pthread_create(&link->pty_thread, NULL, link_pty_thread, link) != 0) {
+        link->pty_running = false;
+        port_sim_uart_link_destroy(link);
+        return NULL;
+    }
+
+    return link;
+#endif
+}
+
+void port_sim_uart_link_destroy(port_sim_uart_link_t *link)
+{
+    if (link == NULL) {
+        return;
+    }
+
+#if UART_LINK_PTY_IS_ENABLE
+    if (link->pty_running) {
+        link->pty_running = false;
+        pthread_join(link->pty_thread, NULL);
+    }
+    if (link->pty_slave >= 0) {
+        close(link->pty_slave);
+    }
+    if (link->pty_master >= 0) {
+        close(link->pty_master);
+    }
+#endif
+
+    if (link->peer != NULL && link->peer != link) {
+        link->peer->peer = NULL;
+    }
+
+    pthread_mutex_destroy(&link->mutex);
+    free(link);
+}
+
+port_sim_uart_model_t *port_sim_uart_link_model(port_sim_uart_link_t *link)
+{
+    return &link->model;
+}
+
+uint32_t port_sim_uart_link_overrun(port_sim_uart_link_t *link)
+{
+    pthread_mutex_lock(&link->mutex);
+    uint32_t overrun = link->overrun;
+    pthread_mutex_unlock(&link->mutex);
+
+    return overrun;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static port_sim_uart_link_t *link_alloc(void)
+{
+    port_sim_uart_link_t *link = (port_sim_uart_link_t *)calloc(1, sizeof(port_sim_uart_link_t));
+    if (link == NULL) {
+        return NULL;
+    }
+
+    pthread_mutex_init(&link->mutex, NULL);
+    link->pty_master = -1;
+    link->pty_slave = -1;
+    link->model.tx = link_tx;
+    link->model.rx = link_rx;
+    link->model.rx_ready = link_rx_ready;
+
+    return link;
+}
+
+static void link_tx(port_sim_uart_model_t *model, const uint8_t *buf, size_t count, uint64_t start,
+                    uint64_t frame_ns)
+{
+    port_sim_uart_link_t *link = (port_sim_uart_link_t *)model;
+
+#if UART_LINK_PTY_IS_ENABLE
+    if (link->pty_master >= 0) {
+        while (count > 0) {
+            ssize_t n = write(link->pty_master, buf, count);
+            if (n <= 0) {
+                break;
+            }
+            buf += n;
+            count -= n;
+        }
+        return;
+    }
+#endif
+
+    // 对端断开时数据丢失在线上
+    if (link->peer != NULL) {
+        link_push(link->peer, buf, count, start, frame_ns);
+    }
+}
+
+static size_t link_rx(port_sim_uart_model_t *model, uint8_t *buf, size_t count, uint64_t now, uint64_t *next)
+{
+    port_sim_uart_link_t *link = (port_sim_uart_link_t *)model;
+    size_t n = 0;
+
+    pthread_mutex_lock(&link->mutex);
+
+    while (n < count && link->count > 0 && link->at[link->head] <= now) {
+        buf[n++] = link->data[link->head];
+        link->head = (link->head + 1) % PORT_SIM_UART_FIFO_SIZE;
+        link->count--;
+    }
+    *next = (link->count > 0) ? link->at[link->head] : UINT64_MAX;
+
+    pthread_mutex_unlock(&link->mutex);
+
+    return n;
+}
+
+static uint64_t link_rx_ready(port_sim_uart_model_t *model, size_t count)
+{
+    port_sim_uart_link_t *link = (port_sim_uart_link_t *)model;
+    uint64_t ready = UINT64_MAX;
+
+    pthread_mutex_lock(&link->mutex);
+    if (count > 0 && link->count >= count) {
+        ready = link->at[(link->head + count - 1) % PORT_SIM_UART_FIFO_SIZE];
+    }
+    pthread_mutex_unlock(&link->mutex);
+
+    return ready;
+}
+
+static void link_push(port_sim_uart_link_t *link, const uint8_t *buf, size_t count, uint64_t start,
+                      uint64_t frame_ns)
+{
+    pthread_mutex_lock(&link->mutex);
+
+    for (size_t i = 0; i < count; i++) {
+        if (link->count == PORT_SIM_UART_FIFO_SIZE) {
+            link->overrun++;
+            continue;
+        }
+        size_t tail = (link->head + link->count) % PORT_SIM_UART_FIFO_SIZE;
+        link->data[tail] = buf[i];
+        link->at[tail] = start + (i + 1) * frame_ns;
+        link->count++;
+    }
+
+    pthread_mutex_unlock(&link->mutex);
+
+    if (link->model.rx_notify != NULL) {
+        link->model.rx_notify(link->model.rx_notify_arg);
+    }
+}
+
+#if UART_LINK_PTY_IS_ENABLE
+static void *link_pty_thread(void *arg)
+{
+    port_sim_uart_link_t *link = (port_sim_uart_link_t *)arg;
+    struct pollfd pfd = {.fd = link->pty_master, .events = POLLIN};
+    uint8_t buf[256];
+
+    // 定时醒来检查退出标志，关闭描述符不能可靠地打断阻塞中的 read
+    while (link->pty_running) {
+        if (poll(&pfd, 1, UART_LINK_PTY_POLL_MS) <= 0 || !(pfd.revents & POLLIN)) {
+            continue;
+        }
+
+        ssize_t n = read(link->pty_master, buf, sizeof(buf));
+        if (n > 0) {
+            link_push(link, buf, n, port_sim_now(), 0);
+        }
+    }
+
+    return NULL;
+}
+#endif
@@ -0,0 +1,339 @@
+/**
+ * @file port_spi.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief spi 仿真对接，按时钟频率与数据位宽计算线上时间。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 传输按字（8/16/32 bit）进行，不足一个字的部分按整字计时。
+ * 挂载了模型（port_sim_spi_attach）时，数据在传输结束时刻交给模型：
+ * 硬件片选下每次读写（writev 为整个向量）为一帧；软件片选下由 gpio 电平决定帧边界。
+ * 未挂载模型，读取到的数据均为 0xFF（MISO 空闲电平）。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_SPI_DEFAULT_HOSTS            XF_HAL_SPI_HOSTS_MASTER
+#define XF_HAL_SPI_DEFAULT_BIT_ORDER        XF_HAL_SPI_BIT_ORDER_MSB_FIRST
+#define XF_HAL_SPI_DEFAULT_MODE             XF_HAL_SPI_MODE_0
+#define XF_HAL_SPI_DEFAULT_DATA_WIDTH       XF_HAL_SPI_DATA_WIDTH_8_BITS
+#define XF_HAL_SPI_DEFAULT_TIMEOUT          1000
+#define XF_HAL_SPI_DEFAULT_SPEED            1000*1000*10
+#define XF_HAL_SPI_DEFAULT_SCLK_NUM         1
+#define XF_HAL_SPI_DEFAULT_CS_NUM           2
+#define XF_HAL_SPI_DEFAULT_MOSI_NUM         3
+#define XF_HAL_SPI_DEFAULT_MISO_NUM         4
+#define XF_HAL_SPI_DEFAULT_QUADWP_NUM       XF_HAL_GPIO_NUM_NONE
+#define XF_HAL_SPI_DEFAULT_QUADHD_NUM       XF_HAL_GPIO_NUM_NONE
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_spi_t {
+    xf_hal_dev_t *dev;
+    port_sim_bus_t bus;
+    uint32_t speed;
+    uint32_t word_bits;
+    port_sim_event_t done;
+    xf_hal_req_t *req;
+} port_spi_t;
+
+typedef struct _port_spi_slave_t {
+    uint32_t spi_num;
+    uint32_t cs_pin;
+    port_sim_spi_model_t *model;
+    bool selected;
+} port_spi_slave_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_spi_open(xf_hal_dev_t *dev);
+static int port_spi_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_spi_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_spi_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_spi_close(xf_hal_dev_t *dev);
+static int port_spi_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
+static xf_err_t port_spi_submit(xf_hal_dev_t *dev, xf_hal_req_t *req);
+static xf_err_t port_spi_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req);
+
+// 线上时序模型
+static uint64_t _spi_wire_ns(port_spi_t *spi, size_t count);
+static void _spi_done(void *arg);
+
+// 从机模型
+static port_spi_slave_t *_spi_slave_find(uint32_t spi_num);
+static void _spi_model_xfer(port_spi_t *spi, const uint8_t *tx, uint8_t *rx, size_t count);
+static void _spi_model_writev(port_spi_t *spi, const xf_hal_iovec_t *iov, size_t iovcnt);
+static void _spi_cs_changed(void *arg, uint32_t pin, bool level);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_spi_pool, sizeof(port_spi_t), XF_HAL_SPI_POOL_SIZE);
+
+static port_spi_slave_t s_spi_slaves[PORT_SIM_MODEL_MAX] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_SPI_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_spi_open,
+        .ioctl = port_spi_ioctl,
+        .write = port_spi_write,
+        .read = port_spi_read,
+        .close = port_spi_close,
+        .writev = port_spi_writev,
+        .submit = port_spi_submit,
+        .cancel = port_spi_cancel,
+    };
+    xf_hal_pool_init(&s_port_spi_pool);
+    xf_hal_spi_register(&ops);
+}
+
+int port_sim_spi_attach(uint32_t spi_num, uint32_t cs_pin, port_sim_spi_model_t *model)
+{
+    port_spi_slave_t *slave = _spi_slave_find(spi_num);
+
+    // 每个 spi 只挂载一个从机，重复挂载时替换
+    if (slave != NULL) {
+        if (slave->cs_pin != PORT_SIM_PIN_NONE) {
+            port_sim_pin_unwatch(slave->cs_pin, _spi_cs_changed, slave);
+        }
+        slave->model = NULL;
+    }
+
+    if (model == NULL) {
+        return XF_OK;
+    }
+
+    for (size_t i = 0; slave == NULL && i < PORT_SIM_MODEL_MAX; i++) {
+        if (s_spi_slaves[i].model == NULL) {
+            slave = &s_spi_slaves[i];
+        }
+    }
+    if (slave == NULL) {
+        return XF_ERR_RESOURCE;
+    }
+
+    slave->spi_num = spi_num;
+    slave->cs_pin = cs_pin;
+    slave->selected = false;
+    slave->model = model;
+
+    if (cs_pin != PORT_SIM_PIN_NONE && port_sim_pin_watch(cs_pin, _spi_cs_changed, slave) != XF_OK) {
+        slave->model = NULL;
+        return XF_ERR_RESOURCE;
+    }
+
+    return XF_OK;
+}
+
+XF_HAL_PORT_EXPORT(SPI, port_spi_ioctl, port_spi_read, port_spi_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_spi_open(xf_hal_dev_t *dev)
+{
+    port_spi_t *spi = (port_spi_t *)xf_hal_pool_alloc(&s_port_spi_pool);
+    if (spi == NULL) {
+        return -1;
+    }
+
+    memset(spi, 0, sizeof(port_spi_t));
+    spi->dev = dev;
+    port_sim_bus_open(&spi->bus, XF_HAL_SPI, "spi", dev->id);
+
+    dev->platform_data = spi;
+
+    return 0;
+}
+
+static int port_spi_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_spi_config_t *spi_config = (xf_hal_spi_config_t *)config;
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_SPI_CMD_DEFAULT) {
+        spi_config->hosts = XF_HAL_SPI_DEFAULT_HOSTS;
+        spi_config->bit_order = XF_HAL_SPI_DEFAULT_BIT_ORDER;
+        spi_config->mode =  XF_HAL_SPI_DEFAULT_MODE;
+        spi_config->data_width = XF_HAL_SPI_DEFAULT_DATA_WIDTH;
+        spi_config->timeout_ms = XF_HAL_SPI_DEFAULT_TIMEOUT;
+        spi_config->speed = XF_HAL_SPI_DEFAULT_SPEED;
+        spi_config->gpio.sclk_num = XF_HAL_SPI_DEFAULT_SCLK_NUM;
+        spi_config->gpio.cs_num = XF_HAL_SPI_DEFAULT_CS_NUM;
+        spi_config->gpio.mosi_num = XF_HAL_SPI_DEFAULT_MOSI_NUM;
+        spi_config->gpio.miso_num = XF_HAL_SPI_DEFAULT_MISO_NUM;
+        spi_config->gpio.quadwp_num = XF_HAL_SPI_DEFAULT_QUADWP_NUM;
+        spi_config->gpio.quadhd_num = XF_HAL_SPI_DEFAULT_QUADHD_NUM;
+        cmd = XF_HAL_SPI_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_SPI_CMD_SPEED) {
+        spi->speed = spi_config->speed;
+    }
+
+    if (cmd & XF_HAL_SPI_CMD_DATA_WIDTH) {
+        spi->word_bits = 8u << spi_config->data_width;
+    }
+
+    return 0;
+}
+
+static int port_spi_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+    port_sim_bus_xfer(&spi->bus, _spi_wire_ns(spi, count), count);
+    memset(buf, 0xFF, count);
+    _spi_model_xfer(spi, NULL, buf, count);
+    return count;
+}
+
+static int port_spi_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+    port_sim_bus_xfer(&spi->bus, _spi_wire_ns(spi, count), count);
+    _spi_model_xfer(spi, buf, NULL, count);
+    return count;
+}
+
+static int port_spi_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+    uint64_t wire_ns = 0;
+    size_t total = 0;
+
+    // 整个过程保持片选有效，各段按自身长度补齐整字，只计一次固定开销
+    for (size_t i = 0; i < iovcnt; i++) {
+        wire_ns += _spi_wire_ns(spi, iov[i].count);
+        total += iov[i].count;
+    }
+    port_sim_bus_xfer(&spi->bus, wire_ns, total);
+    _spi_model_writev(spi, iov, iovcnt);
+
+    return total;
+}
+
+static xf_err_t port_spi_submit(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+
+    spi->req = req;
+    port_sim_schedule(&spi->done, port_sim_bus_claim(&spi->bus, _spi_wire_ns(spi, req->count), req->count),
+                      _spi_done, spi);
+
+    return XF_OK;
+}
+
+static xf_err_t port_spi_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+    port_sim_cancel(&spi->done);
+    return XF_OK;
+}
+
+static int port_spi_close(xf_hal_dev_t *dev)
+{
+    port_spi_t *spi = (port_spi_t *)dev->platform_data;
+    port_sim_cancel(&spi->done);
+    port_sim_bus_close(&spi->bus);
+    xf_hal_pool_free(&s_port_spi_pool, spi);
+    return 0;
+}
+
+static uint64_t _spi_wire_ns(port_spi_t *spi, size_t count)
+{
+    uint64_t words = ((uint64_t)count * 8 + spi->word_bits - 1) / spi->word_bits;
+    return port_sim_bits_to_ns(words * spi->word_bits, spi->speed);
+}
+
+static void _spi_done(void *arg)
+{
+    port_spi_t *spi = (port_spi_t *)arg;
+    xf_hal_req_t *req = spi->req;
+
+    if (req->dir == XF_HAL_REQ_DIR_READ) {
+        memset(req->buf, 0xFF, req->count);
+        _spi_model_xfer(spi, NULL, req->buf, req->count);
+    } else {
+        _spi_model_xfer(spi, req->buf, NULL, req->count);
+    }
+
+    spi->req = NULL;
+    xf_hal_driver_complete(spi->dev, req, req->count);
+}
+
+static port_spi_slave_t *_spi_slave_find(uint32_t spi_num)
+{
+    for (size_t i = 0; i < PORT_SIM_MODEL_MAX; i++) {
+        if (s_spi_slaves[i].model != NULL && s_spi_slaves[i].spi_num == spi_num) {
+            return &s_spi_slaves[i];
+        }
+    }
+
+    return NULL;
+}
+
+static void _spi_model_xfer(port_spi_t *spi, const uint8_t *tx, uint8_t *rx, size_t count)
+{
+    port_spi_slave_t *slave = _spi_slave_find(spi->dev->id);
+
+    if (slave == NULL) {
+        return;
+    }
+
+    if (slave->cs_pin == PORT_SIM_PIN_NONE) {
+        slave->model->select(slave->model);
+        slave->model->xfer(slave->model, tx, rx, count);
+        slave->model->deselect(slave->model);
+    } else if (slave->selected) {
+        // 软件片选无效时从机不响应，MISO 保持空闲电平
+        slave->model->xfer(slave->model, tx, rx, count);
+    }
+}
+
+static void _spi_model_writev(port_spi_t *spi, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_spi_slave_t *slave = _spi_slave_find(spi->dev->id);
+
+    if (slave == NULL || (slave->cs_pin != PORT_SIM_PIN_NONE && !slave->selected)) {
+        return;
+    }
+
+    if (slave->cs_pin == PORT_SIM_PIN_NONE) {
+        slave->model->select(slave->model);
+    }
+    for (size_t i = 0; i < iovcnt; i++) {
+        slave->model->xfer(slave->model, (const uint8_t *)iov[i].buf, NULL, iov[i].count);
+    }
+    if (slave->cs_pin == PORT_SIM_PIN_NONE) {
+        slave->model->deselect(slave->model);
+    }
+}
+
+static void _spi_cs_changed(void *arg, uint32_t pin, bool level)
+{
+    port_spi_slave_t *slave = (port_spi_slave_t *)arg;
+
+    // 片选低有效
+    if (!level && !slave->selected) {
+        slave->selected = true;
+        slave->model->select(slave->model);
+    } else if (level && slave->selected) {
+        slave->selected = false;
+        slave->model->deselect(slave->model);
+    }
+}
@@ -0,0 +1,217 @@
+/**
+ * @file port_tim.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief 定时器仿真对接，计数值由虚拟时钟换算，到达目标计数时在虚拟时钟上触发回调。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 只模拟向上计数。回调在推进虚拟时钟的线程中执行（见 port_sim_run_until）。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_TIM_DEFAULT_TICK_FREQ_HZ 1000*1000
+#define XF_HAL_TIM_DEFAULT_COUNT_DIR    XF_HAL_TIM_COUNT_DIR_UP
+#define XF_HAL_TIM_DEFAULT_ACTIVE       false
+#define XF_HAL_TIM_DEFAULT_AUTO_RELOAD  true
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_tim_t {
+    xf_hal_dev_t *dev;
+    uint32_t id;
+    bool active;
+    bool auto_reload;
+    uint32_t tick_freq_hz;
+    uint32_t target_ticks;
+    uint32_t base_ticks;            // start 时刻的计数值
+    uint64_t start;                 // 开始计数的虚拟时刻
+    xf_hal_tim_callback_t cb;
+    xf_hal_tim_callback_t isr;
+    port_sim_event_t alarm;
+} port_tim_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_tim_open(xf_hal_dev_t *dev);
+static int port_tim_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_tim_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_tim_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_tim_close(xf_hal_dev_t *dev);
+
+// 虚拟时钟上的计数模型
+static uint32_t _tim_ticks(port_tim_t *tim, uint64_t now);
+static void _tim_restart(port_tim_t *tim, uint32_t ticks);
+static void _tim_alarm(void *arg);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_tim_pool, sizeof(port_tim_t), XF_HAL_TIM_POOL_SIZE);
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_TIM_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_tim_open,
+        .ioctl = port_tim_ioctl,
+        .write = port_tim_write,
+        .read = port_tim_read,
+        .close = port_tim_close,
+    };
+    xf_hal_pool_init(&s_port_tim_pool);
+    xf_hal_tim_register(&ops);
+}
+
+XF_HAL_PORT_EXPORT(TIM, port_tim_ioctl, port_tim_read, port_tim_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_tim_open(xf_hal_dev_t *dev)
+{
+    port_tim_t *tim = (port_tim_t *)xf_hal_pool_alloc(&s_port_tim_pool);
+    if (tim == NULL) {
+        return -1;
+    }
+
+    memset(tim, 0, sizeof(port_tim_t));
+    tim->dev = dev;
+    tim->id = dev->id;
+
+    // 可读表示计数到达目标值后尚未读取
+    xf_hal_driver_poll_clear(dev, XF_HAL_POLLIN);
+
+    dev->platform_data = tim;
+
+    return 0;
+}
+
+static int port_tim_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_tim_config_t *tim_config = (xf_hal_tim_config_t *)config;
+    port_tim_t *tim = (port_tim_t *)dev->platform_data;
+    uint32_t ticks = _tim_ticks(tim, port_sim_now());
+
+    if (cmd == XF_HAL_TIM_CMD_DEFAULT) {
+        tim_config->tick_freq_hz    = XF_HAL_TIM_DEFAULT_TICK_FREQ_HZ;
+        tim_config->count_dir       = XF_HAL_TIM_DEFAULT_COUNT_DIR;
+        tim_config->active          = XF_HAL_TIM_DEFAULT_ACTIVE;
+        tim_config->auto_reload     = XF_HAL_TIM_DEFAULT_AUTO_RELOAD;
+        cmd = XF_HAL_TIM_CMD_ALL;
+    }
+
+    if (cmd & XF_HAL_TIM_CMD_TICK_FREQ_HZ) {
+        tim->tick_freq_hz = tim_config->tick_freq_hz;
+    }
+
+    if (cmd & XF_HAL_TIM_CMD_AUTO_RELOAD) {
+        tim->auto_reload = tim_config->auto_reload;
+    }
+
+    if (cmd & XF_HAL_TIM_CMD_TARGET_TICKS) {
+        tim->target_ticks = tim_config->target_ticks;
+    }
+
+    if (cmd & XF_HAL_TIM_CMD_CB) {
+        tim->cb = tim_config->cb;
+    }
+
+    if (cmd & XF_HAL_TIM_CMD_ISR) {
+        tim->isr = tim_config->isr;
+    }
+
+    if (cmd & XF_HAL_TIM_CMD_ACTIVE) {
+        tim->active = tim_config->active;
+    }
+
+    // 频率、目标或启停变化后从当前计数值重新计时
+    _tim_restart(tim, ticks);
+
+    return 0;
+}
+
+static int port_tim_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_tim_t *tim = (port_tim_t *)dev->platform_data;
+    *(uint32_t *)buf = _tim_ticks(tim, port_sim_now());
+    xf_hal_driver_poll_clear(dev, XF_HAL_POLLIN);
+    return 0;
+}
+
+static int port_tim_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_tim_t *tim = (port_tim_t *)dev->platform_data;
+    _tim_restart(tim, *(const uint32_t *)buf);
+    return 0;
+}
+
+static int port_tim_close(xf_hal_dev_t *dev)
+{
+    port_tim_t *tim = (port_tim_t *)dev->platform_data;
+    port_sim_cancel(&tim->alarm);
+    xf_hal_pool_free(&s_port_tim_pool, tim);
+    return 0;
+}
+
+static uint32_t _tim_ticks(port_tim_t *tim, uint64_t now)
+{
+    if (!tim->active || now <= tim->start) {
+        return tim->base_ticks;
+    }
+
+    return tim->base_ticks + (uint32_t)((now - tim->start) * tim->tick_freq_hz / PORT_SIM_NS_PER_SEC);
+}
+
+static void _tim_restart(port_tim_t *tim, uint32_t ticks)
+{
+    tim->base_ticks = ticks;
+    tim->start = port_sim_now();
+
+    if (!tim->active || tim->tick_freq_hz == 0 || tim->target_ticks <= ticks) {
+        port_sim_cancel(&tim->alarm);
+        return;
+    }
+
+    port_sim_schedule(&tim->alarm,
+                      tim->start + port_sim_bits_to_ns(tim->target_ticks - ticks, tim->tick_freq_hz),
+                      _tim_alarm, tim);
+}
+
+static void _tim_alarm(void *arg)
+{
+    port_tim_t *tim = (port_tim_t *)arg;
+    uint32_t ticks = tim->target_ticks;
+
+    // 以到期时刻为基准重装载，避免回调耗时累积误差
+    tim->base_ticks = ticks;
+    tim->start = tim->alarm.due;
+    if (tim->auto_reload) {
+        tim->base_ticks = 0;
+        port_sim_schedule(&tim->alarm, tim->start + port_sim_bits_to_ns(ticks, tim->tick_freq_hz),
+                          _tim_alarm, tim);
+    }
+
+    xf_hal_driver_poll_set(tim->dev, XF_HAL_POLLIN);
+
+    if (tim->isr.callback) {
+        tim->isr.callback(tim->id, ticks, tim->isr.user_data);
+    }
+
+    if (tim->cb.callback) {
+        tim->cb.callback(tim->id, ticks, tim->cb.user_data);
+    }
+}
@@ -0,0 +1,545 @@
+/**
+ * @file port_uart.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief uart 仿真对接，按波特率与帧格式计算线上时间。
+ * @version 0.1
+ * @date 2024-07-20
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details tx 与 rx 是两条独立的总线（全双工）。
+ * 未连接对端时，接收端假定对端以线速连续发送，读取 count 字节即占用 count 帧的时间，数据为递增序列。
+ * 连接了对端模型（port_sim_uart_attach）时，发送的数据连同每个字节离开线路的时刻交给模型；
+ * 读取只取已到达的数据，对端仍在发送时等待到最后一个字节到达，异步读取在凑满 count 字节时完成。
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_port.h"
+#include "port_sim_model.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_UART_DEFAULT_DATA_BITS       XF_HAL_UART_DATA_BIT_8
+#define XF_HAL_UART_DEFAULT_STOP_BITS       XF_HAL_UART_STOP_BIT_1
+#define XF_HAL_UART_DEFAULT_PARITY_BITS     XF_HAL_UART_PARITY_BITS_NONE
+#define XF_HAL_UART_DEFAULT_FLOW_CONTROL    XF_HAL_UART_FLOW_CONTROL_NONE
+#define XF_HAL_UART_DEFAULT_BAUDRATE        115200
+#define XF_HAL_UART_DEFAULT_TX_NUM          3
+#define XF_HAL_UART_DEFAULT_RX_NUM          4
+#define XF_HAL_UART_DEFAULT_RTS_NUM         XF_HAL_GPIO_NUM_NONE
+#define XF_HAL_UART_DEFAULT_CTS_NUM         XF_HAL_GPIO_NUM_NONE
+
+#define PORT_UART_TX_FIFO_SIZE              256     // 非阻塞写的发送缓冲大小
+#define PORT_UART_RX_FIFO_SIZE              16      // 接收 fifo 大小，设置接收缓冲区时达到该数量触发一次接收中断
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _port_uart_t {
+    xf_hal_dev_t *dev;
+    port_sim_bus_t tx;
+    port_sim_bus_t rx;
+    uint32_t baudrate;
+    uint32_t frame_half_bits;       // 一帧的半位数，支持 1.5 停止位
+    uint8_t data_bits;
+    uint8_t stop_bits;
+    uint8_t parity_bits;
+    uint8_t rx_seq;
+    port_sim_event_t done;
+    port_sim_event_t tx_space;      // 发送缓冲满后腾出一个字节的时刻
+    xf_hal_req_t *req;
+} port_uart_t;
+
+typedef struct _port_uart_link_t {
+    uint32_t uart_num;
+    port_sim_uart_model_t *model;
+    port_uart_t *uart;              // 对应的 uart 已打开时有效
+    port_sim_event_t wake;
+} port_uart_link_t;
+
+/* ==================== [Static Prototypes] ================================= */
+
+// 用户实现对接的部分
+static int port_uart_open(xf_hal_dev_t *dev);
+static int port_uart_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int port_uart_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_uart_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+static int port_uart_close(xf_hal_dev_t *dev);
+static int port_uart_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
+static xf_err_t port_uart_submit(xf_hal_dev_t *dev, xf_hal_req_t *req);
+static xf_err_t port_uart_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req);
+static int port_uart_read_nonblock(xf_hal_dev_t *dev, void *buf, size_t count);
+static int port_uart_write_nonblock(xf_hal_dev_t *dev, const void *buf, size_t count);
+
+// 线上时序模型
+static uint64_t _uart_wire_ns(port_uart_t *uart, size_t count);
+static void _uart_rx_fill(port_uart_t *uart, uint8_t *buf, size_t count);
+static void _uart_done(void *arg);
+static void _uart_tx_space(void *arg);
+
+// 对端模型
+static port_uart_link_t *_uart_link_get(uint32_t uart_num, bool create);
+static port_sim_uart_model_t *_uart_model(port_uart_t *uart);
+static void _uart_model_tx(port_uart_t *uart, const xf_hal_iovec_t *iov, size_t iovcnt, uint64_t start);
+static void _uart_rx_kick(port_uart_t *uart);
+static void _uart_rx_poll(port_uart_t *uart);
+static void _uart_rx_notify(void *arg);
+static void _uart_rx_wake(void *arg);
+static void _uart_rx_isr(port_uart_t *uart, port_sim_uart_model_t *model);
+
+/* ==================== [Static Variables] ================================== */
+
+// platform_data 与设备对象数量一致，同样使用静态对象池
+XF_HAL_POOL_DEFINE(s_port_uart_pool, sizeof(port_uart_t), XF_HAL_UART_POOL_SIZE);
+
+static port_uart_link_t s_uart_links[PORT_SIM_MODEL_MAX] = {0};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_UART_reg(void)
+{
+    xf_driver_ops_t ops = {
+        .open = port_uart_open,
+        .ioctl = port_uart_ioctl,
+        .write = port_uart_write,
+        .read = port_uart_read,
+        .close = port_uart_close,
+        .writev = port_uart_writev,
+        .submit = port_uart_submit,
+        .cancel = port_uart_cancel,
+        .read_nonblock = port_uart_read_nonblock,
+        .write_nonblock = port_uart_write_nonblock,
+    };
+    xf_hal_pool_init(&s_port_uart_pool);
+    xf_hal_uart_register(&ops);
+}
+
+int port_sim_uart_attach(uint32_t uart_num, port_sim_uart_model_t *model)
+{
+    port_uart_link_t *link = _uart_link_get(uart_num, model != NULL);
+
+    if (link == NULL) {
+        return (model == NULL) ? XF_OK : XF_ERR_RESOURCE;
+    }
+
+    if (model != NULL) {
+        model->rx_notify = _uart_rx_notify;
+        model->rx_notify_arg = link;
+    } else {
+        port_sim_cancel(&link->wake);
+    }
+    link->model = model;
+
+    if (link->uart != NULL) {
+        _uart_rx_poll(link->uart);
+    }
+
+    return XF_OK;
+}
+
+XF_HAL_PORT_EXPORT(UART, port_uart_ioctl, port_uart_read, port_uart_write)
+
+/* ==================== [Static Functions] ================================== */
+
+static int port_uart_open(xf_hal_dev_t *dev)
+{
+    port_uart_t *uart = (port_uart_t *)xf_hal_pool_alloc(&s_port_uart_pool);
+    if (uart == NULL) {
+        return -1;
+    }
+
+    port_uart_link_t *link = _uart_link_get(dev->id, true);
+    if (link == NULL) {
+        xf_hal_pool_free(&s_port_uart_pool, uart);
+        return -1;
+    }
+
+    memset(uart, 0, sizeof(port_uart_t));
+    uart->dev = dev;
+    link->uart = uart;
+    port_sim_bus_open(&uart->tx, XF_HAL_UART, "uartTX", dev->id);
+    port_sim_bus_open(&uart->rx, XF_HAL_UART, "uartRX", dev->id);
+    _uart_rx_poll(uart);
+
+    dev->platform_data = uart;
+
+    return 0;
+}
+
+static int port_uart_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    xf_hal_uart_config_t *uart_config = (xf_hal_uart_config_t *)config;
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+
+    if (cmd == XF_HAL_UART_CMD_DEFAULT) {
+        uart_config->data_bits = XF_HAL_UART_DEFAULT_DATA_BITS;
+        uart_config->stop_bits = XF_HAL_UART_DEFAULT_STOP_BITS;
+        uart_config->parity_bits = XF_HAL_UART_DEFAULT_PARITY_BITS;
+        uart_config->flow_control = XF_HAL_UART_DEFAULT_FLOW_CONTROL;
+        uart_config->baudrate = XF_HAL_UART_DEFAULT_BAUDRATE;
+        uart_config->tx_num = XF_HAL_UART_DEFAULT_TX_NUM;
+        uart_config->rx_num = XF_HAL_UART_DEFAULT_RX_NUM;
+        uart_config->rts_num = XF_HAL_UART_DEFAULT_RTS_NUM;
+        uart_config->cts_num = XF_HAL_UART_DEFAULT_CTS_NUM;
+        cmd = XF_HAL_UART_CMD_ALL;
+    }
+
+    // 只保存已下发的参数，与真实外设寄存器的行为一致
+    if (cmd & XF_HAL_UART_CMD_DATA_BITS) {
+        uart->data_bits = uart_config->data_bits;
+    }
+
+    if (cmd & XF_HAL_UART_CMD_STOP_BITS) {
+        uart->stop_bits = uart_config->stop_bits;
+    }
+
+    if (cmd & XF_HAL_UART_CMD_PARITY_BITS) {
+        uart->parity_bits = uart_config->parity_bits;
+    }
+
+    if (cmd & XF_HAL_UART_CMD_BAUDRATE) {
+        uart->baudrate = uart_config->baudrate;
+    }
+
+    // 起始位 + 数据位（5 ~ 9）+ 校验位 + 停止位（1、1.5、2）
+    uart->frame_half_bits = 2 * (1 + 5 + uart->data_bits
+                                 + (uart->parity_bits != XF_HAL_UART_PARITY_BITS_NONE))
+                            + 2 + uart->stop_bits;
+
+    return 0;
+}
+
+static int port_uart_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    port_sim_uart_model_t *model = _uart_model(uart);
+
+    if (model == NULL) {
+        port_sim_bus_xfer(&uart->rx, _uart_wire_ns(uart, count), count);
+        _uart_rx_fill(uart, buf, count);
+        return count;
+    }
+
+    // 数据到达时刻由对端决定，只等待已在线上的数据
+    size_t got = 0;
+    uint64_t next = 0;
+    while (got < count) {
+        got += model->rx(model, (uint8_t *)buf + got, count - got, port_sim_now(), &next);
+        if (got == count || next == UINT64_MAX) {
+            break;
+        }
+        port_sim_run_until(next);
+    }
+
+    _uart_rx_poll(uart);
+
+    return got;
+}
+
+static int port_uart_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    uint64_t wire_ns = _uart_wire_ns(uart, count);
+    uint64_t end = port_sim_bus_claim(&uart->tx, wire_ns, count);
+    xf_hal_iovec_t iov = {.buf = (void *)buf, .count = count};
+
+    _uart_model_tx(uart, &iov, 1, end - wire_ns);
+    port_sim_run_until(end);
+
+    return count;
+}
+
+static int port_uart_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    size_t total = 0;
+
+    // 各段数据连续发送，只计一次固定开销
+    for (size_t i = 0; i < iovcnt; i++) {
+        total += iov[i].count;
+    }
+
+    uint64_t wire_ns = _uart_wire_ns(uart, total);
+    uint64_t end = port_sim_bus_claim(&uart->tx, wire_ns, total);
+
+    _uart_model_tx(uart, iov, iovcnt, end - wire_ns);
+    port_sim_run_until(end);
+
+    return total;
+}
+
+static xf_err_t port_uart_submit(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    uint64_t wire_ns = _uart_wire_ns(uart, req->count);
+
+    uart->req = req;
+
+    if (req->dir == XF_HAL_REQ_DIR_WRITE) {
+        uint64_t end = port_sim_bus_claim(&uart->tx, wire_ns, req->count);
+        xf_hal_iovec_t iov = {.buf = req->buf, .count = req->count};
+        _uart_model_tx(uart, &iov, 1, end - wire_ns);
+        port_sim_schedule(&uart->done, end, _uart_done, uart);
+    } else if (_uart_model(uart) != NULL) {
+        // 数据不足时等对端模型排入新数据后再检查
+        _uart_rx_kick(uart);
+    } else {
+        port_sim_schedule(&uart->done, port_sim_bus_claim(&uart->rx, wire_ns, req->count), _uart_done, uart);
+    }
+
+    return XF_OK;
+}
+
+static xf_err_t port_uart_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    port_sim_cancel(&uart->done);
+    uart->req = NULL;
+    return XF_OK;
+}
+
+static int port_uart_read_nonblock(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    port_sim_uart_model_t *model = _uart_model(uart);
+
+    // 未连接对端时接收端总有数据，与阻塞读相同
+    if (model == NULL) {
+        return port_uart_read(dev, buf, count);
+    }
+
+    uint64_t next;
+    size_t got = model->rx(model, (uint8_t *)buf, count, port_sim_now(), &next);
+    _uart_rx_poll(uart);
+
+    return got;
+}
+
+static int port_uart_write_nonblock(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    uint64_t frame_ns = _uart_wire_ns(uart, 1);
+    uint64_t now = port_sim_now();
+    size_t pending = 0;
+
+    // 尚未离开线路的字节仍占用发送缓冲
+    if (frame_ns > 0 && uart->tx.busy_until > now) {
+        pending = (uart->tx.busy_until - now + frame_ns - 1) / frame_ns;
+    }
+
+    size_t space = (pending < PORT_UART_TX_FIFO_SIZE) ? PORT_UART_TX_FIFO_SIZE - pending : 0;
+    size_t n = (count < space) ? count : space;
+
+    if (n > 0) {
+        uint64_t wire_ns = _uart_wire_ns(uart, n);
+        uint64_t end = port_sim_bus_claim(&uart->tx, wire_ns, n);
+        xf_hal_iovec_t iov = {.buf = (void *)buf, .count = n};
+        _uart_model_tx(uart, &iov, 1, end - wire_ns);
+    }
+
+    if (n == space && frame_ns > 0) {
+        xf_hal_driver_poll_clear(dev, XF_HAL_POLLOUT);
+        port_sim_schedule(&uart->tx_space, uart->tx.busy_until - (PORT_UART_TX_FIFO_SIZE - 1) * frame_ns,
+                          _uart_tx_space, uart);
+    }
+
+    return n;
+}
+
+static int port_uart_close(xf_hal_dev_t *dev)
+{
+    port_uart_t *uart = (port_uart_t *)dev->platform_data;
+    port_uart_link_t *link = _uart_link_get(dev->id, false);
+    if (link != NULL) {
+        port_sim_cancel(&link->wake);
+        link->uart = NULL;
+    }
+
+    port_sim_cancel(&uart->done);
+    port_sim_cancel(&uart->tx_space);
+    port_sim_bus_close(&uart->tx);
+    port_sim_bus_close(&uart->rx);
+    xf_hal_pool_free(&s_port_uart_pool, uart);
+    return 0;
+}
+
+static uint64_t _uart_wire_ns(port_uart_t *uart, size_t count)
+{
+    return port_sim_bits_to_ns((uint64_t)count * uart->frame_half_bits, 2 * uart->baudrate);
+}
+
+static void _uart_rx_fill(port_uart_t *uart, uint8_t *buf, size_t count)
+{
+    for (size_t i = 0; i < count; i++) {
+        buf[i] = uart->rx_seq++;
+    }
+}
+
+static void _uart_done(void *arg)
+{
+    port_uart_t *uart = (port_uart_t *)arg;
+    xf_hal_req_t *req = uart->req;
+    port_sim_uart_model_t *model = _uart_model(uart);
+    int result = req->count;
+
+    if (req->dir == XF_HAL_REQ_DIR_READ) {
+        if (model != NULL) {
+            uint64_t next;
+            result = model->rx(model, req->buf, req->count, port_sim_now(), &next);
+            _uart_rx_poll(uart);
+        } else {
+            _uart_rx_fill(uart, req->buf, req->count);
+        }
+    }
+
+    uart->req = NULL;
+    xf_hal_driver_complete(uart->dev, req, result);
+}
+
+static void _uart_tx_space(void *arg)
+{
+    port_uart_t *uart = (port_uart_t *)arg;
+    xf_hal_driver_poll_set(uart->dev, XF_HAL_POLLOUT);
+}
+
+static port_uart_link_t *_uart_link_get(uint32_t uart_num, bool create)
+{
+    port_uart_link_t *empty = NULL;
+
+    // model 与 uart 都为空的表项视为空闲
+    for (size_t i = 0; i < PORT_SIM_MODEL_MAX; i++) {
+        port_uart_link_t *link = &s_uart_links[i];
+        if (link->model == NULL && link->uart == NULL) {
+            empty = (empty == NULL) ? link : empty;
+        } else if (link->uart_num == uart_num) {
+            return link;
+        }
+    }
+
+    if (!create || empty == NULL) {
+        return NULL;
+    }
+
+    empty->uart_num = uart_num;
+
+    return empty;
+}
+
+static port_sim_uart_model_t *_uart_model(port_uart_t *uart)
+{
+    port_uart_link_t *link = _uart_link_get(uart->dev->id, false);
+    return (link == NULL) ? NULL : link->model;
+}
+
+static void _uart_model_tx(port_uart_t *uart, const xf_hal_iovec_t *iov, size_t iovcnt, uint64_t start)
+{
+    port_sim_uart_model_t *model = _uart_model(uart);
+    uint64_t frame_ns = _uart_wire_ns(uart, 1);
+
+    if (model == NULL) {
+        return;
+    }
+
+    for (size_t i = 0; i < iovcnt; i++) {
+        model->tx(model, (const uint8_t *)iov[i].buf, iov[i].count, start, frame_ns);
+        start += iov[i].count * frame_ns;
+    }
+}
+
+static void _uart_rx_kick(port_uart_t *uart)
+{
+    xf_hal_req_t *req = uart->req;
+    port_sim_uart_model_t *model = _uart_model(uart);
+
+    if (req == NULL || req->dir != XF_HAL_REQ_DIR_READ || model == NULL) {
+        return;
+    }
+
+    uint64_t ready = model->rx_ready(model, req->count);
+    if (ready == UINT64_MAX) {
+        return;
+    }
+
+    uint64_t now = port_sim_now();
+    port_sim_schedule(&uart->done, (ready > now) ? ready : now, _uart_done, uart);
+}
+
+static void _uart_rx_notify(void *arg)
+{
+    port_uart_link_t *link = (port_uart_link_t *)arg;
+
+    // 可能在 pty 读线程中调用，转为虚拟时钟上的事件，由驱动虚拟时钟的线程处理
+    port_sim_schedule(&link->wake, port_sim_now(), _uart_rx_wake, link);
+}
+
+static void _uart_rx_wake(void *arg)
+{
+    port_uart_link_t *link = (port_uart_link_t *)arg;
+
+    if (link->uart != NULL) {
+        _uart_rx_kick(link->uart);
+        _uart_rx_poll(link->uart);
+    }
+}
+
+static void _uart_rx_poll(port_uart_t *uart)
+{
+    port_sim_uart_model_t *model = _uart_model(uart);
+
+    // 设置了接收缓冲区时由接收中断写入，kernel 负责上报可读
+    if (uart->dev->rx_ring != NULL) {
+        if (model != NULL) {
+            _uart_rx_isr(uart, model);
+        }
+        return;
+    }
+
+    // 未连接对端时读取总能得到数据
+    if (model == NULL) {
+        xf_hal_driver_poll_set(uart->dev, XF_HAL_POLLIN);
+        return;
+    }
+
+    uint64_t ready = model->rx_ready(model, 1);
+    if (ready <= port_sim_now()) {
+        xf_hal_driver_poll_set(uart->dev, XF_HAL_POLLIN);
+        return;
+    }
+
+    xf_hal_driver_poll_clear(uart->dev, XF_HAL_POLLIN);
+
+    // 在第一个字节到达时再检查；已有更早的唤醒时保留，新数据的通知不能被推迟
+    port_uart_link_t *link = _uart_link_get(uart->dev->id, false);
+    if (ready != UINT64_MAX && (!link->wake.pending || link->wake.due > ready)) {
+        port_sim_schedule(&link->wake, ready, _uart_rx_wake, link);
+    }
+}
+
+static void _uart_rx_isr(port_uart_t *uart, port_sim_uart_model_t *model)
+{
+    uint8_t fifo[PORT_UART_RX_FIFO_SIZE];
+    uint64_t next = UINT64_MAX;
+    size_t n;
+
+    // 模拟接收中断：把已到达的字节搬入 kernel 的接收缓冲区
+    do {
+        n = model->rx(model, fifo, sizeof(fifo), port_sim_now(), &next);
+        xf_hal_driver_rx_push(uart->dev, fifo, n);
+    } while (n == sizeof(fifo));
+
+    // fifo 达到阈值时触发下一次中断，不足阈值时在下一个字节到达时触发（代替接收超时中断）
+    uint64_t due = model->rx_ready(model, PORT_UART_RX_FIFO_SIZE);
+    if (due == UINT64_MAX) {
+        due = next;
+    }
+
+    port_uart_link_t *link = _uart_link_get(uart->dev->id, false);
+    if (due != UINT64_MAX && (!link->wake.pending || link->wake.due > due)) {
+        port_sim_schedule(&link->wake, due, _uart_rx_wake, link);
+    }
+}
@@ -0,0 +1,18 @@
+/**
+ * @file xf_hal_config.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief
+ * @version 0.1
+ * @date 2024-05-11
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_HAL_CONFIG_H__
+#define __XF_HAL_CONFIG_H__
+
+/* ==================== [Defines] ========================================== */
+
+
+#endif // __XF_HAL_CONFIG_H__
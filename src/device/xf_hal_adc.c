@@ -27,6 +27,9 @@
 typedef struct _xf_hal_adc_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_adc_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_adc_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_adc_t;
 
 /* ==================== [Static Prototypes] ================================= */
@@ -35,6 +38,16 @@ static xf_hal_dev_t *adc_constructor(xf_adc_num_t adc_num);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_adc_pool, sizeof(xf_hal_adc_t), XF_HAL_ADC_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_adc_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_ADC_CMD_ENABLE),
+    XF_HAL_CONFIG_BITS(XF_HAL_ADC_CMD_RESOLUTION),
+    XF_HAL_CONFIG_BITS(XF_HAL_ADC_CMD_SAMPLE_RATE),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_ADC_CHECK(condition, retval,  format, ...) \
@@ -44,7 +57,19 @@ static xf_hal_dev_t *adc_constructor(xf_adc_num_t adc_num);
 
 xf_err_t xf_hal_adc_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_ADC_TYPE, XF_HAL_FLAG_ONLY_READ, adc_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_ADC_TYPE, XF_HAL_FLAG_ONLY_READ, adc_constructor, driver_ops);
+    XF_HAL_ADC_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_adc_fields, XF_HAL_ADC_CMD_ENABLE, xf_hal_adc_config_t, enable);
+    XF_HAL_CONFIG_BITS_PROBE(s_adc_fields, XF_HAL_ADC_CMD_RESOLUTION, xf_hal_adc_config_t, resolution);
+    XF_HAL_CONFIG_BITS_PROBE(s_adc_fields, XF_HAL_ADC_CMD_SAMPLE_RATE, xf_hal_adc_config_t, sample_rate);
+    err = xf_hal_driver_set_fields(XF_HAL_ADC_TYPE, s_adc_fields, sizeof(s_adc_fields) / sizeof(s_adc_fields[0]),
+                                   sizeof(xf_hal_adc_config_t));
+    XF_HAL_ADC_CHECK(err, err, "set fields failed!");
+#endif
+
+    return xf_hal_driver_set_pool(XF_HAL_ADC_TYPE, &s_adc_pool);
 }
 
 xf_err_t xf_hal_adc_init(xf_adc_num_t adc_num)
@@ -91,6 +116,9 @@ xf_err_t xf_hal_adc_enable(xf_adc_num_t adc_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_ADC_CMD_ENABLE, &dev_adc->config);
     XF_HAL_ADC_CHECK(err, err, "enable failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_ADC_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -189,6 +217,45 @@ uint32_t xf_hal_adc_read_raw(xf_adc_num_t adc_num)
     return data;
 }
 
+xf_err_t xf_hal_adc_config_begin(xf_adc_num_t adc_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_ADC_TYPE, adc_num);
+    XF_HAL_ADC_CHECK(!dev, XF_ERR_UNINIT, "adc is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_adc_config_commit(xf_adc_num_t adc_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_ADC_TYPE, adc_num);
+    XF_HAL_ADC_CHECK(!dev, XF_ERR_UNINIT, "adc is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_adc_handle_t xf_hal_adc_get_handle(xf_adc_num_t adc_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_ADC_TYPE, adc_num);
+    XF_HAL_ADC_CHECK(!dev, NULL, "adc is not init!");
+
+    return (xf_hal_adc_handle_t)dev;
+}
+
+uint32_t xf_hal_adc_handle_read_raw(xf_hal_adc_handle_t handle)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+    uint32_t data = 0;
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_ADC_CHECK(!dev, 0, "handle is NULL!");
+
+    err = XF_HAL_DEV_READ(ADC, dev, (void *)&data, 1);
+    XF_HAL_ADC_CHECK(err < XF_OK, 0, "adc read failed!:%d!", -err);
+
+    return data;
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_hal_dev_t *adc_constructor(xf_adc_num_t adc_num)
@@ -196,7 +263,7 @@ static xf_hal_dev_t *adc_constructor(xf_adc_num_t adc_num)
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_adc_t *dev_adc = (xf_hal_adc_t *)xf_malloc(sizeof(xf_hal_adc_t));
+    xf_hal_adc_t *dev_adc = (xf_hal_adc_t *)xf_hal_pool_alloc(&s_adc_pool);
     XF_ASSERT(dev_adc, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_adc;
@@ -205,7 +272,7 @@ static xf_hal_dev_t *adc_constructor(xf_adc_num_t adc_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_adc_pool, dev);
         dev = NULL;
     }
 
@@ -68,6 +68,12 @@ typedef struct _xf_hal_adc_config_t {
     uint32_t sample_rate    : 26;   /*!< 采样率参数，1s 中采样的频率，单位为 hz */
 } xf_hal_adc_config_t;
 
+/**
+ * @brief adc 句柄。通过 @ref xf_hal_adc_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_adc_handle_t *xf_hal_adc_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -164,6 +170,53 @@ xf_err_t xf_hal_adc_set_sample_rate(xf_adc_num_t adc_num, uint32_t sample_rate);
  */
 uint32_t xf_hal_adc_read_raw(xf_adc_num_t adc_num);
 
+/**
+ * @brief 开始 adc 配置事务。
+ *
+ * 事务期间调用的 adc 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_adc_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param adc_num adc 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 adc 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_adc_config_begin(xf_adc_num_t adc_num);
+
+/**
+ * @brief 提交 adc 配置事务。
+ *
+ * 将 @ref xf_hal_adc_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param adc_num adc 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 adc 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_adc_config_commit(xf_adc_num_t adc_num);
+
+/**
+ * @brief 获取 adc 句柄。
+ *
+ * @note 句柄在 adc 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param adc_num adc 的序号。
+ * @return xf_hal_adc_handle_t adc 句柄。为 NULL 则该 adc 未初始化
+ */
+xf_hal_adc_handle_t xf_hal_adc_get_handle(xf_adc_num_t adc_num);
+
+/**
+ * @brief 通过句柄读取 adc 原始值。
+ *
+ * @param handle adc 句柄，见 @ref xf_hal_adc_get_handle.
+ * @return uint32_t 读取的原始值
+ */
+uint32_t xf_hal_adc_handle_read_raw(xf_hal_adc_handle_t handle);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
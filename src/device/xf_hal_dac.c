@@ -27,6 +27,9 @@
 typedef struct _xf_hal_dac_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_dac_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_dac_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_dac_t;
 
 /* ==================== [Static Prototypes] ================================= */
@@ -35,6 +38,18 @@ static xf_hal_dev_t *dac_constructor(xf_dac_num_t dac_num);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_dac_pool, sizeof(xf_hal_dac_t), XF_HAL_DAC_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_dac_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_DAC_CMD_ENABLE),
+    XF_HAL_CONFIG_BITS(XF_HAL_DAC_CMD_RESOLUTION),
+    XF_HAL_CONFIG_BITS(XF_HAL_DAC_CMD_SPEED),
+    XF_HAL_CONFIG_FIELD(XF_HAL_DAC_CMD_VALUE_MAX, xf_hal_dac_config_t, value_max),
+    XF_HAL_CONFIG_FIELD(XF_HAL_DAC_CMD_VERF, xf_hal_dac_config_t, verf_mv),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_DAC_CHECK(condition, retval,  format, ...) \
@@ -44,7 +59,19 @@ static xf_hal_dev_t *dac_constructor(xf_dac_num_t dac_num);
 
 xf_err_t xf_hal_dac_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_DAC_TYPE, XF_HAL_FLAG_ONLY_WRITE, dac_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_DAC_TYPE, XF_HAL_FLAG_ONLY_WRITE, dac_constructor, driver_ops);
+    XF_HAL_DAC_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_dac_fields, XF_HAL_DAC_CMD_ENABLE, xf_hal_dac_config_t, enable);
+    XF_HAL_CONFIG_BITS_PROBE(s_dac_fields, XF_HAL_DAC_CMD_RESOLUTION, xf_hal_dac_config_t, resolution);
+    XF_HAL_CONFIG_BITS_PROBE(s_dac_fields, XF_HAL_DAC_CMD_SPEED, xf_hal_dac_config_t, speed);
+    err = xf_hal_driver_set_fields(XF_HAL_DAC_TYPE, s_dac_fields, sizeof(s_dac_fields) / sizeof(s_dac_fields[0]),
+                                   sizeof(xf_hal_dac_config_t));
+    XF_HAL_DAC_CHECK(err, err, "set fields failed!");
+#endif
+
+    return xf_hal_driver_set_pool(XF_HAL_DAC_TYPE, &s_dac_pool);
 }
 
 xf_err_t xf_hal_dac_init(xf_dac_num_t dac_num)
@@ -92,6 +119,9 @@ xf_err_t xf_hal_dac_enable(xf_dac_num_t dac_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_DAC_CMD_ENABLE, &dev_dac->config);
     XF_HAL_DAC_CHECK(err, err, "set resolution failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_DAC_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -187,12 +217,14 @@ xf_err_t xf_hal_dac_write(xf_dac_num_t dac_num, uint32_t value)
     xf_lock_lock(dev_dac->dev.mutex);
 #endif
 
-    XF_ASSERT(value <= dev_dac->config.value_max, XF_ERR_INVALID_ARG, TAG, "value must less than %d", value);
+    uint32_t value_max = dev_dac->config.value_max;
 
 #if XF_HAL_LOCK_IS_ENABLE
     xf_lock_unlock(dev_dac->dev.mutex);
 #endif
 
+    XF_HAL_DAC_CHECK(value > value_max, XF_ERR_INVALID_ARG, "value must less than %d", (int)value_max);
+
     err = xf_hal_driver_write(dev, &value, 1);
     // 此处返回正错误码（-err）即可，无需像其他真正的读写那样返回负值错误码
     XF_HAL_DAC_CHECK(err, -err, "dac write failed!");
@@ -214,14 +246,17 @@ xf_err_t xf_hal_dac_write_mv(xf_dac_num_t dac_num, uint32_t mv)
     xf_lock_lock(dev_dac->dev.mutex);
 #endif
 
-    XF_HAL_DAC_CHECK(mv > dev_dac->config.verf_mv, XF_ERR_INVALID_ARG, "mv must less than %d", dev_dac->config.verf_mv);
-
-    value = dev_dac->config.value_max * mv / dev_dac->config.verf_mv;
+    uint32_t verf_mv = dev_dac->config.verf_mv;
+    uint32_t value_max = dev_dac->config.value_max;
 
 #if XF_HAL_LOCK_IS_ENABLE
     xf_lock_unlock(dev_dac->dev.mutex);
 #endif
 
+    XF_HAL_DAC_CHECK(mv > verf_mv || verf_mv == 0, XF_ERR_INVALID_ARG, "mv must less than %d", (int)verf_mv);
+
+    value = value_max * mv / verf_mv;
+
     err = xf_hal_driver_write(dev, &value, 1);
     // 此处返回正错误码（-err）即可，无需像其他真正的读写那样返回负值错误码
     XF_HAL_DAC_CHECK(err, -err, "dac write failed!");
@@ -229,6 +264,46 @@ xf_err_t xf_hal_dac_write_mv(xf_dac_num_t dac_num, uint32_t mv)
     return XF_OK;
 }
 
+xf_err_t xf_hal_dac_config_begin(xf_dac_num_t dac_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_DAC_TYPE, dac_num);
+    XF_HAL_DAC_CHECK(!dev, XF_ERR_UNINIT, "dac is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_dac_config_commit(xf_dac_num_t dac_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_DAC_TYPE, dac_num);
+    XF_HAL_DAC_CHECK(!dev, XF_ERR_UNINIT, "dac is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_dac_handle_t xf_hal_dac_get_handle(xf_dac_num_t dac_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_DAC_TYPE, dac_num);
+    XF_HAL_DAC_CHECK(!dev, NULL, "dac is not init!");
+
+    return (xf_hal_dac_handle_t)dev;
+}
+
+xf_err_t xf_hal_dac_handle_write(xf_hal_dac_handle_t handle, uint32_t value)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dac_t *dev_dac = (xf_hal_dac_t *)handle;
+    XF_HAL_DAC_CHECK(!dev_dac, XF_ERR_INVALID_ARG, "handle is NULL!");
+    XF_HAL_DAC_CHECK(value > dev_dac->config.value_max, XF_ERR_INVALID_ARG,
+                     "value must less than %d", (int)dev_dac->config.value_max);
+
+    err = XF_HAL_DEV_WRITE(DAC, &dev_dac->dev, &value, 1);
+    XF_HAL_DAC_CHECK(err, -err, "dac write failed!");
+
+    return XF_OK;
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_hal_dev_t *dac_constructor(xf_dac_num_t dac_num)
@@ -236,7 +311,7 @@ static xf_hal_dev_t *dac_constructor(xf_dac_num_t dac_num)
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_dac_t *dev_dac = (xf_hal_dac_t *)xf_malloc(sizeof(xf_hal_dac_t));
+    xf_hal_dac_t *dev_dac = (xf_hal_dac_t *)xf_hal_pool_alloc(&s_dac_pool);
     XF_ASSERT(dev_dac, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_dac;
@@ -245,7 +320,7 @@ static xf_hal_dev_t *dac_constructor(xf_dac_num_t dac_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_dac_pool, dev);
         dev = NULL;
     }
 
@@ -68,6 +68,12 @@ typedef struct _xf_hal_dac_config_t {
     uint32_t verf_mv;           /*!< 默认参数命令，在创建设备时优先执行 */
 } xf_hal_dac_config_t;
 
+/**
+ * @brief dac 句柄。通过 @ref xf_hal_dac_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_dac_handle_t *xf_hal_dac_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -171,6 +177,57 @@ xf_err_t xf_hal_dac_write(xf_dac_num_t dac_num, uint32_t value);
  */
 xf_err_t xf_hal_dac_write_mv(xf_dac_num_t dac_num, uint32_t mv);
 
+/**
+ * @brief 开始 dac 配置事务。
+ *
+ * 事务期间调用的 dac 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_dac_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param dac_num dac 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 dac 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_dac_config_begin(xf_dac_num_t dac_num);
+
+/**
+ * @brief 提交 dac 配置事务。
+ *
+ * 将 @ref xf_hal_dac_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param dac_num dac 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 dac 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_dac_config_commit(xf_dac_num_t dac_num);
+
+/**
+ * @brief 获取 dac 句柄。
+ *
+ * @note 句柄在 dac 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param dac_num dac 的序号。
+ * @return xf_hal_dac_handle_t dac 句柄。为 NULL 则该 dac 未初始化
+ */
+xf_hal_dac_handle_t xf_hal_dac_get_handle(xf_dac_num_t dac_num);
+
+/**
+ * @brief 通过句柄写入 dac 数值。
+ *
+ * @param handle dac 句柄，见 @ref xf_hal_dac_get_handle.
+ * @param value 写入的数值，不能大于 value_max。
+ * @return xf_err_t
+ *      - XF_OK 成功写入
+ *      - XF_ERR_INVALID_ARG 无效句柄或数值过大
+ *      - other 写入失败
+ */
+xf_err_t xf_hal_dac_handle_write(xf_hal_dac_handle_t handle, uint32_t value);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
@@ -70,6 +70,43 @@ extern "C" {
 #   define XF_HAL_DAC_IS_ENABLE     (0)
 #endif
 
+/**
+ * @brief 各类设备对象池大小，即可静态分配的设备对象数量。
+ * 为 0 时不占用静态存储区，设备对象全部从堆上分配；
+ * 打开的设备数超过该值时，超出部分同样退回堆上分配。
+ */
+#if !defined(XF_HAL_GPIO_POOL_SIZE)
+#   define XF_HAL_GPIO_POOL_SIZE    (0)
+#endif
+
+#if !defined(XF_HAL_TIM_POOL_SIZE)
+#   define XF_HAL_TIM_POOL_SIZE     (0)
+#endif
+
+#if !defined(XF_HAL_PWM_POOL_SIZE)
+#   define XF_HAL_PWM_POOL_SIZE     (0)
+#endif
+
+#if !defined(XF_HAL_ADC_POOL_SIZE)
+#   define XF_HAL_ADC_POOL_SIZE     (0)
+#endif
+
+#if !defined(XF_HAL_DAC_POOL_SIZE)
+#   define XF_HAL_DAC_POOL_SIZE     (0)
+#endif
+
+#if !defined(XF_HAL_UART_POOL_SIZE)
+#   define XF_HAL_UART_POOL_SIZE    (0)
+#endif
+
+#if !defined(XF_HAL_I2C_POOL_SIZE)
+#   define XF_HAL_I2C_POOL_SIZE     (0)
+#endif
+
+#if !defined(XF_HAL_SPI_POOL_SIZE)
+#   define XF_HAL_SPI_POOL_SIZE     (0)
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Global Prototypes] ================================= */
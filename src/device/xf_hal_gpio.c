@@ -27,6 +27,9 @@
 typedef struct _xf_hal_gpio_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_gpio_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_gpio_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_gpio_t;
 
 /* ==================== [Static Prototypes] ================================= */
@@ -35,6 +38,20 @@ static xf_hal_dev_t *gpio_constructor(xf_gpio_num_t gpio_num);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_gpio_pool, sizeof(xf_hal_gpio_t), XF_HAL_GPIO_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_gpio_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_GPIO_CMD_DIRECTION),
+    XF_HAL_CONFIG_BITS(XF_HAL_GPIO_CMD_PULL),
+    XF_HAL_CONFIG_BITS(XF_HAL_GPIO_CMD_SPEED),
+    XF_HAL_CONFIG_BITS(XF_HAL_GPIO_CMD_INTR_ENABLE),
+    XF_HAL_CONFIG_BITS(XF_HAL_GPIO_CMD_INTR_TYPE),
+    XF_HAL_CONFIG_FIELD(XF_HAL_GPIO_CMD_INTR_CB, xf_hal_gpio_config_t, cb),
+    XF_HAL_CONFIG_FIELD(XF_HAL_GPIO_CMD_INTR_ISR, xf_hal_gpio_config_t, isr),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_GPIO_CHECK(condition, retval,  format, ...) \
@@ -44,7 +61,21 @@ static xf_hal_dev_t *gpio_constructor(xf_gpio_num_t gpio_num);
 
 xf_err_t xf_hal_gpio_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_GPIO_TYPE, XF_HAL_FLAG_READ_WRITE, gpio_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_GPIO_TYPE, XF_HAL_FLAG_READ_WRITE, gpio_constructor, driver_ops);
+    XF_HAL_GPIO_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_gpio_fields, XF_HAL_GPIO_CMD_DIRECTION, xf_hal_gpio_config_t, direction);
+    XF_HAL_CONFIG_BITS_PROBE(s_gpio_fields, XF_HAL_GPIO_CMD_PULL, xf_hal_gpio_config_t, pull);
+    XF_HAL_CONFIG_BITS_PROBE(s_gpio_fields, XF_HAL_GPIO_CMD_SPEED, xf_hal_gpio_config_t, speed);
+    XF_HAL_CONFIG_BITS_PROBE(s_gpio_fields, XF_HAL_GPIO_CMD_INTR_ENABLE, xf_hal_gpio_config_t, intr_enable);
+    XF_HAL_CONFIG_BITS_PROBE(s_gpio_fields, XF_HAL_GPIO_CMD_INTR_TYPE, xf_hal_gpio_config_t, intr_type);
+    err = xf_hal_driver_set_fields(XF_HAL_GPIO_TYPE, s_gpio_fields, sizeof(s_gpio_fields) / sizeof(s_gpio_fields[0]),
+                                   sizeof(xf_hal_gpio_config_t));
+    XF_HAL_GPIO_CHECK(err, err, "set fields failed!");
+#endif
+
+    return xf_hal_driver_set_pool(XF_HAL_GPIO_TYPE, &s_gpio_pool);
 }
 
 xf_err_t xf_hal_gpio_init(xf_gpio_num_t gpio_num, xf_hal_gpio_dir_t direction)
@@ -261,6 +292,10 @@ xf_err_t xf_hal_gpio_set_intr_enable(xf_gpio_num_t gpio_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_GPIO_CMD_INTR_ENABLE, &dev_gpio->config);
     XF_HAL_GPIO_CHECK(err, err, "irq enable failed!");
 
+    // gpio 没有 enable，中断开关即开始使用，延迟下发的配置在此一并下发
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_GPIO_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -286,6 +321,9 @@ xf_err_t xf_hal_gpio_set_intr_disable(xf_gpio_num_t gpio_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_GPIO_CMD_INTR_ENABLE, &dev_gpio->config);
     XF_HAL_GPIO_CHECK(err, err, "irq disable failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_GPIO_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -297,7 +335,8 @@ xf_err_t xf_hal_gpio_set_level(xf_gpio_num_t gpio_num, bool level)
     xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_GPIO_TYPE, gpio_num);
     XF_HAL_GPIO_CHECK(!dev, XF_ERR_UNINIT, "gpio is not init!");
 
-    err = xf_hal_driver_write(dev, &level, 1);
+    // gpio 总是可读写，不必经过 xf_hal_driver_write 的能力检查；静态分发时可内联对接函数
+    err = XF_HAL_DEV_WRITE(GPIO, dev, &level, 1);
     // 此处返回正错误码（-err）即可，无需像其他真正的读写那样返回负值错误码
     XF_HAL_GPIO_CHECK(err < XF_OK, -err, "gpio write failed!");
 
@@ -313,18 +352,71 @@ bool xf_hal_gpio_get_level(xf_gpio_num_t gpio_num)
     xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_GPIO_TYPE, gpio_num);
     XF_HAL_GPIO_CHECK(!dev, XF_ERR_UNINIT, "gpio is not init!");
 
-    err = xf_hal_driver_read(dev, &level, 1);
+    err = XF_HAL_DEV_READ(GPIO, dev, &level, 1);
     XF_HAL_GPIO_CHECK(err < XF_OK, 0, "gpio read failed!");
 
     return level;
 }
+xf_err_t xf_hal_gpio_config_begin(xf_gpio_num_t gpio_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_GPIO_TYPE, gpio_num);
+    XF_HAL_GPIO_CHECK(!dev, XF_ERR_UNINIT, "gpio is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_gpio_config_commit(xf_gpio_num_t gpio_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_GPIO_TYPE, gpio_num);
+    XF_HAL_GPIO_CHECK(!dev, XF_ERR_UNINIT, "gpio is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_gpio_handle_t xf_hal_gpio_get_handle(xf_gpio_num_t gpio_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_GPIO_TYPE, gpio_num);
+    XF_HAL_GPIO_CHECK(!dev, NULL, "gpio is not init!");
+
+    return (xf_hal_gpio_handle_t)dev;
+}
+
+xf_err_t xf_hal_gpio_handle_set_level(xf_hal_gpio_handle_t handle, bool level)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_GPIO_CHECK(!dev, XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = XF_HAL_DEV_WRITE(GPIO, dev, &level, 1);
+    XF_HAL_GPIO_CHECK(err < XF_OK, -err, "gpio write failed!");
+
+    return err;
+}
+
+bool xf_hal_gpio_handle_get_level(xf_hal_gpio_handle_t handle)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+    bool level = 0;
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_GPIO_CHECK(!dev, 0, "handle is NULL!");
+
+    err = XF_HAL_DEV_READ(GPIO, dev, &level, 1);
+    XF_HAL_GPIO_CHECK(err < XF_OK, 0, "gpio read failed!");
+
+    return level;
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_hal_dev_t *gpio_constructor(xf_gpio_num_t gpio_num)
 {
     xf_err_t err = XF_OK;
     xf_hal_dev_t *dev = NULL;
-    xf_hal_gpio_t *dev_gpio = (xf_hal_gpio_t *)xf_malloc(sizeof(xf_hal_gpio_t));
+    xf_hal_gpio_t *dev_gpio = (xf_hal_gpio_t *)xf_hal_pool_alloc(&s_gpio_pool);
     XF_ASSERT(dev_gpio, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_gpio;
@@ -333,7 +425,7 @@ static xf_hal_dev_t *gpio_constructor(xf_gpio_num_t gpio_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_gpio_pool, dev);
         dev = NULL;
     }
 
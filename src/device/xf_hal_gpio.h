@@ -136,6 +136,12 @@ typedef struct _xf_hal_gpio_config_t {
     xf_hal_gpio_callback_t isr;     /*!< gpio 中断服务参数，该服务函数运行于中断服务 */
 } xf_hal_gpio_config_t;
 
+/**
+ * @brief gpio 句柄。通过 @ref xf_hal_gpio_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_gpio_handle_t *xf_hal_gpio_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -285,6 +291,66 @@ xf_err_t xf_hal_gpio_set_level(xf_gpio_num_t gpio_num, bool level);
  */
 bool xf_hal_gpio_get_level(xf_gpio_num_t gpio_num);
 
+/**
+ * @brief 开始 gpio 配置事务。
+ *
+ * 事务期间调用的 gpio 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_gpio_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param gpio_num gpio 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 gpio 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_gpio_config_begin(xf_gpio_num_t gpio_num);
+
+/**
+ * @brief 提交 gpio 配置事务。
+ *
+ * 将 @ref xf_hal_gpio_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param gpio_num gpio 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 gpio 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_gpio_config_commit(xf_gpio_num_t gpio_num);
+
+/**
+ * @brief 获取 gpio 句柄。
+ *
+ * @note 句柄在 gpio 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param gpio_num gpio 的序号。
+ * @return xf_hal_gpio_handle_t gpio 句柄。为 NULL 则该 gpio 未初始化
+ */
+xf_hal_gpio_handle_t xf_hal_gpio_get_handle(xf_gpio_num_t gpio_num);
+
+/**
+ * @brief 通过句柄设置 gpio 电平高低。
+ *
+ * @param handle gpio 句柄，见 @ref xf_hal_gpio_get_handle.
+ * @param level 电平高低，1 为高电平，0 为低电平。
+ * @return xf_err_t
+ *      - XF_OK 成功设置
+ *      - XF_ERR_INVALID_ARG 无效句柄
+ *      - other 设置电平失败
+ */
+xf_err_t xf_hal_gpio_handle_set_level(xf_hal_gpio_handle_t handle, bool level);
+
+/**
+ * @brief 通过句柄获取 gpio 电平高低。
+ *
+ * @param handle gpio 句柄，见 @ref xf_hal_gpio_get_handle.
+ * @return true 高电平
+ * @return false 低电平
+ */
+bool xf_hal_gpio_handle_get_level(xf_hal_gpio_handle_t handle);
+
 /* ==================== [Macros] ============================================ */
 
 #endif // XF_HAL_GPIO_IS_ENABLE
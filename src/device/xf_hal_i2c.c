@@ -27,14 +27,38 @@
 typedef struct _xf_hal_i2c_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_i2c_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_i2c_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_i2c_t;
 
 /* ==================== [Static Prototypes] ================================= */
 
 static xf_hal_dev_t *i2c_constructor(xf_i2c_num_t i2c_num);
+static xf_err_t i2c_set_transfer(xf_hal_i2c_t *dev_i2c, bool mem_addr_en, uint32_t mem_addr, uint32_t timeout_ms);
+static xf_err_t i2c_seek(xf_hal_dev_t *dev, uint32_t offset);
+static xf_err_t i2c_req_prepare(xf_hal_dev_t *dev, const xf_hal_req_t *req);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_i2c_pool, sizeof(xf_hal_i2c_t), XF_HAL_I2C_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_i2c_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_I2C_CMD_HOSTS),
+    XF_HAL_CONFIG_BITS(XF_HAL_I2C_CMD_ENABLE),
+    XF_HAL_CONFIG_BITS(XF_HAL_I2C_CMD_ADDRESS_WIDTH),
+    XF_HAL_CONFIG_BITS(XF_HAL_I2C_CMD_ADDRESS),
+    XF_HAL_CONFIG_BITS(XF_HAL_I2C_CMD_MEM_ADDR_EN),
+    XF_HAL_CONFIG_BITS(XF_HAL_I2C_CMD_MEM_ADDR_WIDTH),
+    XF_HAL_CONFIG_FIELD(XF_HAL_I2C_CMD_MEM_ADDR, xf_hal_i2c_config_t, mem_addr),
+    XF_HAL_CONFIG_FIELD(XF_HAL_I2C_CMD_SPEED, xf_hal_i2c_config_t, speed),
+    XF_HAL_CONFIG_FIELD(XF_HAL_I2C_CMD_TIMEOUT, xf_hal_i2c_config_t, timeout_ms),
+    XF_HAL_CONFIG_FIELD(XF_HAL_I2C_CMD_SCL_NUM, xf_hal_i2c_config_t, scl_num),
+    XF_HAL_CONFIG_FIELD(XF_HAL_I2C_CMD_SDA_NUM, xf_hal_i2c_config_t, sda_num),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_I2C_CHECK(condition, retval,  format, ...) \
@@ -45,7 +69,30 @@ static xf_hal_dev_t *i2c_constructor(xf_i2c_num_t i2c_num);
 
 xf_err_t xf_hal_i2c_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_I2C_TYPE, XF_HAL_FLAG_READ_WRITE, i2c_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_I2C_TYPE, XF_HAL_FLAG_READ_WRITE, i2c_constructor, driver_ops);
+    XF_HAL_I2C_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_i2c_fields, XF_HAL_I2C_CMD_HOSTS, xf_hal_i2c_config_t, hosts);
+    XF_HAL_CONFIG_BITS_PROBE(s_i2c_fields, XF_HAL_I2C_CMD_ENABLE, xf_hal_i2c_config_t, enable);
+    XF_HAL_CONFIG_BITS_PROBE(s_i2c_fields, XF_HAL_I2C_CMD_ADDRESS_WIDTH, xf_hal_i2c_config_t, address_width);
+    XF_HAL_CONFIG_BITS_PROBE(s_i2c_fields, XF_HAL_I2C_CMD_ADDRESS, xf_hal_i2c_config_t, address);
+    XF_HAL_CONFIG_BITS_PROBE(s_i2c_fields, XF_HAL_I2C_CMD_MEM_ADDR_EN, xf_hal_i2c_config_t, mem_addr_en);
+    XF_HAL_CONFIG_BITS_PROBE(s_i2c_fields, XF_HAL_I2C_CMD_MEM_ADDR_WIDTH, xf_hal_i2c_config_t, mem_addr_width);
+    err = xf_hal_driver_set_fields(XF_HAL_I2C_TYPE, s_i2c_fields, sizeof(s_i2c_fields) / sizeof(s_i2c_fields[0]),
+                                   sizeof(xf_hal_i2c_config_t));
+    XF_HAL_I2C_CHECK(err, err, "set fields failed!");
+#endif
+
+    // posix 层的文件偏移即从机内存地址，宽度见 xf_hal_i2c_set_mem_addr_width
+    err = xf_hal_driver_set_seek(XF_HAL_I2C_TYPE, i2c_seek);
+    XF_HAL_I2C_CHECK(err, err, "set seek failed!");
+
+    // 异步请求的内存地址与超时在轮到该请求时下发
+    err = xf_hal_driver_set_req_prepare(XF_HAL_I2C_TYPE, i2c_req_prepare);
+    XF_HAL_I2C_CHECK(err, err, "set req prepare failed!");
+
+    return xf_hal_driver_set_pool(XF_HAL_I2C_TYPE, &s_i2c_pool);
 }
 
 xf_err_t xf_hal_i2c_init(xf_i2c_num_t i2c_num, xf_hal_i2c_hosts_t hosts, uint32_t speed)
@@ -112,6 +159,9 @@ xf_err_t xf_hal_i2c_enable(xf_i2c_num_t i2c_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_I2C_CMD_ENABLE, &dev_i2c->config);
     XF_HAL_I2C_CHECK(err, err, "i2c enable failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_I2C_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -252,23 +302,8 @@ int xf_hal_i2c_write_mem(xf_i2c_num_t i2c_num, uint32_t mem_addr, const uint8_t
     xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
     XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
 
-    if (dev_i2c->config.mem_addr != mem_addr || dev_i2c->config.mem_addr_en != true || dev_i2c->config.timeout_ms != timeout_ms) {
-
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_lock(dev_i2c->dev.mutex);
-#endif
-
-        dev_i2c->config.mem_addr = mem_addr;
-        dev_i2c->config.mem_addr_en = true;
-        dev_i2c->config.timeout_ms = timeout_ms;
-
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_unlock(dev_i2c->dev.mutex);
-#endif
-
-        err = xf_hal_driver_ioctl(dev, XF_HAL_I2C_CMD_MEM_ADDR | XF_HAL_I2C_CMD_MEM_ADDR_EN | XF_HAL_I2C_CMD_TIMEOUT, &dev_i2c->config);
-        XF_HAL_I2C_CHECK(err, err, "write memory address failed!");
-    }
+    err = i2c_set_transfer(dev_i2c, true, mem_addr, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "write memory address failed!");
 
     err = xf_hal_driver_write(dev, buffer, size);
     XF_HAL_I2C_CHECK(err < XF_OK, err, "write memory address failed!:%d!", -err);
@@ -285,23 +320,8 @@ int xf_hal_i2c_read_mem(xf_i2c_num_t i2c_num, uint32_t mem_addr, uint8_t *buffer
     xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
     XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
 
-    if (dev_i2c->config.mem_addr != mem_addr || dev_i2c->config.mem_addr_en != true || dev_i2c->config.timeout_ms != timeout_ms) {
-
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_lock(dev_i2c->dev.mutex);
-#endif
-
-        dev_i2c->config.mem_addr = mem_addr;
-        dev_i2c->config.mem_addr_en = true;
-        dev_i2c->config.timeout_ms = timeout_ms;
-
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_unlock(dev_i2c->dev.mutex);
-#endif
-
-        err = xf_hal_driver_ioctl(dev, XF_HAL_I2C_CMD_MEM_ADDR | XF_HAL_I2C_CMD_MEM_ADDR_EN | XF_HAL_I2C_CMD_TIMEOUT, &dev_i2c->config);
-        XF_HAL_I2C_CHECK(err, err, "read memory address failed!");
-    }
+    err = i2c_set_transfer(dev_i2c, true, mem_addr, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "read memory address failed!");
 
     err = xf_hal_driver_read(dev, buffer, size);
     XF_HAL_I2C_CHECK(err < XF_OK, err, "read memory address failed!:%d!", -err);
@@ -318,25 +338,29 @@ int xf_hal_i2c_write(xf_i2c_num_t i2c_num, const uint8_t *buffer, uint32_t size,
     xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
     XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
 
-    if (dev_i2c->config.mem_addr_en != false || dev_i2c->config.timeout_ms != timeout_ms) {
+    err = i2c_set_transfer(dev_i2c, false, 0, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "write address disable failed!");
 
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_lock(dev_i2c->dev.mutex);
-#endif
+    err = xf_hal_driver_write(dev, buffer, size);
+    XF_HAL_I2C_CHECK(err < XF_OK, err, "write address failed!:%d!", -err);
 
-        dev_i2c->config.timeout_ms = timeout_ms;
-        dev_i2c->config.mem_addr_en = false;
+    return err;
+}
 
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_unlock(dev_i2c->dev.mutex);
-#endif
+int xf_hal_i2c_writev(xf_i2c_num_t i2c_num, const xf_hal_iovec_t *iov, uint32_t iovcnt, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
 
-        err = xf_hal_driver_ioctl(dev, XF_HAL_I2C_CMD_MEM_ADDR_EN | XF_HAL_I2C_CMD_TIMEOUT, &dev_i2c->config);
-        XF_HAL_I2C_CHECK(err, err, "write address disable failed!");
-    }
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
+    XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
 
-    err = xf_hal_driver_write(dev, buffer, size);
-    XF_HAL_I2C_CHECK(err < XF_OK, err, "write address failed!:%d!", -err);
+    err = i2c_set_transfer(dev_i2c, false, 0, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "write address disable failed!");
+
+    err = xf_hal_driver_writev(dev, iov, iovcnt);
+    XF_HAL_I2C_CHECK(err < XF_OK, err, "i2c writev failed!:%d!", -err);
 
     return err;
 }
@@ -350,23 +374,152 @@ int xf_hal_i2c_read(xf_i2c_num_t i2c_num, uint8_t *buffer, uint32_t size, uint32
     xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
     XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
 
-    if (dev_i2c->config.mem_addr_en != false || dev_i2c->config.timeout_ms != timeout_ms) {
+    err = i2c_set_transfer(dev_i2c, false, 0, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "read address disable failed!");
 
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_lock(dev_i2c->dev.mutex);
-#endif
+    err = xf_hal_driver_read(dev, buffer, size);
+    XF_HAL_I2C_CHECK(err < XF_OK, err, "read address failed!:%d!", -err);
 
-        dev_i2c->config.timeout_ms = timeout_ms;
-        dev_i2c->config.mem_addr_en = false;
+    return err;
+}
 
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_unlock(dev_i2c->dev.mutex);
-#endif
-        err = xf_hal_driver_ioctl(dev, XF_HAL_I2C_CMD_MEM_ADDR_EN | XF_HAL_I2C_CMD_TIMEOUT, &dev_i2c->config);
-        XF_HAL_I2C_CHECK(err, err, "read address disable failed!");
-    }
+xf_err_t xf_hal_i2c_submit(xf_i2c_num_t i2c_num, xf_hal_req_t *req, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
 
-    err = xf_hal_driver_read(dev, buffer, size);
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
+    XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
+    XF_HAL_I2C_CHECK(!req, XF_ERR_INVALID_ARG, "req must not be NULL");
+
+    req->addr_en = false;
+    req->addr = 0;
+    req->timeout_ms = timeout_ms;
+
+    err = xf_hal_driver_submit(dev, req);
+    XF_HAL_I2C_CHECK(err, err, "i2c submit failed!:%d!", err);
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_i2c_submit_mem(xf_i2c_num_t i2c_num, uint32_t mem_addr, xf_hal_req_t *req, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
+    XF_HAL_I2C_CHECK(!dev_i2c, XF_ERR_UNINIT, "i2c is not init!");
+    XF_HAL_I2C_CHECK(!req, XF_ERR_INVALID_ARG, "req must not be NULL");
+
+    req->addr_en = true;
+    req->addr = mem_addr;
+    req->timeout_ms = timeout_ms;
+
+    err = xf_hal_driver_submit(dev, req);
+    XF_HAL_I2C_CHECK(err, err, "i2c submit failed!:%d!", err);
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_i2c_cancel(xf_i2c_num_t i2c_num, xf_hal_req_t *req)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    XF_HAL_I2C_CHECK(!dev, XF_ERR_UNINIT, "i2c is not init!");
+
+    return xf_hal_driver_cancel(dev, req);
+}
+
+xf_err_t xf_hal_i2c_config_begin(xf_i2c_num_t i2c_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    XF_HAL_I2C_CHECK(!dev, XF_ERR_UNINIT, "i2c is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_i2c_config_commit(xf_i2c_num_t i2c_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    XF_HAL_I2C_CHECK(!dev, XF_ERR_UNINIT, "i2c is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_i2c_handle_t xf_hal_i2c_get_handle(xf_i2c_num_t i2c_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_I2C_TYPE, i2c_num);
+    XF_HAL_I2C_CHECK(!dev, NULL, "i2c is not init!");
+
+    return (xf_hal_i2c_handle_t)dev;
+}
+
+int xf_hal_i2c_handle_write_mem(xf_hal_i2c_handle_t handle, uint32_t mem_addr, const uint8_t *buffer,
+                                uint32_t size, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)handle;
+    XF_HAL_I2C_CHECK(!dev_i2c, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = i2c_set_transfer(dev_i2c, true, mem_addr, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "write memory address failed!");
+
+    err = XF_HAL_DEV_WRITE(I2C, &dev_i2c->dev, buffer, size);
+    XF_HAL_I2C_CHECK(err < XF_OK, err, "write memory address failed!:%d!", -err);
+
+    return err;
+}
+
+int xf_hal_i2c_handle_read_mem(xf_hal_i2c_handle_t handle, uint32_t mem_addr, uint8_t *buffer,
+                               uint32_t size, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)handle;
+    XF_HAL_I2C_CHECK(!dev_i2c, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = i2c_set_transfer(dev_i2c, true, mem_addr, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "read memory address failed!");
+
+    err = XF_HAL_DEV_READ(I2C, &dev_i2c->dev, buffer, size);
+    XF_HAL_I2C_CHECK(err < XF_OK, err, "read memory address failed!:%d!", -err);
+
+    return err;
+}
+
+int xf_hal_i2c_handle_write(xf_hal_i2c_handle_t handle, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)handle;
+    XF_HAL_I2C_CHECK(!dev_i2c, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = i2c_set_transfer(dev_i2c, false, 0, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "write address disable failed!");
+
+    err = XF_HAL_DEV_WRITE(I2C, &dev_i2c->dev, buffer, size);
+    XF_HAL_I2C_CHECK(err < XF_OK, err, "write address failed!:%d!", -err);
+
+    return err;
+}
+
+int xf_hal_i2c_handle_read(xf_hal_i2c_handle_t handle, uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)handle;
+    XF_HAL_I2C_CHECK(!dev_i2c, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = i2c_set_transfer(dev_i2c, false, 0, timeout_ms);
+    XF_HAL_I2C_CHECK(err, err, "read address disable failed!");
+
+    err = XF_HAL_DEV_READ(I2C, &dev_i2c->dev, buffer, size);
     XF_HAL_I2C_CHECK(err < XF_OK, err, "read address failed!:%d!", -err);
 
     return err;
@@ -379,7 +532,7 @@ static xf_hal_dev_t *i2c_constructor(xf_i2c_num_t i2c_num)
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)xf_malloc(sizeof(xf_hal_i2c_t));
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)xf_hal_pool_alloc(&s_i2c_pool);
     XF_ASSERT(dev_i2c, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_i2c;
@@ -388,11 +541,61 @@ static xf_hal_dev_t *i2c_constructor(xf_i2c_num_t i2c_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_i2c_pool, dev);
         dev = NULL;
     }
 
     return dev;
 }
 
+static xf_err_t i2c_set_transfer(xf_hal_i2c_t *dev_i2c, bool mem_addr_en, uint32_t mem_addr, uint32_t timeout_ms)
+{
+    uint32_t cmd = XF_HAL_I2C_CMD_MEM_ADDR_EN | XF_HAL_I2C_CMD_TIMEOUT;
+
+    if (mem_addr_en) {
+        if (dev_i2c->config.mem_addr == mem_addr && dev_i2c->config.mem_addr_en == true
+                && dev_i2c->config.timeout_ms == timeout_ms) {
+            return XF_OK;
+        }
+        cmd |= XF_HAL_I2C_CMD_MEM_ADDR;
+    } else if (dev_i2c->config.mem_addr_en == false && dev_i2c->config.timeout_ms == timeout_ms) {
+        return XF_OK;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev_i2c->dev.mutex);
+#endif
+
+    if (mem_addr_en) {
+        dev_i2c->config.mem_addr = mem_addr;
+    }
+    dev_i2c->config.mem_addr_en = mem_addr_en;
+    dev_i2c->config.timeout_ms = timeout_ms;
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev_i2c->dev.mutex);
+#endif
+
+    // 传输参数须在随后的读写前生效，不随配置事务延迟
+    return xf_hal_driver_ioctl_now(&dev_i2c->dev, cmd, &dev_i2c->config);
+}
+
+static xf_err_t i2c_seek(xf_hal_dev_t *dev, uint32_t offset)
+{
+    xf_hal_i2c_t *dev_i2c = (xf_hal_i2c_t *)dev;
+
+    // 超出地址宽度的高位会被丢弃，不能静默回绕到低地址
+    uint32_t width = dev_i2c->config.mem_addr_width;
+    if (width < XF_HAL_I2C_MEM_ADDR_WIDTH_32BIT && (offset >> (8 * (width + 1))) != 0) {
+        return XF_ERR_INVALID_ARG;
+    }
+
+    return i2c_set_transfer(dev_i2c, true, offset, dev_i2c->config.timeout_ms);
+}
+
+static xf_err_t i2c_req_prepare(xf_hal_dev_t *dev, const xf_hal_req_t *req)
+{
+    return i2c_set_transfer((xf_hal_i2c_t *)dev, req->addr_en, req->addr, req->timeout_ms);
+}
+
 #endif
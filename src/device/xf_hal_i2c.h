@@ -26,6 +26,7 @@
 #if XF_HAL_I2C_IS_ENABLE
 
 #include "xf_hal_gpio.h"
+#include "../kernel/xf_hal_io.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -129,6 +130,12 @@ typedef struct _xf_hal_i2c_config_t {
     xf_gpio_num_t sda_num;          /*!< sda io 参数，设置 sda io 序号 */
 } xf_hal_i2c_config_t;
 
+/**
+ * @brief i2c 句柄。通过 @ref xf_hal_i2c_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_i2c_handle_t *xf_hal_i2c_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -272,6 +279,20 @@ int xf_hal_i2c_read_mem(xf_i2c_num_t i2c_num, uint32_t mem_addr, uint8_t *buffer
  */
 int xf_hal_i2c_write(xf_i2c_num_t i2c_num, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
 
+/**
+ * @brief i2c 分散写入数据。
+ *
+ * 依次写入 iov 中的各个数据段，例如协议头、负载和校验，
+ * 对接层实现了 writev 时所有数据段在一次 i2c 传输（一次起始/停止条件）内发送。
+ *
+ * @param i2c_num i2c 的序号。
+ * @param iov 数据段数组，见 @ref xf_hal_iovec_t.
+ * @param iovcnt 数据段数量。
+ * @param timeout_ms 超时时间，单位为ms（针对有RTOS的底层）。
+ * @return int 实际写入的总大小
+ */
+int xf_hal_i2c_writev(xf_i2c_num_t i2c_num, const xf_hal_iovec_t *iov, uint32_t iovcnt, uint32_t timeout_ms);
+
 /**
  * @brief i2c 读取数据。
  *
@@ -283,6 +304,143 @@ int xf_hal_i2c_write(xf_i2c_num_t i2c_num, const uint8_t *buffer, uint32_t size,
  */
 int xf_hal_i2c_read(xf_i2c_num_t i2c_num, uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
 
+/**
+ * @brief i2c 提交异步传输请求。
+ *
+ * 请求按提交顺序排队处理，完成或取消后调用 req->cb，结果保存在 req->result。
+ * 对接层实现了 submit 时由驱动在传输完成后回调，否则提交时同步完成。
+ * 请求完成前 req 及其缓冲区必须保持有效。
+ *
+ * @param i2c_num i2c 的序号。
+ * @param req 由 @ref xf_hal_req_init 初始化的请求。
+ * @param timeout_ms 超时时间。
+ * @return xf_err_t
+ *      - XF_OK                 成功提交
+ *      - XF_ERR_UNINIT         i2c 未初始化
+ *      - XF_ERR_BUSY           请求正在处理中
+ *      - XF_ERR_NOT_SUPPORTED  设备不支持该传输方向
+ */
+xf_err_t xf_hal_i2c_submit(xf_i2c_num_t i2c_num, xf_hal_req_t *req, uint32_t timeout_ms);
+
+/**
+ * @brief i2c 提交访问从机内存地址的异步传输请求。
+ *
+ * 与 @ref xf_hal_i2c_submit 相同，传输前先发送内存地址 mem_addr。
+ * 内存地址与超时保存在请求中，轮到该请求传输时才下发，排队中的请求各自使用自己的地址。
+ *
+ * @param i2c_num i2c 的序号。
+ * @param mem_addr 内存地址。
+ * @param req 由 @ref xf_hal_req_init 初始化的请求。
+ * @param timeout_ms 超时时间。
+ * @return xf_err_t
+ *      - XF_OK                 成功提交
+ *      - XF_ERR_UNINIT         i2c 未初始化
+ *      - XF_ERR_BUSY           请求正在处理中
+ *      - XF_ERR_NOT_SUPPORTED  设备不支持该传输方向
+ */
+xf_err_t xf_hal_i2c_submit_mem(xf_i2c_num_t i2c_num, uint32_t mem_addr, xf_hal_req_t *req, uint32_t timeout_ms);
+
+/**
+ * @brief i2c 取消异步传输请求。
+ *
+ * 排队中的请求直接取消；正在传输的请求需要对接层实现 cancel。
+ *
+ * @param i2c_num i2c 的序号。
+ * @param req 已提交的请求。
+ * @return xf_err_t
+ *      - XF_OK                 成功取消，req->state 为 XF_HAL_REQ_STATE_CANCELED
+ *      - XF_ERR_NOT_FOUND      请求不在处理中
+ *      - XF_ERR_NOT_SUPPORTED  对接层不支持中止正在进行的传输
+ */
+xf_err_t xf_hal_i2c_cancel(xf_i2c_num_t i2c_num, xf_hal_req_t *req);
+
+/**
+ * @brief 开始 i2c 配置事务。
+ *
+ * 事务期间调用的 i2c 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_i2c_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param i2c_num i2c 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 i2c 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_i2c_config_begin(xf_i2c_num_t i2c_num);
+
+/**
+ * @brief 提交 i2c 配置事务。
+ *
+ * 将 @ref xf_hal_i2c_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param i2c_num i2c 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 i2c 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_i2c_config_commit(xf_i2c_num_t i2c_num);
+
+/**
+ * @brief 获取 i2c 句柄。
+ *
+ * @note 句柄在 i2c 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param i2c_num i2c 的序号。
+ * @return xf_hal_i2c_handle_t i2c 句柄。为 NULL 则该 i2c 未初始化
+ */
+xf_hal_i2c_handle_t xf_hal_i2c_get_handle(xf_i2c_num_t i2c_num);
+
+/**
+ * @brief 通过句柄指定从机内存写入。
+ *
+ * @param handle i2c 句柄，见 @ref xf_hal_i2c_get_handle.
+ * @param mem_addr 写入内存地址。
+ * @param buffer 写入数据的指针。
+ * @param size 写入数据的大小。
+ * @param timeout_ms 超时时间，单位为 ms（针对有RTOS的底层）。
+ * @return int 返回实际写入大小。
+ */
+int xf_hal_i2c_handle_write_mem(xf_hal_i2c_handle_t handle, uint32_t mem_addr, const uint8_t *buffer,
+                                uint32_t size, uint32_t timeout_ms);
+
+/**
+ * @brief 通过句柄指定从机内存读取。
+ *
+ * @param handle i2c 句柄，见 @ref xf_hal_i2c_get_handle.
+ * @param mem_addr 读取内存地址。
+ * @param buffer 读取的数据指针。
+ * @param size 读取数据的大小。
+ * @param timeout_ms 超时时间，单位为 ms（针对有RTOS的底层）。
+ * @return int 返回实际读取大小。
+ */
+int xf_hal_i2c_handle_read_mem(xf_hal_i2c_handle_t handle, uint32_t mem_addr, uint8_t *buffer,
+                               uint32_t size, uint32_t timeout_ms);
+
+/**
+ * @brief 通过句柄写入 i2c 数据。
+ *
+ * @param handle i2c 句柄，见 @ref xf_hal_i2c_get_handle.
+ * @param buffer 写入的数据指针。
+ * @param size 写入数据的大小。
+ * @param timeout_ms 超时时间，单位为ms（针对有RTOS的底层）。
+ * @return int 返回实际写入大小。
+ */
+int xf_hal_i2c_handle_write(xf_hal_i2c_handle_t handle, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
+
+/**
+ * @brief 通过句柄读取 i2c 数据。
+ *
+ * @param handle i2c 句柄，见 @ref xf_hal_i2c_get_handle.
+ * @param buffer 读取的数据指针。
+ * @param size 读取数据的大小。
+ * @param timeout_ms 超时时间，单位为ms（针对有RTOS的底层）。
+ * @return int 返回实际读取大小。
+ */
+int xf_hal_i2c_handle_read(xf_hal_i2c_handle_t handle, uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
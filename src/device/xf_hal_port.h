@@ -142,6 +142,30 @@ xf_err_t xf_hal_spi_register(const xf_driver_ops_t *driver_ops);
 
 /* ==================== [Macros] ============================================ */
 
+/**
+ * @brief 导出对接层的 ioctl、read、write，供静态分发（XF_HAL_STATIC_DISPATCH_ENABLE）在链接时绑定。
+ *        写在对接文件中，参数为本文件的 static 函数，如
+ *        `XF_HAL_PORT_EXPORT(GPIO, port_gpio_ioctl, port_gpio_read, port_gpio_write)`；
+ *        未开启静态分发时展开为空，仍通过 xf_hal_X_register 登记的操作集调用。
+ */
+#if XF_HAL_STATIC_DISPATCH_IS_ENABLE
+#define XF_HAL_PORT_EXPORT(name, ioctl_fn, read_fn, write_fn) \
+    xf_err_t xf_hal_port_##name##_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config) \
+    { \
+        return (xf_err_t)ioctl_fn(dev, cmd, config); \
+    } \
+    int xf_hal_port_##name##_read(xf_hal_dev_t *dev, void *buf, size_t count) \
+    { \
+        return read_fn(dev, buf, count); \
+    } \
+    int xf_hal_port_##name##_write(xf_hal_dev_t *dev, const void *buf, size_t count) \
+    { \
+        return write_fn(dev, buf, count); \
+    }
+#else
+#define XF_HAL_PORT_EXPORT(name, ioctl_fn, read_fn, write_fn)
+#endif
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
@@ -27,6 +27,9 @@
 typedef struct _xf_hal_pwm_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_pwm_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_pwm_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_pwm_t;
 
 /* ==================== [Static Prototypes] ================================= */
@@ -35,6 +38,18 @@ static xf_hal_dev_t *pwm_constructor(xf_pwm_num_t pwm_num);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_pwm_pool, sizeof(xf_hal_pwm_t), XF_HAL_PWM_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_pwm_fields[] = {
+    XF_HAL_CONFIG_FIELD(XF_HAL_PWM_CMD_ENABLE, xf_hal_pwm_config_t, enable),
+    XF_HAL_CONFIG_FIELD(XF_HAL_PWM_CMD_FREQ, xf_hal_pwm_config_t, freq),
+    XF_HAL_CONFIG_FIELD(XF_HAL_PWM_CMD_DUTY, xf_hal_pwm_config_t, duty),
+    XF_HAL_CONFIG_FIELD(XF_HAL_PWM_CMD_DUTY_RESOLUTION, xf_hal_pwm_config_t, duty_resolution),
+    XF_HAL_CONFIG_FIELD(XF_HAL_PWM_CMD_IO_NUM, xf_hal_pwm_config_t, io_num),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_PWM_CHECK(condition, retval,  format, ...) \
@@ -44,7 +59,16 @@ static xf_hal_dev_t *pwm_constructor(xf_pwm_num_t pwm_num);
 
 xf_err_t xf_hal_pwm_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_PWM_TYPE, XF_HAL_FLAG_ONLY_READ, pwm_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_PWM_TYPE, XF_HAL_FLAG_ONLY_READ, pwm_constructor, driver_ops);
+    XF_HAL_PWM_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    err = xf_hal_driver_set_fields(XF_HAL_PWM_TYPE, s_pwm_fields, sizeof(s_pwm_fields) / sizeof(s_pwm_fields[0]),
+                                   sizeof(xf_hal_pwm_config_t));
+    XF_HAL_PWM_CHECK(err, err, "set fields failed!");
+#endif
+
+    return xf_hal_driver_set_pool(XF_HAL_PWM_TYPE, &s_pwm_pool);
 }
 
 xf_err_t xf_hal_pwm_init(xf_pwm_num_t pwm_num, uint32_t freq, uint32_t duty)
@@ -160,6 +184,9 @@ xf_err_t xf_hal_pwm_set_freq(xf_pwm_num_t pwm_num, uint32_t freq)
     err = xf_hal_driver_ioctl(dev, XF_HAL_PWM_CMD_FREQ, &dev_pwm->config);
     XF_HAL_PWM_CHECK(err, err, "config failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_PWM_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -294,6 +321,54 @@ bool xf_hal_pwm_is_enable(xf_pwm_num_t pwm_num)
 
     return enable;
 }
+xf_err_t xf_hal_pwm_config_begin(xf_pwm_num_t pwm_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_PWM_TYPE, pwm_num);
+    XF_HAL_PWM_CHECK(!dev, XF_ERR_UNINIT, "pwm is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_pwm_config_commit(xf_pwm_num_t pwm_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_PWM_TYPE, pwm_num);
+    XF_HAL_PWM_CHECK(!dev, XF_ERR_UNINIT, "pwm is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_pwm_handle_t xf_hal_pwm_get_handle(xf_pwm_num_t pwm_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_PWM_TYPE, pwm_num);
+    XF_HAL_PWM_CHECK(!dev, NULL, "pwm is not init!");
+
+    return (xf_hal_pwm_handle_t)dev;
+}
+
+xf_err_t xf_hal_pwm_handle_set_duty(xf_hal_pwm_handle_t handle, uint32_t duty)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_pwm_t *dev_pwm = (xf_hal_pwm_t *)handle;
+    XF_HAL_PWM_CHECK(!dev_pwm, XF_ERR_INVALID_ARG, "handle is NULL!");
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev_pwm->dev.mutex);
+#endif
+
+    dev_pwm->config.duty = duty;
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev_pwm->dev.mutex);
+#endif
+
+    err = xf_hal_driver_ioctl(&dev_pwm->dev, XF_HAL_PWM_CMD_DUTY, &dev_pwm->config);
+    XF_HAL_PWM_CHECK(err, err, "config failed!");
+
+    return XF_OK;
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_hal_dev_t *pwm_constructor(xf_pwm_num_t pwm_num)
@@ -301,7 +376,7 @@ static xf_hal_dev_t *pwm_constructor(xf_pwm_num_t pwm_num)
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_pwm_t *dev_pwm = (xf_hal_pwm_t *)xf_malloc(sizeof(xf_hal_pwm_t));
+    xf_hal_pwm_t *dev_pwm = (xf_hal_pwm_t *)xf_hal_pool_alloc(&s_pwm_pool);
     XF_ASSERT(dev_pwm, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_pwm;
@@ -310,7 +385,7 @@ static xf_hal_dev_t *pwm_constructor(xf_pwm_num_t pwm_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_pwm_pool, dev);
         dev = NULL;
     }
 
@@ -70,6 +70,12 @@ typedef struct _xf_hal_pwm_config_t {
     xf_gpio_num_t io_num;       /*!< 输出 IO 参数，指定 pwm 的输出 io */
 } xf_hal_pwm_config_t;
 
+/**
+ * @brief pwm 句柄。通过 @ref xf_hal_pwm_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_pwm_handle_t *xf_hal_pwm_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -190,6 +196,57 @@ uint32_t xf_hal_pwm_get_duty(xf_pwm_num_t pwm_num);
  */
 bool xf_hal_pwm_is_enable(xf_pwm_num_t pwm_num);
 
+/**
+ * @brief 开始 pwm 配置事务。
+ *
+ * 事务期间调用的 pwm 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_pwm_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param pwm_num pwm 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 pwm 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_pwm_config_begin(xf_pwm_num_t pwm_num);
+
+/**
+ * @brief 提交 pwm 配置事务。
+ *
+ * 将 @ref xf_hal_pwm_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param pwm_num pwm 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 pwm 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_pwm_config_commit(xf_pwm_num_t pwm_num);
+
+/**
+ * @brief 获取 pwm 句柄。
+ *
+ * @note 句柄在 pwm 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param pwm_num pwm 的序号。
+ * @return xf_hal_pwm_handle_t pwm 句柄。为 NULL 则该 pwm 未初始化
+ */
+xf_hal_pwm_handle_t xf_hal_pwm_get_handle(xf_pwm_num_t pwm_num);
+
+/**
+ * @brief 通过句柄设置 pwm 占空比。
+ *
+ * @param handle pwm 句柄，见 @ref xf_hal_pwm_get_handle.
+ * @param duty 占空比，最大值为 `2^duty_resolution - 1`。
+ * @return xf_err_t
+ *      - XF_OK 成功设置
+ *      - XF_ERR_INVALID_ARG 无效句柄
+ *      - other 设置失败
+ */
+xf_err_t xf_hal_pwm_handle_set_duty(xf_hal_pwm_handle_t handle, uint32_t duty);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
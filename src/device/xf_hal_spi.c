@@ -27,14 +27,36 @@
 typedef struct _xf_hal_spi_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_spi_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_spi_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_spi_t;
 
 /* ==================== [Static Prototypes] ================================= */
 
 static xf_hal_dev_t *spi_constructor(xf_spi_num_t spi_num);
+static xf_err_t spi_set_timeout(xf_hal_spi_t *dev_spi, uint32_t timeout_ms);
+static xf_err_t spi_req_prepare(xf_hal_dev_t *dev, const xf_hal_req_t *req);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_spi_pool, sizeof(xf_hal_spi_t), XF_HAL_SPI_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_spi_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_SPI_CMD_HOSTS),
+    XF_HAL_CONFIG_BITS(XF_HAL_SPI_CMD_ENABLE),
+    XF_HAL_CONFIG_BITS(XF_HAL_SPI_CMD_BIT_ORDER),
+    XF_HAL_CONFIG_BITS(XF_HAL_SPI_CMD_MODE),
+    XF_HAL_CONFIG_BITS(XF_HAL_SPI_CMD_DATA_WIDTH),
+    XF_HAL_CONFIG_FIELD(XF_HAL_SPI_CMD_TIMEOUT, xf_hal_spi_config_t, timeout_ms),
+    XF_HAL_CONFIG_FIELD(XF_HAL_SPI_CMD_SPEED, xf_hal_spi_config_t, speed),
+    XF_HAL_CONFIG_FIELD(XF_HAL_SPI_CMD_GPIO, xf_hal_spi_config_t, gpio),
+    XF_HAL_CONFIG_FIELD(XF_HAL_SPI_CMD_PREV_CB, xf_hal_spi_config_t, prev_cb),
+    XF_HAL_CONFIG_FIELD(XF_HAL_SPI_CMD_POST_CB, xf_hal_spi_config_t, post_cb),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 
@@ -45,7 +67,24 @@ static xf_hal_dev_t *spi_constructor(xf_spi_num_t spi_num);
 
 xf_err_t xf_hal_spi_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_SPI_TYPE, XF_HAL_FLAG_READ_WRITE, spi_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_SPI_TYPE, XF_HAL_FLAG_READ_WRITE, spi_constructor, driver_ops);
+    XF_HAL_SPI_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_spi_fields, XF_HAL_SPI_CMD_HOSTS, xf_hal_spi_config_t, hosts);
+    XF_HAL_CONFIG_BITS_PROBE(s_spi_fields, XF_HAL_SPI_CMD_ENABLE, xf_hal_spi_config_t, enable);
+    XF_HAL_CONFIG_BITS_PROBE(s_spi_fields, XF_HAL_SPI_CMD_BIT_ORDER, xf_hal_spi_config_t, bit_order);
+    XF_HAL_CONFIG_BITS_PROBE(s_spi_fields, XF_HAL_SPI_CMD_MODE, xf_hal_spi_config_t, mode);
+    XF_HAL_CONFIG_BITS_PROBE(s_spi_fields, XF_HAL_SPI_CMD_DATA_WIDTH, xf_hal_spi_config_t, data_width);
+    err = xf_hal_driver_set_fields(XF_HAL_SPI_TYPE, s_spi_fields, sizeof(s_spi_fields) / sizeof(s_spi_fields[0]),
+                                   sizeof(xf_hal_spi_config_t));
+    XF_HAL_SPI_CHECK(err, err, "set fields failed!");
+#endif
+
+    err = xf_hal_driver_set_req_prepare(XF_HAL_SPI_TYPE, spi_req_prepare);
+    XF_HAL_SPI_CHECK(err, err, "set req prepare failed!");
+
+    return xf_hal_driver_set_pool(XF_HAL_SPI_TYPE, &s_spi_pool);
 }
 
 xf_err_t xf_hal_spi_init(xf_spi_num_t spi_num, xf_hal_spi_hosts_t hosts, uint32_t speed)
@@ -112,6 +151,9 @@ xf_err_t xf_hal_spi_enable(xf_spi_num_t spi_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_SPI_CMD_ENABLE, &dev_spi->config);
     XF_HAL_SPI_CHECK(err, err, "spi set enable failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_SPI_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -326,24 +368,29 @@ int xf_hal_spi_write(xf_spi_num_t spi_num, const uint8_t *buffer, uint32_t size,
     xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)dev;
     XF_HAL_SPI_CHECK(!dev_spi, XF_ERR_UNINIT, "spi is not init!");
 
-    if (dev_spi->config.timeout_ms != timeout_ms) {
+    err = spi_set_timeout(dev_spi, timeout_ms);
+    XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
 
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_lock(dev_spi->dev.mutex);
-#endif
+    err = xf_hal_driver_write(dev, buffer, size);
+    XF_HAL_SPI_CHECK(err < XF_OK, err,  "spi write failed!:%d!", -err);
+
+    return err;
+}
 
-        dev_spi->config.timeout_ms = timeout_ms;
+int xf_hal_spi_writev(xf_spi_num_t spi_num, const xf_hal_iovec_t *iov, uint32_t iovcnt, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
 
-#if XF_HAL_LOCK_IS_ENABLE
-        xf_lock_unlock(dev_spi->dev.mutex);
-#endif
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_SPI_TYPE, spi_num);
+    xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)dev;
+    XF_HAL_SPI_CHECK(!dev_spi, XF_ERR_UNINIT, "spi is not init!");
 
-        err = xf_hal_driver_ioctl(dev, XF_HAL_SPI_CMD_TIMEOUT, &dev_spi->config);
-        XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
-    }
+    err = spi_set_timeout(dev_spi, timeout_ms);
+    XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
 
-    err = xf_hal_driver_write(dev, buffer, size);
-    XF_HAL_SPI_CHECK(err < XF_OK, err,  "spi write failed!:%d!", -err);
+    err = xf_hal_driver_writev(dev, iov, iovcnt);
+    XF_HAL_SPI_CHECK(err < XF_OK, err, "spi writev failed!:%d!", -err);
 
     return err;
 }
@@ -357,21 +404,94 @@ int xf_hal_spi_read(xf_spi_num_t spi_num, uint8_t *buffer, uint32_t size, uint32
     xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)dev;
     XF_HAL_SPI_CHECK(!dev_spi, XF_ERR_UNINIT, "spi is not init!");
 
-    if (dev_spi->config.timeout_ms != timeout_ms) {
-#if XF_HAL_LOCK_IS_ENABLE
-    xf_lock_lock(dev_spi->dev.mutex);
-#endif
+    err = spi_set_timeout(dev_spi, timeout_ms);
+    XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
 
-        dev_spi->config.timeout_ms = timeout_ms;
-        err = xf_hal_driver_ioctl(dev, XF_HAL_SPI_CMD_TIMEOUT, &dev_spi->config);
-        XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
+    err = xf_hal_driver_read(dev, buffer, size);
+    XF_HAL_SPI_CHECK(err < XF_OK, err,  "spi read failed!:%d!", -err);
 
-#if XF_HAL_LOCK_IS_ENABLE
-    xf_lock_unlock(dev_spi->dev.mutex);
-#endif
-    }
+    return err;
+}
 
-    err = xf_hal_driver_read(dev, buffer, size);
+xf_err_t xf_hal_spi_submit(xf_spi_num_t spi_num, xf_hal_req_t *req, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_SPI_TYPE, spi_num);
+    xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)dev;
+    XF_HAL_SPI_CHECK(!dev_spi, XF_ERR_UNINIT, "spi is not init!");
+    XF_HAL_SPI_CHECK(!req, XF_ERR_INVALID_ARG, "req must not be NULL");
+
+    req->timeout_ms = timeout_ms;
+
+    err = xf_hal_driver_submit(dev, req);
+    XF_HAL_SPI_CHECK(err, err, "spi submit failed!:%d!", err);
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_spi_cancel(xf_spi_num_t spi_num, xf_hal_req_t *req)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_SPI_TYPE, spi_num);
+    XF_HAL_SPI_CHECK(!dev, XF_ERR_UNINIT, "spi is not init!");
+
+    return xf_hal_driver_cancel(dev, req);
+}
+
+xf_err_t xf_hal_spi_config_begin(xf_spi_num_t spi_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_SPI_TYPE, spi_num);
+    XF_HAL_SPI_CHECK(!dev, XF_ERR_UNINIT, "spi is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_spi_config_commit(xf_spi_num_t spi_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_SPI_TYPE, spi_num);
+    XF_HAL_SPI_CHECK(!dev, XF_ERR_UNINIT, "spi is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_spi_handle_t xf_hal_spi_get_handle(xf_spi_num_t spi_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_SPI_TYPE, spi_num);
+    XF_HAL_SPI_CHECK(!dev, NULL, "spi is not init!");
+
+    return (xf_hal_spi_handle_t)dev;
+}
+
+int xf_hal_spi_handle_write(xf_hal_spi_handle_t handle, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)handle;
+    XF_HAL_SPI_CHECK(!dev_spi, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = spi_set_timeout(dev_spi, timeout_ms);
+    XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
+
+    err = XF_HAL_DEV_WRITE(SPI, &dev_spi->dev, buffer, size);
+    XF_HAL_SPI_CHECK(err < XF_OK, err,  "spi write failed!:%d!", -err);
+
+    return err;
+}
+
+int xf_hal_spi_handle_read(xf_hal_spi_handle_t handle, uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)handle;
+    XF_HAL_SPI_CHECK(!dev_spi, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = spi_set_timeout(dev_spi, timeout_ms);
+    XF_HAL_SPI_CHECK(err, err, "set timeout_ms failed!");
+
+    err = XF_HAL_DEV_READ(SPI, &dev_spi->dev, buffer, size);
     XF_HAL_SPI_CHECK(err < XF_OK, err,  "spi read failed!:%d!", -err);
 
     return err;
@@ -384,7 +504,7 @@ static xf_hal_dev_t *spi_constructor(xf_spi_num_t spi_num)
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)xf_malloc(sizeof(xf_hal_spi_t));
+    xf_hal_spi_t *dev_spi = (xf_hal_spi_t *)xf_hal_pool_alloc(&s_spi_pool);
     XF_ASSERT(dev_spi, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_spi;
@@ -393,11 +513,35 @@ static xf_hal_dev_t *spi_constructor(xf_spi_num_t spi_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_spi_pool, dev);
         dev = NULL;
     }
 
     return dev;
 }
 
+static xf_err_t spi_set_timeout(xf_hal_spi_t *dev_spi, uint32_t timeout_ms)
+{
+    if (dev_spi->config.timeout_ms == timeout_ms) {
+        return XF_OK;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev_spi->dev.mutex);
+#endif
+
+    dev_spi->config.timeout_ms = timeout_ms;
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev_spi->dev.mutex);
+#endif
+
+    return xf_hal_driver_ioctl_now(&dev_spi->dev, XF_HAL_SPI_CMD_TIMEOUT, &dev_spi->config);
+}
+
+static xf_err_t spi_req_prepare(xf_hal_dev_t *dev, const xf_hal_req_t *req)
+{
+    return spi_set_timeout((xf_hal_spi_t *)dev, req->timeout_ms);
+}
+
 #endif
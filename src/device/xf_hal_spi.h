@@ -26,6 +26,7 @@
 #if XF_HAL_SPI_IS_ENABLE
 
 #include "xf_hal_gpio.h"
+#include "../kernel/xf_hal_io.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -180,6 +181,12 @@ typedef struct _xf_hal_spi_config_t {
     xf_hal_spi_callback_t post_cb;  /*!< 传输后回调参数 */
 } xf_hal_spi_config_t;
 
+/**
+ * @brief spi 句柄。通过 @ref xf_hal_spi_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_spi_handle_t *xf_hal_spi_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -342,6 +349,20 @@ xf_err_t xf_hal_spi_set_speed(xf_spi_num_t spi_num, uint32_t speed);
  */
 int xf_hal_spi_write(xf_spi_num_t spi_num, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
 
+/**
+ * @brief spi 分散写入数据。
+ *
+ * 依次写入 iov 中的各个数据段，例如协议头、负载和校验，
+ * 对接层实现了 writev 时所有数据段在一次片选内发送。
+ *
+ * @param spi_num spi 的序号。
+ * @param iov 数据段数组，见 @ref xf_hal_iovec_t.
+ * @param iovcnt 数据段数量。
+ * @param timeout_ms 超时时间，单位为ms（针对有RTOS的底层）。
+ * @return int 实际写入的总大小
+ */
+int xf_hal_spi_writev(xf_spi_num_t spi_num, const xf_hal_iovec_t *iov, uint32_t iovcnt, uint32_t timeout_ms);
+
 /**
  * @brief spi 读取数据函数。
  *
@@ -353,6 +374,99 @@ int xf_hal_spi_write(xf_spi_num_t spi_num, const uint8_t *buffer, uint32_t size,
  */
 int xf_hal_spi_read(xf_spi_num_t spi_num, uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
 
+/**
+ * @brief spi 提交异步传输请求。
+ *
+ * 请求按提交顺序排队处理，完成或取消后调用 req->cb，结果保存在 req->result。
+ * 对接层实现了 submit 时由驱动在传输完成后回调，否则提交时同步完成。
+ * 请求完成前 req 及其缓冲区必须保持有效。
+ *
+ * @param spi_num spi 的序号。
+ * @param req 由 @ref xf_hal_req_init 初始化的请求。
+ * @param timeout_ms 超时时间。
+ * @return xf_err_t
+ *      - XF_OK                 成功提交
+ *      - XF_ERR_UNINIT         spi 未初始化
+ *      - XF_ERR_BUSY           请求正在处理中
+ *      - XF_ERR_NOT_SUPPORTED  设备不支持该传输方向
+ */
+xf_err_t xf_hal_spi_submit(xf_spi_num_t spi_num, xf_hal_req_t *req, uint32_t timeout_ms);
+
+/**
+ * @brief spi 取消异步传输请求。
+ *
+ * 排队中的请求直接取消；正在传输的请求需要对接层实现 cancel。
+ *
+ * @param spi_num spi 的序号。
+ * @param req 已提交的请求。
+ * @return xf_err_t
+ *      - XF_OK                 成功取消，req->state 为 XF_HAL_REQ_STATE_CANCELED
+ *      - XF_ERR_NOT_FOUND      请求不在处理中
+ *      - XF_ERR_NOT_SUPPORTED  对接层不支持中止正在进行的传输
+ */
+xf_err_t xf_hal_spi_cancel(xf_spi_num_t spi_num, xf_hal_req_t *req);
+
+/**
+ * @brief 开始 spi 配置事务。
+ *
+ * 事务期间调用的 spi 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_spi_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param spi_num spi 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 spi 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_spi_config_begin(xf_spi_num_t spi_num);
+
+/**
+ * @brief 提交 spi 配置事务。
+ *
+ * 将 @ref xf_hal_spi_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param spi_num spi 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 spi 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_spi_config_commit(xf_spi_num_t spi_num);
+
+/**
+ * @brief 获取 spi 句柄。
+ *
+ * @note 句柄在 spi 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param spi_num spi 的序号。
+ * @return xf_hal_spi_handle_t spi 句柄。为 NULL 则该 spi 未初始化
+ */
+xf_hal_spi_handle_t xf_hal_spi_get_handle(xf_spi_num_t spi_num);
+
+/**
+ * @brief 通过句柄写入 spi 数据。
+ *
+ * @param handle spi 句柄，见 @ref xf_hal_spi_get_handle.
+ * @param buffer 写入的数据指针。
+ * @param size 写入数据的大小。
+ * @param timeout_ms 超时时间，单位为ms（针对有RTOS的底层）。
+ * @return int 返回实际写入大小。
+ */
+int xf_hal_spi_handle_write(xf_hal_spi_handle_t handle, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
+
+/**
+ * @brief 通过句柄读取 spi 数据。
+ *
+ * @param handle spi 句柄，见 @ref xf_hal_spi_get_handle.
+ * @param buffer 读取的数据指针。
+ * @param size 读取数据的大小。
+ * @param timeout_ms 超时时间，单位为ms（针对有RTOS的底层）。
+ * @return int 返回实际读取大小。
+ */
+int xf_hal_spi_handle_read(xf_hal_spi_handle_t handle, uint8_t *buffer, uint32_t size, uint32_t timeout_ms);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
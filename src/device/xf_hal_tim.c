@@ -28,6 +28,9 @@
 typedef struct _xf_hal_tim_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_tim_config_t config;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_tim_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_tim_t;
 
 /* ==================== [Static Prototypes] ================================= */
@@ -36,6 +39,20 @@ static xf_hal_dev_t *tim_constructor(xf_tim_num_t tim_num);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_tim_pool, sizeof(xf_hal_tim_t), XF_HAL_TIM_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+// ACTIVE 是动作而不是状态（定时器可能已自行停止），不参与比较，每次都下发
+static xf_hal_config_field_t s_tim_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_TIM_CMD_AUTO_RELOAD),
+    XF_HAL_CONFIG_BITS(XF_HAL_TIM_CMD_COUNT_DIR),
+    XF_HAL_CONFIG_FIELD(XF_HAL_TIM_CMD_TICK_FREQ_HZ, xf_hal_tim_config_t, tick_freq_hz),
+    XF_HAL_CONFIG_FIELD(XF_HAL_TIM_CMD_TARGET_TICKS, xf_hal_tim_config_t, target_ticks),
+    XF_HAL_CONFIG_FIELD(XF_HAL_TIM_CMD_CB, xf_hal_tim_config_t, cb),
+    XF_HAL_CONFIG_FIELD(XF_HAL_TIM_CMD_ISR, xf_hal_tim_config_t, isr),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_TIM_CHECK(condition, retval,  format, ...) \
@@ -45,7 +62,18 @@ static xf_hal_dev_t *tim_constructor(xf_tim_num_t tim_num);
 
 xf_err_t xf_hal_tim_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_TIM_TYPE, XF_HAL_FLAG_READ_WRITE, tim_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_TIM_TYPE, XF_HAL_FLAG_READ_WRITE, tim_constructor, driver_ops);
+    XF_HAL_TIM_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_tim_fields, XF_HAL_TIM_CMD_AUTO_RELOAD, xf_hal_tim_config_t, auto_reload);
+    XF_HAL_CONFIG_BITS_PROBE(s_tim_fields, XF_HAL_TIM_CMD_COUNT_DIR, xf_hal_tim_config_t, count_dir);
+    err = xf_hal_driver_set_fields(XF_HAL_TIM_TYPE, s_tim_fields, sizeof(s_tim_fields) / sizeof(s_tim_fields[0]),
+                                   sizeof(xf_hal_tim_config_t));
+    XF_HAL_TIM_CHECK(err, err, "set fields failed!");
+#endif
+
+    return xf_hal_driver_set_pool(XF_HAL_TIM_TYPE, &s_tim_pool);
 }
 
 xf_err_t xf_hal_tim_init(xf_tim_num_t tim_num, uint32_t tick_freq_hz, xf_hal_tim_count_dir_t count_dir,
@@ -169,6 +197,9 @@ xf_err_t xf_hal_tim_start(xf_tim_num_t tim_num, uint32_t target_ticks)
 
     XF_HAL_TIM_CHECK(err, err, "tim start failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_TIM_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -230,6 +261,59 @@ uint32_t xf_hal_tim_get_raw_ticks(xf_tim_num_t tim_num)
     return ticks;
 }
 
+xf_err_t xf_hal_tim_config_begin(xf_tim_num_t tim_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_TIM_TYPE, tim_num);
+    XF_HAL_TIM_CHECK(!dev, XF_ERR_UNINIT, "tim is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_tim_config_commit(xf_tim_num_t tim_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_TIM_TYPE, tim_num);
+    XF_HAL_TIM_CHECK(!dev, XF_ERR_UNINIT, "tim is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_tim_handle_t xf_hal_tim_get_handle(xf_tim_num_t tim_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_TIM_TYPE, tim_num);
+    XF_HAL_TIM_CHECK(!dev, NULL, "tim is not init!");
+
+    return (xf_hal_tim_handle_t)dev;
+}
+
+xf_err_t xf_hal_tim_handle_set_raw_ticks(xf_hal_tim_handle_t handle, uint32_t ticks)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_TIM_CHECK(!dev, XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = XF_HAL_DEV_WRITE(TIM, dev, &ticks, 1);
+    XF_HAL_TIM_CHECK(err < XF_OK, -err, "tim write failed!");
+
+    return err;
+}
+
+uint32_t xf_hal_tim_handle_get_raw_ticks(xf_hal_tim_handle_t handle)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+    uint32_t ticks = 0;
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_TIM_CHECK(!dev, 0, "handle is NULL!");
+
+    err = XF_HAL_DEV_READ(TIM, dev, &ticks, 1);
+    XF_HAL_TIM_CHECK(err < XF_OK, 0, "tim read failed!");
+
+    return ticks;
+}
+
 /* ==================== [Static Functions] ================================== */
 
 static xf_hal_dev_t *tim_constructor(xf_tim_num_t tim_num)
@@ -237,7 +321,7 @@ static xf_hal_dev_t *tim_constructor(xf_tim_num_t tim_num)
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_tim_t *dev_tim = (xf_hal_tim_t *)xf_malloc(sizeof(xf_hal_tim_t));
+    xf_hal_tim_t *dev_tim = (xf_hal_tim_t *)xf_hal_pool_alloc(&s_tim_pool);
     XF_ASSERT(dev_tim, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_tim;
@@ -246,7 +330,7 @@ static xf_hal_dev_t *tim_constructor(xf_tim_num_t tim_num)
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_tim_pool, dev);
         dev = NULL;
     }
 
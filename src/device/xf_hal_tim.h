@@ -116,6 +116,12 @@ typedef struct _xf_hal_tim_config_t {
     xf_hal_tim_callback_t isr;  /*!< 定时器中断服务参数 */
 } xf_hal_tim_config_t;
 
+/**
+ * @brief tim 句柄。通过 @ref xf_hal_tim_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_tim_handle_t *xf_hal_tim_handle_t;
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -220,6 +226,65 @@ xf_err_t xf_hal_tim_set_raw_ticks(xf_tim_num_t tim_num, uint32_t ticks);
  */
 uint32_t xf_hal_tim_get_raw_ticks(xf_tim_num_t tim_num);
 
+/**
+ * @brief 开始 tim 配置事务。
+ *
+ * 事务期间调用的 tim 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_tim_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param tim_num tim 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 tim 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_tim_config_begin(xf_tim_num_t tim_num);
+
+/**
+ * @brief 提交 tim 配置事务。
+ *
+ * 将 @ref xf_hal_tim_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param tim_num tim 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 tim 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_tim_config_commit(xf_tim_num_t tim_num);
+
+/**
+ * @brief 获取 tim 句柄。
+ *
+ * @note 句柄在 tim 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param tim_num tim 的序号。
+ * @return xf_hal_tim_handle_t tim 句柄。为 NULL 则该 tim 未初始化
+ */
+xf_hal_tim_handle_t xf_hal_tim_get_handle(xf_tim_num_t tim_num);
+
+/**
+ * @brief 通过句柄设置 tim 的计数值。
+ *
+ * @param handle tim 句柄，见 @ref xf_hal_tim_get_handle.
+ * @param ticks 计数值。
+ * @return xf_err_t
+ *      - XF_OK 成功设置
+ *      - XF_ERR_INVALID_ARG 无效句柄
+ *      - other 设置失败
+ */
+xf_err_t xf_hal_tim_handle_set_raw_ticks(xf_hal_tim_handle_t handle, uint32_t ticks);
+
+/**
+ * @brief 通过句柄获取 tim 的计数值。
+ *
+ * @param handle tim 句柄，见 @ref xf_hal_tim_get_handle.
+ * @return uint32_t 计数值
+ */
+uint32_t xf_hal_tim_handle_get_raw_ticks(xf_hal_tim_handle_t handle);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
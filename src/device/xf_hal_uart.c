@@ -16,6 +16,7 @@
 #if XF_HAL_UART_IS_ENABLE
 
 #include "../kernel/xf_hal_dev.h"
+#include "../kernel/xf_hal_atomic.h"
 
 /* ==================== [Defines] =========================================== */
 
@@ -27,15 +28,43 @@
 typedef struct _xf_hal_uart_t {
     xf_hal_dev_t dev; // 一定要放到第一个，以便后续close一起free
     xf_hal_uart_config_t config;
+    xf_hal_ring_t rx_ring;          // 接收缓冲区，设置后 dev.rx_ring 指向它
+    xf_hal_ring_t tx_ring;          // 异步发送缓冲区，buf 为 NULL 时未设置
+    xf_hal_req_t tx_req;            // 发送缓冲区中正在发送的一段
+    uint32_t tx_active;             // 非 0 时 tx_req 已提交，由完成回调接着发送
+    xf_hal_uart_tx_cb_t tx_cb;      // 发送完一段后的回调
+    void *tx_user_data;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_uart_config_t shadow;   // 已下发到驱动的配置，由 kernel 维护
+#endif
 } xf_hal_uart_t;
 
 
 /* ==================== [Static Prototypes] ================================= */
 
 static xf_hal_dev_t *uart_constructor(xf_uart_num_t uart_num);
+static void uart_tx_kick(xf_hal_uart_t *dev_uart);
+static void uart_tx_done(xf_hal_req_t *req);
 
 /* ==================== [Static Variables] ================================== */
 
+XF_HAL_POOL_DEFINE(s_uart_pool, sizeof(xf_hal_uart_t), XF_HAL_UART_POOL_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static xf_hal_config_field_t s_uart_fields[] = {
+    XF_HAL_CONFIG_BITS(XF_HAL_UART_CMD_ENABLE),
+    XF_HAL_CONFIG_BITS(XF_HAL_UART_CMD_DATA_BITS),
+    XF_HAL_CONFIG_BITS(XF_HAL_UART_CMD_STOP_BITS),
+    XF_HAL_CONFIG_BITS(XF_HAL_UART_CMD_PARITY_BITS),
+    XF_HAL_CONFIG_BITS(XF_HAL_UART_CMD_FLOW_CONTROL),
+    XF_HAL_CONFIG_FIELD(XF_HAL_UART_CMD_BAUDRATE, xf_hal_uart_config_t, baudrate),
+    XF_HAL_CONFIG_FIELD(XF_HAL_UART_CMD_TX_NUM, xf_hal_uart_config_t, tx_num),
+    XF_HAL_CONFIG_FIELD(XF_HAL_UART_CMD_RX_NUM, xf_hal_uart_config_t, rx_num),
+    XF_HAL_CONFIG_FIELD(XF_HAL_UART_CMD_RTS_NUM, xf_hal_uart_config_t, rts_num),
+    XF_HAL_CONFIG_FIELD(XF_HAL_UART_CMD_CTS_NUM, xf_hal_uart_config_t, cts_num),
+};
+#endif
+
 /* ==================== [Macros] ============================================ */
 
 #define XF_HAL_UART_CHECK(condition, retval,  format, ...) \
@@ -45,7 +74,21 @@ static xf_hal_dev_t *uart_constructor(xf_uart_num_t uart_num);
 
 xf_err_t xf_hal_uart_register(const xf_driver_ops_t *driver_ops)
 {
-    return xf_hal_driver_register(XF_HAL_UART_TYPE, XF_HAL_FLAG_READ_WRITE, uart_constructor, driver_ops);
+    xf_err_t err = xf_hal_driver_register(XF_HAL_UART_TYPE, XF_HAL_FLAG_READ_WRITE, uart_constructor, driver_ops);
+    XF_HAL_UART_CHECK(err, err, "register failed!");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    XF_HAL_CONFIG_BITS_PROBE(s_uart_fields, XF_HAL_UART_CMD_ENABLE, xf_hal_uart_config_t, enable);
+    XF_HAL_CONFIG_BITS_PROBE(s_uart_fields, XF_HAL_UART_CMD_DATA_BITS, xf_hal_uart_config_t, data_bits);
+    XF_HAL_CONFIG_BITS_PROBE(s_uart_fields, XF_HAL_UART_CMD_STOP_BITS, xf_hal_uart_config_t, stop_bits);
+    XF_HAL_CONFIG_BITS_PROBE(s_uart_fields, XF_HAL_UART_CMD_PARITY_BITS, xf_hal_uart_config_t, parity_bits);
+    XF_HAL_CONFIG_BITS_PROBE(s_uart_fields, XF_HAL_UART_CMD_FLOW_CONTROL, xf_hal_uart_config_t, flow_control);
+    err = xf_hal_driver_set_fields(XF_HAL_UART_TYPE, s_uart_fields, sizeof(s_uart_fields) / sizeof(s_uart_fields[0]),
+                                   sizeof(xf_hal_uart_config_t));
+    XF_HAL_UART_CHECK(err, err, "set fields failed!");
+#endif
+
+    return xf_hal_driver_set_pool(XF_HAL_UART_TYPE, &s_uart_pool);
 }
 
 xf_err_t xf_hal_uart_init(xf_uart_num_t uart_num, uint32_t baudrate)
@@ -111,6 +154,9 @@ xf_err_t xf_hal_uart_enable(xf_uart_num_t uart_num)
     err = xf_hal_driver_ioctl(dev, XF_HAL_UART_CMD_ENABLE, &dev_uart->config);
     XF_HAL_UART_CHECK(err, err, "enable failed!");
 
+    err = xf_hal_driver_commit(dev);
+    XF_HAL_UART_CHECK(err, err, "commit failed!");
+
     return XF_OK;
 }
 
@@ -298,26 +344,302 @@ int xf_hal_uart_write(xf_uart_num_t uart_num, const uint8_t *data, uint32_t data
     return err;
 }
 
+int xf_hal_uart_writev(xf_uart_num_t uart_num, const xf_hal_iovec_t *iov, uint32_t iovcnt)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)dev;
+    XF_HAL_UART_CHECK(!dev_uart, XF_ERR_UNINIT, "uart is not init!");
+
+    err = xf_hal_driver_writev(dev, iov, iovcnt);
+    XF_HAL_UART_CHECK(err < XF_OK, err, "uart writev failed!:%d!", -err);
+
+    return err;
+}
+
+xf_err_t xf_hal_uart_set_rx_buffer(xf_uart_num_t uart_num, uint8_t *buf, uint32_t size)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)dev;
+    XF_HAL_UART_CHECK(!dev_uart, XF_ERR_UNINIT, "uart is not init!");
+
+    // 先取消，对接层不会再写入旧的缓冲区
+    xf_hal_driver_set_rx_ring(dev, NULL);
+
+    if (buf == NULL) {
+        return XF_OK;
+    }
+
+    err = xf_hal_ring_init(&dev_uart->rx_ring, buf, size);
+    XF_HAL_UART_CHECK(err, err, "rx buffer size must be a power of 2:%u!", (unsigned)size);
+
+    xf_hal_driver_set_rx_ring(dev, &dev_uart->rx_ring);
+
+    return XF_OK;
+}
+
+uint32_t xf_hal_uart_get_rx_available(xf_uart_num_t uart_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, 0, "uart is not init!");
+
+    return (dev->rx_ring != NULL) ? xf_hal_ring_used(dev->rx_ring) : 0;
+}
+
+uint32_t xf_hal_uart_get_rx_overrun(xf_uart_num_t uart_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, 0, "uart is not init!");
+
+    return (dev->rx_ring != NULL) ? xf_hal_ring_overrun(dev->rx_ring) : 0;
+}
+
+uint32_t xf_hal_uart_rx_peek(xf_uart_num_t uart_num, xf_hal_iovec_t iov[2])
+{
+    XF_HAL_UART_CHECK(!iov, 0, "iov must not be NULL!");
+    iov[0].count = 0;
+    iov[1].count = 0;
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, 0, "uart is not init!");
+    XF_HAL_UART_CHECK(!dev->rx_ring, 0, "uart rx buffer is not set!");
+
+    return xf_hal_driver_rx_peek(dev, iov);
+}
+
+xf_err_t xf_hal_uart_rx_consume(xf_uart_num_t uart_num, uint32_t count)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, XF_ERR_UNINIT, "uart is not init!");
+    XF_HAL_UART_CHECK(!dev->rx_ring, XF_ERR_INVALID_STATE, "uart rx buffer is not set!");
+
+    xf_hal_driver_rx_consume(dev, count);
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_uart_set_tx_buffer(xf_uart_num_t uart_num, uint8_t *buf, uint32_t size,
+                                   xf_hal_uart_tx_cb_t cb, void *user_data)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)dev;
+    XF_HAL_UART_CHECK(!dev_uart, XF_ERR_UNINIT, "uart is not init!");
+
+    // 先取消正在发送的一段，完成回调看到取消后不再接着发送
+    uint8_t state = dev_uart->tx_req.state;
+    if (dev_uart->tx_ring.buf != NULL &&
+            (state == XF_HAL_REQ_STATE_PENDING || state == XF_HAL_REQ_STATE_ACTIVE)) {
+        err = xf_hal_driver_cancel(dev, &dev_uart->tx_req);
+        XF_HAL_UART_CHECK(err, XF_ERR_BUSY, "uart tx is in progress!");
+    }
+
+    dev_uart->tx_ring.buf = NULL;
+    dev_uart->tx_active = 0;
+
+    if (buf == NULL) {
+        return XF_OK;
+    }
+
+    err = xf_hal_ring_init(&dev_uart->tx_ring, buf, size);
+    XF_HAL_UART_CHECK(err, err, "tx buffer size must be a power of 2:%u!", (unsigned)size);
+
+    dev_uart->tx_cb = cb;
+    dev_uart->tx_user_data = user_data;
+
+    return XF_OK;
+}
+
+int xf_hal_uart_write_async(xf_uart_num_t uart_num, const uint8_t *data, uint32_t data_len)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)dev;
+    XF_HAL_UART_CHECK(!dev_uart, -XF_ERR_UNINIT, "uart is not init!");
+    XF_HAL_UART_CHECK(!dev_uart->tx_ring.buf, -XF_ERR_INVALID_STATE, "uart tx buffer is not set!");
+
+    uint32_t n = xf_hal_ring_write(&dev_uart->tx_ring, data, data_len);
+
+    // 发送空闲时由写入者启动，否则由完成回调接着发送
+    if (n > 0 && XF_HAL_ATOMIC_FETCH_OR(&dev_uart->tx_active, 1) == 0) {
+        uart_tx_kick(dev_uart);
+    }
+
+    return (int)n;
+}
+
+uint32_t xf_hal_uart_get_tx_free(xf_uart_num_t uart_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)dev;
+    XF_HAL_UART_CHECK(!dev_uart, 0, "uart is not init!");
+
+    if (dev_uart->tx_ring.buf == NULL) {
+        return 0;
+    }
+
+    return dev_uart->tx_ring.mask + 1 - xf_hal_ring_used(&dev_uart->tx_ring);
+}
+
+xf_err_t xf_hal_uart_submit(xf_uart_num_t uart_num, xf_hal_req_t *req)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)dev;
+    XF_HAL_UART_CHECK(!dev_uart, XF_ERR_UNINIT, "uart is not init!");
+
+    err = xf_hal_driver_submit(dev, req);
+    XF_HAL_UART_CHECK(err, err, "uart submit failed!:%d!", err);
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_uart_cancel(xf_uart_num_t uart_num, xf_hal_req_t *req)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, XF_ERR_UNINIT, "uart is not init!");
+
+    return xf_hal_driver_cancel(dev, req);
+}
+
+xf_err_t xf_hal_uart_config_begin(xf_uart_num_t uart_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, XF_ERR_UNINIT, "uart is not init!");
+
+    return xf_hal_dev_config_begin(dev);
+}
+
+xf_err_t xf_hal_uart_config_commit(xf_uart_num_t uart_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, XF_ERR_UNINIT, "uart is not init!");
+
+    return xf_hal_dev_config_commit(dev);
+}
+
+xf_hal_uart_handle_t xf_hal_uart_get_handle(xf_uart_num_t uart_num)
+{
+    xf_hal_dev_t *dev = xf_hal_device_find(XF_HAL_UART_TYPE, uart_num);
+    XF_HAL_UART_CHECK(!dev, NULL, "uart is not init!");
+
+    return (xf_hal_uart_handle_t)dev;
+}
+
+int xf_hal_uart_handle_read(xf_hal_uart_handle_t handle, uint8_t *data, uint32_t data_len)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_UART_CHECK(!dev, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = XF_HAL_DEV_READ(UART, dev, data, data_len);
+    XF_HAL_UART_CHECK(err < XF_OK, err, "uart read failed!:%d!", -err);
+
+    return err;
+}
+
+int xf_hal_uart_handle_write(xf_hal_uart_handle_t handle, const uint8_t *data, uint32_t data_len)
+{
+    xf_err_t err = XF_OK;
+    UNUSED(err);
+
+    xf_hal_dev_t *dev = (xf_hal_dev_t *)handle;
+    XF_HAL_UART_CHECK(!dev, -XF_ERR_INVALID_ARG, "handle is NULL!");
+
+    err = XF_HAL_DEV_WRITE(UART, dev, data, data_len);
+    XF_HAL_UART_CHECK(err < XF_OK, err, "uart write failed!:%d!", -err);
+
+    return err;
+}
+
 /* ==================== [Static Functions] ================================== */
 static xf_hal_dev_t *uart_constructor(xf_uart_num_t uart_num)
 {
     xf_err_t err = XF_OK;
     UNUSED(err);
     xf_hal_dev_t *dev = NULL;
-    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)xf_malloc(sizeof(xf_hal_uart_t));
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)xf_hal_pool_alloc(&s_uart_pool);
     XF_ASSERT(dev_uart, NULL, TAG, "memory alloc failed!");
 
     dev = (xf_hal_dev_t *)dev_uart;
+    dev_uart->tx_ring.buf = NULL;
+    dev_uart->tx_active = 0;
+    xf_hal_req_init(&dev_uart->tx_req, XF_HAL_REQ_DIR_WRITE, NULL, 0, uart_tx_done, dev_uart);
 
     err = xf_hal_driver_open(dev, XF_HAL_UART_TYPE, uart_num);
 
     if (err) {
         XF_LOGE(TAG, "open failed!");
-        xf_free(dev);
+        xf_hal_pool_free(&s_uart_pool, dev);
         dev = NULL;
     }
 
     return dev;
 }
 
+static void uart_tx_kick(xf_hal_uart_t *dev_uart)
+{
+    // 调用者已将 tx_active 置位，此时只有调用者会读取缓冲区
+    xf_hal_ring_t *ring = &dev_uart->tx_ring;
+
+    for (;;) {
+        xf_hal_iovec_t iov[2];
+        if (xf_hal_ring_peek(ring, iov) > 0) {
+            // 每段最多发送缓冲区的一半，发送期间另一半留给写入者
+            uint32_t half = (ring->mask + 1) / 2;
+            uint32_t count = (iov[0].count < half) ? (uint32_t)iov[0].count : half;
+
+            xf_hal_req_init(&dev_uart->tx_req, XF_HAL_REQ_DIR_WRITE, iov[0].buf, count, uart_tx_done, dev_uart);
+            xf_err_t err = xf_hal_driver_submit(&dev_uart->dev, &dev_uart->tx_req);
+            if (err == XF_OK) {
+                return;
+            }
+            XF_LOGE(TAG, "uart tx submit failed:%d!", (int)err);
+            XF_HAL_ATOMIC_FETCH_AND(&dev_uart->tx_active, 0);
+            return;
+        }
+
+        XF_HAL_ATOMIC_FETCH_AND(&dev_uart->tx_active, 0);
+
+        // 写入者在清除前看到 tx_active 为 1 而没有启动，重新检查避免数据滞留
+        if (xf_hal_ring_used(ring) == 0 || XF_HAL_ATOMIC_FETCH_OR(&dev_uart->tx_active, 1) != 0) {
+            return;
+        }
+    }
+}
+
+static void uart_tx_done(xf_hal_req_t *req)
+{
+    xf_hal_uart_t *dev_uart = (xf_hal_uart_t *)req->user_data;
+
+    // 重新设置缓冲区或 deinit 时取消，不再发送
+    if (req->state == XF_HAL_REQ_STATE_CANCELED) {
+        XF_HAL_ATOMIC_FETCH_AND(&dev_uart->tx_active, 0);
+        return;
+    }
+
+    if (req->result < 0) {
+        XF_LOGE(TAG, "uart tx failed:%d!", req->result);
+    }
+
+    // 失败的一段同样丢弃，避免反复重发
+    xf_hal_ring_t *ring = &dev_uart->tx_ring;
+    xf_hal_ring_consume(ring, (uint32_t)req->count);
+    uart_tx_kick(dev_uart);
+
+    if (dev_uart->tx_cb != NULL) {
+        dev_uart->tx_cb(dev_uart->dev.id, ring->mask + 1 - xf_hal_ring_used(ring), dev_uart->tx_user_data);
+    }
+}
+
 #endif
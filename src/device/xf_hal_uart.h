@@ -26,6 +26,7 @@
 #if XF_HAL_UART_IS_ENABLE
 
 #include "xf_hal_gpio.h"
+#include "../kernel/xf_hal_io.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -138,6 +139,21 @@ typedef struct _xf_hal_uart_config_t {
     xf_gpio_num_t cts_num;          /*!< ctx io口参数 */
 } xf_hal_uart_config_t;
 
+/**
+ * @brief uart 句柄。通过 @ref xf_hal_uart_get_handle 获取，
+ *        使用句柄调用时不再查找设备。
+ */
+typedef struct _xf_hal_uart_handle_t *xf_hal_uart_handle_t;
+
+/**
+ * @brief uart 异步发送回调函数原型，每发送完缓冲区中的一段调用一次。
+ *
+ * @param uart_num uart 的序号。
+ * @param free_size 发送缓冲区当前的空闲字节数。
+ * @param user_data 用户数据，见 @ref xf_hal_uart_set_tx_buffer 的 `user_data` 参数。
+ */
+typedef void (*xf_hal_uart_tx_cb_t)(xf_uart_num_t uart_num, uint32_t free_size, void *user_data);
+
 /* ==================== [Global Prototypes] ================================= */
 
 /**
@@ -255,6 +271,8 @@ xf_err_t xf_hal_uart_set_flow_control(xf_uart_num_t uart_num, xf_hal_uart_flow_c
 /**
  * @brief uart 读取函数。
  *
+ * 设置了接收缓冲区（见 @ref xf_hal_uart_set_rx_buffer）时只取出缓冲区中已收到的数据，没有数据时返回 0。
+ *
  * @param uart_num uart 的序号。
  * @param data 读取的数据指针。
  * @param data_len 读取数据长度。
@@ -272,6 +290,228 @@ int xf_hal_uart_read(xf_uart_num_t uart_num, uint8_t *data, uint32_t data_len);
  */
 int xf_hal_uart_write(xf_uart_num_t uart_num, const uint8_t *data, uint32_t data_len);
 
+/**
+ * @brief uart 分散写入数据。
+ *
+ * 依次写入 iov 中的各个数据段，例如协议头、负载和校验，
+ * 对接层实现了 writev 时所有数据段一次发送。
+ *
+ * @param uart_num uart 的序号。
+ * @param iov 数据段数组，见 @ref xf_hal_iovec_t.
+ * @param iovcnt 数据段数量。
+ * @return int 实际写入的总大小
+ */
+int xf_hal_uart_writev(xf_uart_num_t uart_num, const xf_hal_iovec_t *iov, uint32_t iovcnt);
+
+/**
+ * @brief uart 设置接收环形缓冲区。
+ *
+ * 设置后对接层在接收中断中把数据写入缓冲区（xf_hal_driver_rx_push），
+ * xf_hal_uart_read 等读取接口、posix read 与异步读请求都只从缓冲区批量取出已收到的数据，
+ * 不再调用对接层的 read。缓冲区满时新收到的数据被丢弃并计入溢出计数。
+ * 每个 uart 可以使用不同大小的缓冲区。
+ *
+ * @note 应在对接层开始接收前设置；读取只能在一个任务中进行。
+ *
+ * @param uart_num uart 的序号。
+ * @param buf 缓冲区，在取消或 deinit 前必须保持有效；为 NULL 时取消缓冲区。
+ * @param size 缓冲区大小，必须为 2 的幂。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         uart 未初始化
+ *      - XF_ERR_INVALID_ARG    size 不是 2 的幂
+ */
+xf_err_t xf_hal_uart_set_rx_buffer(xf_uart_num_t uart_num, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief uart 接收缓冲区中可读取的字节数。
+ *
+ * @param uart_num uart 的序号。
+ * @return uint32_t 可读取的字节数，未设置接收缓冲区时为 0。
+ */
+uint32_t xf_hal_uart_get_rx_available(xf_uart_num_t uart_num);
+
+/**
+ * @brief uart 接收缓冲区满时累计丢弃的字节数，重新设置缓冲区时清零。
+ *
+ * @param uart_num uart 的序号。
+ * @return uint32_t 丢弃的字节数，未设置接收缓冲区时为 0。
+ */
+uint32_t xf_hal_uart_get_rx_overrun(xf_uart_num_t uart_num);
+
+/**
+ * @brief uart 借出接收缓冲区中已收到的数据，不拷贝。
+ *
+ * 数据在缓冲区末尾回绕时分为两段，iov[0] 在前，不足两段时其余段的 count 为 0。
+ * 协议解析可直接在缓冲区中处理，处理完后调用 xf_hal_uart_rx_consume 释放；
+ * 释放前借出的数据保持有效，不会被新收到的数据覆盖。
+ * 与 xf_hal_uart_read 一样只能在一个任务中调用。
+ *
+ * @code
+ * xf_hal_iovec_t iov[2];
+ * uint32_t n = xf_hal_uart_rx_peek(0, iov);
+ * if (n > 0) {
+ *     xf_hal_uart_rx_consume(0, parse(iov, n));
+ * }
+ * @endcode
+ *
+ * @param uart_num uart 的序号。
+ * @param iov 输出两个数据段，见 @ref xf_hal_iovec_t.
+ * @return uint32_t 借出的总字节数，未设置接收缓冲区时为 0。
+ */
+uint32_t xf_hal_uart_rx_peek(xf_uart_num_t uart_num, xf_hal_iovec_t iov[2]);
+
+/**
+ * @brief uart 释放 xf_hal_uart_rx_peek 借出数据中最前面的 count 个字节。
+ *
+ * 可以只释放已处理的部分，剩余数据留在缓冲区中等待下次借出。
+ * count 超过上次借出的字节数时只释放借出的数据，借出之后收到的数据不会被释放。
+ *
+ * @param uart_num uart 的序号。
+ * @param count 释放的字节数。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         uart 未初始化
+ *      - XF_ERR_INVALID_STATE  未设置接收缓冲区
+ */
+xf_err_t xf_hal_uart_rx_consume(xf_uart_num_t uart_num, uint32_t count);
+
+/**
+ * @brief uart 设置异步发送缓冲区。
+ *
+ * 设置后 xf_hal_uart_write_async 把数据拷贝到缓冲区后立即返回，由 xf_hal_uart_submit 的异步请求在后台发送：
+ * 每次提交缓冲区中最多一半的连续数据，对接层通过中断或 DMA 发送期间，应用可以继续写入另一半，
+ * 即乒乓缓冲；发送完一段后调用 cb 报告空闲空间。对接层未实现 submit 时在写入时同步发送。
+ *
+ * @note 同一 uart 的 xf_hal_uart_write_async 只能在一个任务中调用；
+ *       cb 在完成异步请求的上下文中调用，可能是中断。
+ *
+ * @param uart_num uart 的序号。
+ * @param buf 缓冲区，在取消或 deinit 前必须保持有效；为 NULL 时取消缓冲区，未发送的数据被丢弃。
+ * @param size 缓冲区大小，必须为 2 的幂。
+ * @param cb 发送完一段后的回调，可为 NULL。
+ * @param user_data 传给 cb 的用户数据。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_UNINIT         uart 未初始化
+ *      - XF_ERR_INVALID_ARG    size 不是 2 的幂
+ *      - XF_ERR_BUSY           正在发送且对接层不支持取消
+ */
+xf_err_t xf_hal_uart_set_tx_buffer(xf_uart_num_t uart_num, uint8_t *buf, uint32_t size,
+                                   xf_hal_uart_tx_cb_t cb, void *user_data);
+
+/**
+ * @brief uart 异步发送数据，拷贝到发送缓冲区后立即返回，不等待发送完成。
+ *
+ * 缓冲区空间不足时只写入能容纳的部分，可在回调报告有空闲空间后继续写入剩余部分。
+ *
+ * @param uart_num uart 的序号。
+ * @param data 发送的数据，返回后即可修改。
+ * @param data_len 数据长度。
+ * @return int 写入缓冲区的字节数，缓冲区满时为 0；失败返回负的错误码
+ *      - -XF_ERR_UNINIT         uart 未初始化
+ *      - -XF_ERR_INVALID_STATE  未设置发送缓冲区
+ */
+int xf_hal_uart_write_async(xf_uart_num_t uart_num, const uint8_t *data, uint32_t data_len);
+
+/**
+ * @brief uart 发送缓冲区的空闲字节数。
+ *
+ * @param uart_num uart 的序号。
+ * @return uint32_t 空闲字节数，未设置发送缓冲区时为 0。
+ */
+uint32_t xf_hal_uart_get_tx_free(xf_uart_num_t uart_num);
+
+/**
+ * @brief uart 提交异步传输请求。
+ *
+ * 请求按提交顺序排队处理，完成或取消后调用 req->cb，结果保存在 req->result。
+ * 对接层实现了 submit 时由驱动在传输完成（如 DMA 完成中断）后回调，否则提交时同步完成。
+ * 请求完成前 req 及其缓冲区必须保持有效。
+ *
+ * @param uart_num uart 的序号。
+ * @param req 由 @ref xf_hal_req_init 初始化的请求。
+ * @return xf_err_t
+ *      - XF_OK                 成功提交
+ *      - XF_ERR_UNINIT         uart 未初始化
+ *      - XF_ERR_BUSY           请求正在处理中
+ *      - XF_ERR_NOT_SUPPORTED  设备不支持该传输方向
+ */
+xf_err_t xf_hal_uart_submit(xf_uart_num_t uart_num, xf_hal_req_t *req);
+
+/**
+ * @brief uart 取消异步传输请求。
+ *
+ * 排队中的请求直接取消；正在传输的请求需要对接层实现 cancel。
+ *
+ * @param uart_num uart 的序号。
+ * @param req 已提交的请求。
+ * @return xf_err_t
+ *      - XF_OK                 成功取消，req->state 为 XF_HAL_REQ_STATE_CANCELED
+ *      - XF_ERR_NOT_FOUND      请求不在处理中
+ *      - XF_ERR_NOT_SUPPORTED  对接层不支持中止正在进行的传输
+ */
+xf_err_t xf_hal_uart_cancel(xf_uart_num_t uart_num, xf_hal_req_t *req);
+
+/**
+ * @brief 开始 uart 配置事务。
+ *
+ * 事务期间调用的 uart 设置函数只修改配置，不会立即下发到驱动，
+ * 直到 @ref xf_hal_uart_config_commit 时合并为一次下发。
+ *
+ * @note 事务可以嵌套，只有最外层的提交才会下发。
+ *
+ * @param uart_num uart 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 uart 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_uart_config_begin(xf_uart_num_t uart_num);
+
+/**
+ * @brief 提交 uart 配置事务。
+ *
+ * 将 @ref xf_hal_uart_config_begin 之后累积的配置一次性下发到驱动。
+ *
+ * @param uart_num uart 的序号。
+ * @return xf_err_t
+ *      - XF_OK 成功
+ *      - XF_ERR_UNINIT 该 uart 未初始化
+ *      - other 失败
+ */
+xf_err_t xf_hal_uart_config_commit(xf_uart_num_t uart_num);
+
+/**
+ * @brief 获取 uart 句柄。
+ *
+ * @note 句柄在 uart 反初始化前有效，反初始化后不可再使用。
+ *
+ * @param uart_num uart 的序号。
+ * @return xf_hal_uart_handle_t uart 句柄。为 NULL 则该 uart 未初始化
+ */
+xf_hal_uart_handle_t xf_hal_uart_get_handle(xf_uart_num_t uart_num);
+
+/**
+ * @brief 通过句柄读取 uart 数据。
+ *
+ * @param handle uart 句柄，见 @ref xf_hal_uart_get_handle.
+ * @param data 读取的数据指针。
+ * @param data_len 读取数据长度。
+ * @return int 实际读取的大小
+ */
+int xf_hal_uart_handle_read(xf_hal_uart_handle_t handle, uint8_t *data, uint32_t data_len);
+
+/**
+ * @brief 通过句柄写入 uart 数据。
+ *
+ * @param handle uart 句柄，见 @ref xf_hal_uart_get_handle.
+ * @param data 写入的数据指针。
+ * @param data_len 写入数据长度。
+ * @return int 实际写入的大小
+ */
+int xf_hal_uart_handle_write(xf_hal_uart_handle_t handle, const uint8_t *data, uint32_t data_len);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
@@ -0,0 +1,89 @@
+/**
+ * @file xf_hal_atomic.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 内核使用的原子操作封装。
+ * @version 0.1
+ * @date 2024-07-15
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 基于 gcc/clang 的 __atomic 内建函数实现。
+ * 其他编译器可在 xf_hal_config.h 中预先定义以下宏进行替换。
+ */
+
+#ifndef __XF_HAL_ATOMIC_H__
+#define __XF_HAL_ATOMIC_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+
+/**
+ * @ingroup group_xf_hal_internal
+ * @defgroup group_xf_hal_internal_atomic atomic
+ * @brief 内核原子操作。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#if !defined(XF_HAL_ATOMIC_LOAD)
+#   define XF_HAL_ATOMIC_LOAD(ptr)              __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_LOAD_RELAXED)
+#   define XF_HAL_ATOMIC_LOAD_RELAXED(ptr)      __atomic_load_n((ptr), __ATOMIC_RELAXED)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_STORE)
+#   define XF_HAL_ATOMIC_STORE(ptr, val)        __atomic_store_n((ptr), (val), __ATOMIC_RELEASE)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_STORE_RELAXED)
+#   define XF_HAL_ATOMIC_STORE_RELAXED(ptr, val) __atomic_store_n((ptr), (val), __ATOMIC_RELAXED)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_FETCH_ADD)
+#   define XF_HAL_ATOMIC_FETCH_ADD(ptr, val)    __atomic_fetch_add((ptr), (val), __ATOMIC_ACQ_REL)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_FETCH_OR)
+#   define XF_HAL_ATOMIC_FETCH_OR(ptr, val)     __atomic_fetch_or((ptr), (val), __ATOMIC_ACQ_REL)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_FETCH_AND)
+#   define XF_HAL_ATOMIC_FETCH_AND(ptr, val)    __atomic_fetch_and((ptr), (val), __ATOMIC_ACQ_REL)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_FENCE_ACQUIRE)
+#   define XF_HAL_ATOMIC_FENCE_ACQUIRE()        __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_FENCE_RELEASE)
+#   define XF_HAL_ATOMIC_FENCE_RELEASE()        __atomic_thread_fence(__ATOMIC_RELEASE)
+#endif
+
+#if !defined(XF_HAL_ATOMIC_FENCE)
+#   define XF_HAL_ATOMIC_FENCE()                __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_hal_internal_atomic
+ * @}
+ */
+
+#endif // __XF_HAL_ATOMIC_H__
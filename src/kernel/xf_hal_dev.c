@@ -12,6 +12,8 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_hal_dev.h"
+#include "xf_hal_atomic.h"
+#include <string.h>
 
 /* ==================== [Defines] =========================================== */
 
@@ -22,10 +24,26 @@
 
 typedef struct _xf_hal_driver_t {
     xf_list_t dev_list;
-    uint32_t flag : 16;
-    uint32_t dev_count : 16;
+    uint16_t flag;          /*!< 读写路径无锁读取 */
+    uint16_t dev_count;     /*!< 与 flag 分开存放，持锁修改时不会写到 flag 所在的位域 */
     xf_driver_ops_t driver_ops;
     xf_hal_dev_create_t constructor;
+    xf_hal_pool_t *pool;    /*!< 设备对象池，为 NULL 时设备对象由 xf_free 释放 */
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    const xf_hal_config_field_t *fields;    /*!< 配置字段描述表，为 NULL 时不比较影子配置 */
+    uint16_t field_num;
+    uint16_t config_size;
+    uint32_t suppressed;    /*!< 因配置未改变而省略的 ioctl 次数 */
+#endif
+#if XF_HAL_POSIX_IS_ENABLE
+    xf_hal_dev_seek_t seek; /*!< 设备地址定位，为 NULL 时设备不支持按偏移读写 */
+#endif
+    xf_hal_req_prepare_t req_prepare;   /*!< 请求开始前下发其传输参数，可为 NULL */
+    xf_hal_dev_t *dev_index[XF_HAL_DEV_INDEX_SIZE];  /*!< id 较小的设备直接索引，读侧无锁 */
+    xf_hal_dev_t *dev_hash[XF_HAL_DEV_HASH_SIZE];    /*!< id 较大的设备哈希查找，读侧无锁 */
+    uint32_t readers[2];    /*!< 正在无锁查找的读者数，按进入时的 epoch 奇偶分开计数 */
+    uint32_t epoch;         /*!< 每回收一次加一，新的读者计入 readers[epoch & 1] */
+    xf_list_t retired[2];   /*!< 已关闭、等待读者离开后释放的设备，按关闭时的 epoch 奇偶存放 */
 #if XF_HAL_LOCK_IS_ENABLE
     void *mutex;
 #endif
@@ -33,12 +51,57 @@ typedef struct _xf_hal_driver_t {
 
 /* ==================== [Static Prototypes] ================================= */
 
+static xf_err_t dev_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static bool dev_config_defer(xf_hal_dev_t *dev, uint32_t cmd);
+static inline uint32_t dev_req_lock(xf_hal_dev_t *dev);
+static inline void dev_req_unlock(xf_hal_dev_t *dev, uint32_t state);
+static void dev_req_start(xf_hal_dev_t *dev);
+static bool dev_req_finish(xf_hal_dev_t *dev, xf_hal_req_t *req, uint8_t state, int result);
+static void dev_req_cancel_all(xf_hal_dev_t *dev);
+static void dev_rx_poll_update(xf_hal_dev_t *dev, xf_hal_ring_t *ring);
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static uint32_t dev_shadow_diff(xf_hal_driver_t *driver, xf_hal_dev_t *dev, uint32_t cmd, const void *config);
+static void dev_shadow_update(xf_hal_driver_t *driver, xf_hal_dev_t *dev, uint32_t cmd, const void *config);
+static bool dev_field_equal(const xf_hal_config_field_t *field, const uint8_t *a, const uint8_t *b);
+#endif
+static void dev_index_insert(xf_hal_driver_t *driver, xf_hal_dev_t *dev);
+static void dev_index_remove(xf_hal_driver_t *driver, xf_hal_dev_t *dev);
+static xf_hal_dev_t *dev_index_lookup(xf_hal_driver_t *driver, uint32_t id);
+static inline uint32_t dev_read_begin(xf_hal_driver_t *driver);
+static inline void dev_read_end(xf_hal_driver_t *driver, uint32_t slot);
+static bool dev_reclaim(xf_hal_driver_t *driver);
+
+#if XF_HAL_STATIC_DISPATCH_IS_ENABLE
+static xf_err_t dev_port_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+static int dev_port_read(xf_hal_dev_t *dev, void *buf, size_t count);
+static int dev_port_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+#endif
+
 /* ==================== [Static Variables] ================================== */
 
 static xf_hal_driver_t dev_table[DEV_TABLE_SIZE] = {0};
 
 /* ==================== [Macros] ============================================ */
 
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+// 影子配置紧跟在设备配置之后，见各设备的 xf_hal_xxx_t
+#define DEV_SHADOW(driver, dev) ((uint8_t *)(dev) + sizeof(xf_hal_dev_t) + (driver)->config_size)
+#endif
+
+#if XF_HAL_STATIC_DISPATCH_IS_ENABLE
+#define DEV_PORT_IOCTL(dev, cmd, config)    dev_port_ioctl(dev, cmd, config)
+#define DEV_PORT_READ(dev, buf, count)      dev_port_read(dev, buf, count)
+#define DEV_PORT_WRITE(dev, buf, count)     dev_port_write(dev, buf, count)
+#else
+#define DEV_PORT_IOCTL(dev, cmd, config)    dev_table[(dev)->type].driver_ops.ioctl(dev, cmd, config)
+#define DEV_PORT_READ(dev, buf, count)      dev_table[(dev)->type].driver_ops.read(dev, buf, count)
+#define DEV_PORT_WRITE(dev, buf, count)     dev_table[(dev)->type].driver_ops.write(dev, buf, count)
+#endif
+
+// 设置了接收缓冲区时读取只从缓冲区取出
+#define DEV_RX_READ(dev, buf, count) \
+    (((dev)->rx_ring != NULL) ? xf_hal_driver_rx_read(dev, buf, count) : DEV_PORT_READ(dev, buf, count))
+
 /* ==================== [Global Functions] ================================== */
 
 xf_err_t xf_hal_driver_register(xf_hal_type_t type, xf_hal_flag_t flag, xf_hal_dev_create_t constructor,
@@ -53,14 +116,40 @@ xf_err_t xf_hal_driver_register(xf_hal_type_t type, xf_hal_flag_t flag, xf_hal_d
     dev_table[type].driver_ops.write = driver_ops->write;
     dev_table[type].driver_ops.read = driver_ops->read;
     dev_table[type].driver_ops.close = driver_ops->close;
+    dev_table[type].driver_ops.readv = driver_ops->readv;
+    dev_table[type].driver_ops.writev = driver_ops->writev;
+    dev_table[type].driver_ops.submit = driver_ops->submit;
+    dev_table[type].driver_ops.cancel = driver_ops->cancel;
+    dev_table[type].driver_ops.read_nonblock = driver_ops->read_nonblock;
+    dev_table[type].driver_ops.write_nonblock = driver_ops->write_nonblock;
     dev_table[type].dev_count = 0;
     dev_table[type].flag = flag;
     dev_table[type].constructor = constructor;
+    dev_table[type].pool = NULL;
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    dev_table[type].fields = NULL;
+    dev_table[type].field_num = 0;
+    dev_table[type].config_size = 0;
+    dev_table[type].suppressed = 0;
+#endif
+#if XF_HAL_POSIX_IS_ENABLE
+    dev_table[type].seek = NULL;
+#endif
+    dev_table[type].req_prepare = NULL;
+    memset(dev_table[type].dev_index, 0, sizeof(dev_table[type].dev_index));
+    memset(dev_table[type].dev_hash, 0, sizeof(dev_table[type].dev_hash));
+    dev_table[type].readers[0] = 0;
+    dev_table[type].readers[1] = 0;
+    dev_table[type].epoch = 0;
+    xf_list_init(&dev_table[type].retired[0]);
+    xf_list_init(&dev_table[type].retired[1]);
 #if XF_HAL_LOCK_IS_ENABLE
     xf_err_t err = xf_lock_init(&dev_table[type].mutex);
     XF_ASSERT(!err, err, TAG, "lock init failed!");
 #endif
 
+    xf_hal_posix_init();
+
     return XF_OK;
 }
 
@@ -108,10 +197,15 @@ xf_hal_dev_t *xf_hal_driver_create(xf_hal_type_t type, uint32_t id)
         XF_LOGE(TAG, "set default failed, %d", (int)err);
     }
 
+#if XF_HAL_DEFERRED_CONFIG_IS_ENABLE
+    // 延迟配置时只填充默认参数，硬件在提交时一次性配置
+    dev->dirty = XF_HAL_DEV_CMD_ALL;
+#else
     err = xf_hal_driver_ioctl(dev, XF_HAL_DEV_CMD_ALL, (uint8_t *)dev + sizeof(xf_hal_dev_t));
     if (err != XF_OK) {
         XF_LOGE(TAG, "set all failed, %d", (int)err);
     }
+#endif
 
     return dev;
 }
@@ -125,17 +219,46 @@ xf_err_t xf_hal_driver_open(xf_hal_dev_t *dev, xf_hal_type_t type, uint32_t id)
     dev->type = type;
     dev->id = id;
     dev->platform_data = NULL;
+    dev->hash_next = NULL;
+    dev->ops = &dev_table[type].driver_ops;
+    dev->dirty = 0;
+    dev->batch = 0;
+    xf_list_init(&dev->req_queue);
+    dev->req_active = NULL;
+    dev->rx_ring = NULL;
+#if XF_HAL_STATS_IS_ENABLE
+    xf_hal_stats_reset(&dev->stats);
+#endif
+#if XF_HAL_POSIX_IS_ENABLE
+    // 不上报就绪状态的驱动视为始终可读写，poll 不会在其上阻塞
+    dev->poll_events = (BITS_CHECK(dev_table[type].flag, XF_HAL_FLAG_ONLY_READ) ? XF_HAL_POLLIN : 0)
+                       | (BITS_CHECK(dev_table[type].flag, XF_HAL_FLAG_ONLY_WRITE) ? XF_HAL_POLLOUT : 0);
+#endif
     xf_list_init(&dev->node);
     xf_err_t err = xf_hal_device_add(dev);
     UNUSED(err);
     XF_ASSERT(!err, err, TAG, "device add failed!");
 
+    XF_HAL_TRACE_BEGIN(trace_start);
     err = dev_table[type].driver_ops.open(dev);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_OPEN, dev, trace_start, 0, err);
     XF_ASSERT(!err, err, TAG, "open failed:%d!", (int)err);
 
 #if XF_HAL_LOCK_IS_ENABLE
     err = xf_lock_init(&dev->mutex);
     XF_ASSERT(!err, err, TAG, "lock init failed!");
+#if XF_HAL_POSIX_IS_ENABLE
+    dev->seek_mutex = NULL;
+    if (dev_table[type].seek != NULL) {
+        err = xf_lock_init(&dev->seek_mutex);
+        if (err != XF_OK) {
+            xf_lock_destroy(dev->mutex);
+            dev->mutex = NULL;
+            XF_LOGE(TAG, "lock init failed!");
+            return err;
+        }
+    }
+#endif
 #endif
 
 #if XF_HAL_LOCK_IS_ENABLE
@@ -157,7 +280,11 @@ xf_err_t xf_hal_driver_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
     XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
     XF_ASSERT(config, XF_ERR_INVALID_ARG, TAG, "config must not be NULL");
 
-    xf_err_t err = dev_table[dev->type].driver_ops.ioctl(dev, cmd, config);
+    if (cmd != XF_HAL_DEV_CMD_DEFAULT && dev_config_defer(dev, cmd)) {
+        return XF_OK;
+    }
+
+    xf_err_t err = dev_ioctl(dev, cmd, config);
     UNUSED(err);
     XF_ASSERT(!err, err, TAG, "ioctl failed:%d!", (int)err);
 
@@ -166,13 +293,33 @@ xf_err_t xf_hal_driver_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
     return XF_OK;
 }
 
+xf_err_t xf_hal_driver_ioctl_now(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+    XF_ASSERT(config, XF_ERR_INVALID_ARG, TAG, "config must not be NULL");
+
+    xf_err_t err = dev_ioctl(dev, cmd, config);
+    UNUSED(err);
+    XF_ASSERT(!err, err, TAG, "ioctl failed:%d!", (int)err);
+
+    return XF_OK;
+}
+
 int xf_hal_driver_read(xf_hal_dev_t *dev, void *buf, size_t count)
 {
     XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
     XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag, XF_HAL_FLAG_ONLY_READ), XF_ERR_NOT_SUPPORTED,  TAG,
               "device not support read:%d!", dev_table[dev->type].flag);
 
-    xf_err_t err = dev_table[dev->type].driver_ops.read(dev, buf, count);
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    xf_err_t err = DEV_RX_READ(dev, buf, count);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_READ, dev, trace_start, count, err);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_READ, stats_start, err);
     XF_ASSERT(err >= 0, err, TAG, "driver read failed:%d!", (int) - err);
 
     return err;
@@ -184,36 +331,586 @@ int xf_hal_driver_write(xf_hal_dev_t *dev, const void *buf, size_t count)
     XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag, XF_HAL_FLAG_ONLY_WRITE), XF_ERR_NOT_SUPPORTED,  TAG,
               "device not support write:%d!", dev_table[dev->type].flag);
 
-    xf_err_t err = dev_table[dev->type].driver_ops.write(dev, buf, count);
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    xf_err_t err = DEV_PORT_WRITE(dev, buf, count);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_WRITE, dev, trace_start, count, err);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_WRITE, stats_start, err);
     XF_ASSERT(err >= 0, err, TAG, "driver write failed:%d!", (int) - err);
 
     return err;
 }
 
+int xf_hal_driver_read_nonblock(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    if (dev->rx_ring != NULL) {
+        return xf_hal_driver_read(dev, buf, count);
+    }
+
+    if (ops->read_nonblock == NULL) {
+#if XF_HAL_POSIX_IS_ENABLE
+        if (!(XF_HAL_ATOMIC_LOAD(&dev->poll_events) & XF_HAL_POLLIN)) {
+            return 0;
+        }
+#endif
+        return xf_hal_driver_read(dev, buf, count);
+    }
+
+    XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag, XF_HAL_FLAG_ONLY_READ), XF_ERR_NOT_SUPPORTED,  TAG,
+              "device not support read:%d!", dev_table[dev->type].flag);
+
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    int ret = ops->read_nonblock(dev, buf, count);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_READ, dev, trace_start, count, ret);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_READ, stats_start, ret);
+    XF_ASSERT(ret >= 0, ret, TAG, "driver read failed:%d!", -ret);
+
+    return ret;
+}
+
+int xf_hal_driver_write_nonblock(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    if (ops->write_nonblock == NULL) {
+#if XF_HAL_POSIX_IS_ENABLE
+        if (!(XF_HAL_ATOMIC_LOAD(&dev->poll_events) & XF_HAL_POLLOUT)) {
+            return 0;
+        }
+#endif
+        return xf_hal_driver_write(dev, buf, count);
+    }
+
+    XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag, XF_HAL_FLAG_ONLY_WRITE), XF_ERR_NOT_SUPPORTED,  TAG,
+              "device not support write:%d!", dev_table[dev->type].flag);
+
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    int ret = ops->write_nonblock(dev, buf, count);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_WRITE, dev, trace_start, count, ret);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_WRITE, stats_start, ret);
+    XF_ASSERT(ret >= 0, ret, TAG, "driver write failed:%d!", -ret);
+
+    return ret;
+}
+
+int xf_hal_driver_readv(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+    XF_ASSERT(iov || !iovcnt, XF_ERR_INVALID_ARG, TAG, "iov must not be NULL");
+    XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag, XF_HAL_FLAG_ONLY_READ), XF_ERR_NOT_SUPPORTED,  TAG,
+              "device not support read:%d!", dev_table[dev->type].flag);
+
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    int ret = 0;
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+
+    if (ops->readv != NULL && dev->rx_ring == NULL) {
+        ret = ops->readv(dev, iov, iovcnt);
+    } else {
+        // 驱动未实现 readv 时逐段读取，遇到错误或读取不足时停止，已读取部分数据时返回已读取大小
+        for (size_t i = 0; i < iovcnt; i++) {
+            int n = DEV_RX_READ(dev, iov[i].buf, iov[i].count);
+            if (n < 0) {
+                ret = (ret > 0) ? ret : n;
+                break;
+            }
+            ret += n;
+            if ((size_t)n < iov[i].count) {
+                break;
+            }
+        }
+    }
+
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_READ, dev, trace_start, iovcnt, ret);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_READ, stats_start, ret);
+    XF_ASSERT(ret >= 0, ret, TAG, "driver readv failed:%d!", -ret);
+
+    return ret;
+}
+
+int xf_hal_driver_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+    XF_ASSERT(iov || !iovcnt, XF_ERR_INVALID_ARG, TAG, "iov must not be NULL");
+    XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag, XF_HAL_FLAG_ONLY_WRITE), XF_ERR_NOT_SUPPORTED,  TAG,
+              "device not support write:%d!", dev_table[dev->type].flag);
+
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    int ret = 0;
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+
+    if (ops->writev != NULL) {
+        ret = ops->writev(dev, iov, iovcnt);
+    } else {
+        // 驱动未实现 writev 时逐段写入，遇到错误或写入不足时停止，已写入部分数据时返回已写入大小
+        for (size_t i = 0; i < iovcnt; i++) {
+            int n = DEV_PORT_WRITE(dev, iov[i].buf, iov[i].count);
+            if (n < 0) {
+                ret = (ret > 0) ? ret : n;
+                break;
+            }
+            ret += n;
+            if ((size_t)n < iov[i].count) {
+                break;
+            }
+        }
+    }
+
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_WRITE, dev, trace_start, iovcnt, ret);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_WRITE, stats_start, ret);
+    XF_ASSERT(ret >= 0, ret, TAG, "driver writev failed:%d!", -ret);
+
+    return ret;
+}
+
+xf_err_t xf_hal_driver_submit(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+    XF_ASSERT(req, XF_ERR_INVALID_ARG, TAG, "req must not be NULL");
+    XF_ASSERT(req->state != XF_HAL_REQ_STATE_PENDING && req->state != XF_HAL_REQ_STATE_ACTIVE,
+              XF_ERR_BUSY, TAG, "req is in progress!");
+    XF_ASSERT(BITS_CHECK(dev_table[dev->type].flag,
+                         (req->dir == XF_HAL_REQ_DIR_WRITE) ? XF_HAL_FLAG_ONLY_WRITE : XF_HAL_FLAG_ONLY_READ),
+              XF_ERR_NOT_SUPPORTED, TAG, "device not support req dir:%d!", (int)req->dir);
+
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+
+    XF_HAL_TRACE_BEGIN(trace_start);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_SUBMIT, dev, trace_start, req->count, 0);
+
+    uint32_t lock_state = dev_req_lock(dev);
+
+    req->result = 0;
+    req->state = XF_HAL_REQ_STATE_PENDING;
+    xf_list_add_tail(&req->node, &dev->req_queue);
+
+    dev_req_unlock(dev, lock_state);
+
+    dev_req_start(dev);
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_driver_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+    XF_ASSERT(req, XF_ERR_INVALID_ARG, TAG, "req must not be NULL");
+
+    bool queued = false;
+
+    uint32_t lock_state = dev_req_lock(dev);
+
+    if (req->state == XF_HAL_REQ_STATE_PENDING) {
+        xf_list_del_init(&req->node);
+        req->state = XF_HAL_REQ_STATE_CANCELED;
+        queued = true;
+    }
+
+    dev_req_unlock(dev, lock_state);
+
+    if (queued) {
+        if (req->cb) {
+            req->cb(req);
+        }
+        return XF_OK;
+    }
+
+    XF_ASSERT(dev->req_active == req, XF_ERR_NOT_FOUND, TAG, "req is not in progress!");
+
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    XF_ASSERT(ops->cancel, XF_ERR_NOT_SUPPORTED, TAG, "driver not support cancel!");
+
+    xf_err_t err = ops->cancel(dev, req);
+    XF_ASSERT(!err, err, TAG, "driver cancel failed:%d!", (int)err);
+
+    // 驱动可能在取消前已经完成了该请求
+    if (dev_req_finish(dev, req, XF_HAL_REQ_STATE_CANCELED, 0)) {
+        dev_req_start(dev);
+    }
+
+    return XF_OK;
+}
+
+void xf_hal_driver_complete(xf_hal_dev_t *dev, xf_hal_req_t *req, int result)
+{
+    if (dev == NULL || req == NULL) {
+        XF_LOGE(TAG, "dev and req must not be NULL");
+        return;
+    }
+
+#if !XF_HAL_REQ_CRITICAL_IS_ENABLE && XF_HAL_LOCK_IS_ENABLE
+    // 请求队列由互斥锁保护，中断中无法获取
+    if (XF_HAL_IN_ISR()) {
+        XF_LOGE(TAG, "complete in isr requires XF_HAL_REQ_CRITICAL_ENTER");
+        return;
+    }
+#endif
+
+    if (dev_req_finish(dev, req, XF_HAL_REQ_STATE_DONE, result)) {
+        dev_req_start(dev);
+    }
+}
+
 xf_err_t xf_hal_driver_close(xf_hal_dev_t *dev)
 {
     XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
 
-    xf_err_t err = dev_table[dev->type].driver_ops.close(dev);
+    xf_hal_driver_t *driver = &dev_table[dev->type];
+
+    dev_req_cancel_all(dev);
+
+    XF_HAL_TRACE_BEGIN(trace_start);
+    xf_err_t err = driver->driver_ops.close(dev);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_CLOSE, dev, trace_start, 0, err);
     UNUSED(err);
     XF_ASSERT(!err, err, TAG, "driver close failed");
 
+    // 驱动关闭后不会再完成正在进行的请求
+    xf_hal_req_t *active = dev->req_active;
+    if (active != NULL) {
+        dev_req_finish(dev, active, XF_HAL_REQ_STATE_CANCELED, 0);
+    }
+
 #if XF_HAL_LOCK_IS_ENABLE
-    xf_lock_lock(dev_table[dev->type].mutex);
+#if XF_HAL_POSIX_IS_ENABLE
+    if (dev->seek_mutex != NULL) {
+        xf_lock_destroy(dev->seek_mutex);
+        dev->seek_mutex = NULL;
+    }
+#endif
+    xf_lock_destroy(dev->mutex);
+    dev->mutex = NULL;
 #endif
 
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(driver->mutex);
+#endif
+
+    // 无锁查找可能仍在读取该设备，先摘除，等读者离开后再释放
+    dev_index_remove(driver, dev);
     xf_list_del_init(&dev->node);
-    xf_free(dev);
-    dev_table[dev->type].dev_count--;
+    xf_list_add_tail(&dev->node, &driver->retired[driver->epoch & 1]);
+    driver->dev_count--;
+
+    // 没有并发读者时连续两次回收即可释放该设备，否则留到下一次打开或关闭时
+    if (dev_reclaim(driver)) {
+        dev_reclaim(driver);
+    }
 
 #if XF_HAL_LOCK_IS_ENABLE
-    xf_lock_unlock(dev_table[dev->type].mutex);
+    xf_lock_unlock(driver->mutex);
 #endif
     XF_LOGD(TAG, "close success");
 
     return XF_OK;
 }
 
+xf_err_t xf_hal_driver_commit(xf_hal_dev_t *dev)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev->mutex);
+#endif
+
+    // 配置事务进行中时由最外层的 xf_hal_dev_config_commit 统一下发
+    uint32_t cmd = 0;
+    if (dev->batch == 0) {
+        cmd = dev->dirty;
+        dev->dirty = 0;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->mutex);
+#endif
+
+    if (cmd == 0) {
+        return XF_OK;
+    }
+
+    xf_err_t err = dev_ioctl(dev, cmd, (uint8_t *)dev + sizeof(xf_hal_dev_t));
+    UNUSED(err);
+    XF_ASSERT(!err, err, TAG, "commit failed:%d!", (int)err);
+
+    XF_LOGD(TAG, "commit success");
+
+    return XF_OK;
+}
+
+void xf_hal_driver_set_rx_ring(xf_hal_dev_t *dev, xf_hal_ring_t *ring)
+{
+    if (dev == NULL) {
+        XF_LOGE(TAG, "dev must not be NULL");
+        return;
+    }
+
+    XF_HAL_ATOMIC_STORE(&dev->rx_ring, ring);
+
+    // 设置后由 xf_hal_driver_rx_push 上报可读，取消后恢复为打开时的始终可读
+    if (ring == NULL || xf_hal_ring_used(ring) != 0) {
+        xf_hal_driver_poll_set(dev, XF_HAL_POLLIN);
+    } else {
+        xf_hal_driver_poll_clear(dev, XF_HAL_POLLIN);
+    }
+}
+
+uint32_t xf_hal_driver_rx_push(xf_hal_dev_t *dev, const void *data, uint32_t count)
+{
+    xf_hal_ring_t *ring = XF_HAL_ATOMIC_LOAD(&dev->rx_ring);
+    if (ring == NULL) {
+        return 0;
+    }
+
+    uint32_t n = xf_hal_ring_write(ring, data, count);
+    if (n > 0) {
+        xf_hal_driver_poll_set(dev, XF_HAL_POLLIN);
+    }
+
+    return n;
+}
+
+int xf_hal_driver_rx_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    xf_hal_ring_t *ring = dev->rx_ring;
+    uint32_t n = xf_hal_ring_read(ring, buf, (count > INT32_MAX) ? INT32_MAX : (uint32_t)count);
+    dev_rx_poll_update(dev, ring);
+
+    return (int)n;
+}
+
+uint32_t xf_hal_driver_rx_peek(xf_hal_dev_t *dev, xf_hal_iovec_t iov[2])
+{
+    return xf_hal_ring_peek(dev->rx_ring, iov);
+}
+
+uint32_t xf_hal_driver_rx_consume(xf_hal_dev_t *dev, uint32_t count)
+{
+    xf_hal_ring_t *ring = dev->rx_ring;
+    uint32_t n = xf_hal_ring_consume(ring, count);
+    dev_rx_poll_update(dev, ring);
+
+    return n;
+}
+
+xf_err_t xf_hal_dev_config_begin(xf_hal_dev_t *dev)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev->mutex);
+#endif
+
+    bool overflow = (dev->batch == UINT8_MAX);
+    if (!overflow) {
+        dev->batch++;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->mutex);
+#endif
+
+    XF_ASSERT(!overflow, XF_FAIL, TAG, "config begin nested too deep!");
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_dev_config_commit(xf_hal_dev_t *dev)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev->mutex);
+#endif
+
+    bool unbalanced = (dev->batch == 0);
+    if (!unbalanced) {
+        dev->batch--;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->mutex);
+#endif
+
+    // 不在事务中时只下发延迟配置累积的命令
+    if (unbalanced) {
+        XF_LOGD(TAG, "config commit without begin, flush only");
+    }
+
+    return xf_hal_driver_commit(dev);
+}
+
+xf_err_t xf_hal_driver_set_pool(xf_hal_type_t type, xf_hal_pool_t *pool)
+{
+    XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, XF_ERR_INVALID_ARG, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
+
+    if (pool != NULL) {
+        xf_err_t err = xf_hal_pool_init(pool);
+        XF_ASSERT(!err, err, TAG, "pool init failed!");
+    }
+
+    dev_table[type].pool = pool;
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_driver_set_fields(xf_hal_type_t type, const xf_hal_config_field_t *fields, uint32_t field_num,
+                                  uint32_t config_size)
+{
+    XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, XF_ERR_INVALID_ARG, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
+    XF_ASSERT(fields || !field_num, XF_ERR_INVALID_ARG, TAG, "fields must not be NULL");
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    dev_table[type].fields = fields;
+    dev_table[type].field_num = field_num;
+    dev_table[type].config_size = config_size;
+#else
+    UNUSED(config_size);
+#endif
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_driver_set_seek(xf_hal_type_t type, xf_hal_dev_seek_t seek)
+{
+    XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, XF_ERR_INVALID_ARG, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
+
+#if XF_HAL_POSIX_IS_ENABLE
+    dev_table[type].seek = seek;
+#else
+    UNUSED(seek);
+#endif
+
+    return XF_OK;
+}
+
+xf_err_t xf_hal_driver_set_req_prepare(xf_hal_type_t type, xf_hal_req_prepare_t prepare)
+{
+    XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, XF_ERR_INVALID_ARG, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
+
+    dev_table[type].req_prepare = prepare;
+
+    return XF_OK;
+}
+
+bool xf_hal_driver_is_seekable(xf_hal_type_t type)
+{
+    XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, false, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
+
+#if XF_HAL_POSIX_IS_ENABLE
+    return dev_table[type].seek != NULL;
+#else
+    return false;
+#endif
+}
+
+xf_err_t xf_hal_driver_seek_begin(xf_hal_dev_t *dev, uint32_t offset)
+{
+    XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
+
+#if XF_HAL_POSIX_IS_ENABLE
+    xf_hal_dev_seek_t seek = dev_table[dev->type].seek;
+    if (seek == NULL) {
+        return XF_ERR_NOT_SUPPORTED;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev->seek_mutex);
+#endif
+
+    xf_err_t err = seek(dev, offset);
+
+#if XF_HAL_LOCK_IS_ENABLE
+    if (err != XF_OK) {
+        xf_lock_unlock(dev->seek_mutex);
+    }
+#endif
+
+    return err;
+#else
+    UNUSED(offset);
+    return XF_ERR_NOT_SUPPORTED;
+#endif
+}
+
+void xf_hal_driver_seek_end(xf_hal_dev_t *dev)
+{
+#if XF_HAL_POSIX_IS_ENABLE && XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->seek_mutex);
+#else
+    UNUSED(dev);
+#endif
+}
+
+uint32_t xf_hal_driver_get_suppressed_count(xf_hal_type_t type)
+{
+    XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, 0, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    return XF_HAL_ATOMIC_LOAD_RELAXED(&dev_table[type].suppressed);
+#else
+    return 0;
+#endif
+}
+
+void xf_hal_config_field_probe(xf_hal_config_field_t *fields, uint32_t field_num, uint32_t cmd,
+                               const void *probe, uint32_t size)
+{
+    const uint8_t *bytes = (const uint8_t *)probe;
+    uint32_t first = 0;
+
+    while (first < size && bytes[first] == 0) {
+        first++;
+    }
+    if (first == size) {
+        XF_LOGE(TAG, "probe is empty!");
+        return;
+    }
+
+    uint32_t offset = first & ~(uint32_t)(sizeof(uint32_t) - 1);
+    uint32_t mask = 0;
+    memcpy(&mask, bytes + offset, sizeof(mask));
+
+    for (uint32_t i = 0; i < field_num; i++) {
+        if (fields[i].cmd == cmd) {
+            fields[i].offset = offset;
+            fields[i].size = sizeof(uint32_t);
+            fields[i].mask = mask;
+        }
+    }
+}
+
 xf_err_t xf_hal_device_add(xf_hal_dev_t *dev)
 {
     XF_ASSERT(dev, XF_ERR_INVALID_ARG, TAG, "dev must not be NULL");
@@ -226,6 +923,8 @@ xf_err_t xf_hal_device_add(xf_hal_dev_t *dev)
 
     xf_list_init(&dev->node);
     xf_list_add_tail(&dev->node, &dev_table[dev->type].dev_list);
+    dev_index_insert(&dev_table[dev->type], dev);
+    dev_reclaim(&dev_table[dev->type]);
 
 #if XF_HAL_LOCK_IS_ENABLE
     xf_lock_unlock(dev_table[dev->type].mutex);
@@ -240,28 +939,467 @@ xf_hal_dev_t *xf_hal_device_find(xf_hal_type_t type, uint32_t id)
 {
     XF_ASSERT(type < DEV_TABLE_SIZE && type >= 0, NULL, TAG, "type must between 0 and %d", DEV_TABLE_SIZE);
 
+    xf_hal_driver_t *driver = &dev_table[type];
+
+    // 查找不加锁，关闭的设备在所有读者离开前不会被释放
+    uint32_t slot = dev_read_begin(driver);
+    xf_hal_dev_t *dev = dev_index_lookup(driver, id);
+    dev_read_end(driver, slot);
+
+    return dev;
+}
+
+void xf_hal_device_foreach(xf_hal_device_cb_t cb, void *user_data)
+{
+    if (cb == NULL) {
+        XF_LOGE(TAG, "cb must not be NULL");
+        return;
+    }
+
+    for (uint32_t type = 0; type < DEV_TABLE_SIZE; type++) {
+        xf_hal_driver_t *driver = &dev_table[type];
+        xf_hal_dev_t *dev = NULL;
+
+        // 未注册的设备类型
+        if (driver->constructor == NULL) {
+            continue;
+        }
+
+#if XF_HAL_LOCK_IS_ENABLE
+        xf_lock_lock(driver->mutex);
+#endif
+
+        xf_list_for_each_entry(dev, &driver->dev_list, xf_hal_dev_t, node) {
+            cb(dev, user_data);
+        }
+
+#if XF_HAL_LOCK_IS_ENABLE
+        xf_lock_unlock(driver->mutex);
+#endif
+    }
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void dev_index_insert(xf_hal_driver_t *driver, xf_hal_dev_t *dev)
+{
+    if (dev->id < XF_HAL_DEV_INDEX_SIZE) {
+        // 发布前设备已初始化完成，无锁读者通过 acquire 读取
+        XF_HAL_ATOMIC_STORE(&driver->dev_index[dev->id], dev);
+        return;
+    }
+
+    // 写者由 mutex 串行，先链好 hash_next 再发布到桶头
+    xf_hal_dev_t **bucket = &driver->dev_hash[dev->id % XF_HAL_DEV_HASH_SIZE];
+    dev->hash_next = *bucket;
+    XF_HAL_ATOMIC_STORE(bucket, dev);
+}
+
+static void dev_index_remove(xf_hal_driver_t *driver, xf_hal_dev_t *dev)
+{
+    if (dev->id < XF_HAL_DEV_INDEX_SIZE) {
+        if (driver->dev_index[dev->id] == dev) {
+            XF_HAL_ATOMIC_STORE(&driver->dev_index[dev->id], NULL);
+        }
+        return;
+    }
+
+    // 摘除后保留 dev->hash_next，正停在该设备上的读者仍能继续向后查找
+    xf_hal_dev_t **link = &driver->dev_hash[dev->id % XF_HAL_DEV_HASH_SIZE];
+    while (*link != NULL) {
+        if (*link == dev) {
+            XF_HAL_ATOMIC_STORE(link, dev->hash_next);
+            return;
+        }
+        link = &(*link)->hash_next;
+    }
+}
+
+static xf_hal_dev_t *dev_index_lookup(xf_hal_driver_t *driver, uint32_t id)
+{
+    if (id < XF_HAL_DEV_INDEX_SIZE) {
+        return XF_HAL_ATOMIC_LOAD(&driver->dev_index[id]);
+    }
+
+    xf_hal_dev_t *dev = XF_HAL_ATOMIC_LOAD(&driver->dev_hash[id % XF_HAL_DEV_HASH_SIZE]);
+    while (dev != NULL && dev->id != id) {
+        dev = XF_HAL_ATOMIC_LOAD(&dev->hash_next);
+    }
+
+    return dev;
+}
+
+static inline uint32_t dev_read_begin(xf_hal_driver_t *driver)
+{
+    // 读到新的 epoch 时也能看到推进之前摘除的设备
+    uint32_t slot = XF_HAL_ATOMIC_LOAD(&driver->epoch) & 1;
+    XF_HAL_ATOMIC_FETCH_ADD(&driver->readers[slot], 1);
+    // 计数先于随后读取索引表对回收者可见，与 dev_reclaim 中的栅栏配对
+    XF_HAL_ATOMIC_FENCE();
+    return slot;
+}
+
+static inline void dev_read_end(xf_hal_driver_t *driver, uint32_t slot)
+{
+    XF_HAL_ATOMIC_FETCH_ADD(&driver->readers[slot], (uint32_t)-1);
+}
+
+/**
+ * @brief 回收已关闭的设备，须在持有 driver->mutex 时调用。
+ *
+ * 在 epoch 为 e 时关闭的设备存放在 retired[e & 1]。能看到它的读者要么在它被摘除前进入了
+ * readers[e & 1]，要么更早进入了 readers[(e - 1) & 1]。回收时上一阶段的读者已全部离开才
+ * 释放上一阶段关闭的设备并推进 epoch，因此设备在两次成功的回收之后释放，读者从不等待，
+ * 回收者也不会因持续有新的读者而无法推进。
+ *
+ * @return true 推进了 epoch；false 上一阶段仍有读者，本次未释放。
+ */
+static bool dev_reclaim(xf_hal_driver_t *driver)
+{
+    uint32_t prev = (driver->epoch & 1) ^ 1;
     xf_hal_dev_t *dev = NULL;
+    xf_hal_dev_t *next = NULL;
+
+    // 摘除设备先于读取读者计数，与 dev_read_begin 中的栅栏配对
+    XF_HAL_ATOMIC_FENCE();
+    if (XF_HAL_ATOMIC_LOAD(&driver->readers[prev]) != 0) {
+        return false;
+    }
+
+    xf_list_for_each_entry_safe(dev, next, &driver->retired[prev], xf_hal_dev_t, node) {
+        xf_list_del_init(&dev->node);
+        xf_hal_pool_free(driver->pool, dev);
+    }
+    XF_HAL_ATOMIC_STORE(&driver->epoch, driver->epoch + 1);
+
+    return true;
+}
+
+static xf_err_t dev_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    xf_hal_driver_t *driver = &dev_table[dev->type];
+    bool shadow = (driver->fields != NULL && cmd != XF_HAL_DEV_CMD_DEFAULT);
+
+    if (shadow && cmd != XF_HAL_DEV_CMD_ALL) {
+        cmd = dev_shadow_diff(driver, dev, cmd, config);
+        if (cmd == 0) {
+            XF_HAL_ATOMIC_FETCH_ADD(&driver->suppressed, 1);
+            return XF_OK;
+        }
+    }
+#endif
+
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    xf_err_t err = DEV_PORT_IOCTL(dev, cmd, config);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_IOCTL, dev, trace_start, cmd, err);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_IOCTL, stats_start, (err == XF_OK) ? 0 : -1);
+#if XF_HAL_STATS_IS_ENABLE
+    xf_hal_stats_record_cmd(&dev->stats, cmd);
+#endif
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+    if (shadow && err == XF_OK) {
+        dev_shadow_update(driver, dev, cmd, config);
+    }
+#endif
+
+    return err;
+}
+
+static bool dev_config_defer(xf_hal_dev_t *dev, uint32_t cmd)
+{
+    // 配置事务进行中或设备配置尚未提交时，只记录命令，不调用驱动
+    if (!XF_HAL_ATOMIC_LOAD_RELAXED(&dev->batch) && !XF_HAL_ATOMIC_LOAD_RELAXED(&dev->dirty)) {
+        return false;
+    }
+
+    bool deferred = false;
 
 #if XF_HAL_LOCK_IS_ENABLE
-    xf_lock_lock(dev_table[type].mutex);
+    xf_lock_lock(dev->mutex);
+#endif
+
+    if (dev->batch || dev->dirty) {
+        dev->dirty |= cmd;
+        deferred = true;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->mutex);
+#endif
+
+    return deferred;
+}
+
+// 请求队列的临界区，xf_hal_driver_complete 可在中断中调用时为关中断，见 XF_HAL_REQ_CRITICAL_ENTER
+static inline uint32_t dev_req_lock(xf_hal_dev_t *dev)
+{
+#if XF_HAL_REQ_CRITICAL_IS_ENABLE
+    UNUSED(dev);
+    return (uint32_t)XF_HAL_REQ_CRITICAL_ENTER();
+#elif XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev->mutex);
+    return 0;
+#else
+    UNUSED(dev);
+    return 0;
 #endif
+}
+
+static inline void dev_req_unlock(xf_hal_dev_t *dev, uint32_t state)
+{
+#if XF_HAL_REQ_CRITICAL_IS_ENABLE
+    UNUSED(dev);
+    XF_HAL_REQ_CRITICAL_EXIT(state);
+#elif XF_HAL_LOCK_IS_ENABLE
+    UNUSED(state);
+    xf_lock_unlock(dev->mutex);
+#else
+    UNUSED(dev);
+    UNUSED(state);
+#endif
+}
+
+static void dev_req_start(xf_hal_dev_t *dev)
+{
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    xf_hal_req_prepare_t prepare = dev_table[dev->type].req_prepare;
+
+    // 同一设备同时只有一个请求交给驱动，其余请求在队列中等待
+    for (;;) {
+        xf_hal_req_t *req = NULL;
+
+        uint32_t lock_state = dev_req_lock(dev);
+
+        if (dev->req_active == NULL && !xf_list_empty(&dev->req_queue)) {
+            req = xf_list_first_entry(&dev->req_queue, xf_hal_req_t, node);
+            xf_list_del_init(&req->node);
+            req->state = XF_HAL_REQ_STATE_ACTIVE;
+            dev->req_active = req;
+        }
+
+        dev_req_unlock(dev, lock_state);
+
+        if (req == NULL) {
+            return;
+        }
+
+        // 设置了接收缓冲区时读请求直接从缓冲区完成。
+        // 异步驱动在 submit 中直接读取请求携带的参数，完成中断里启动下一个请求时不加锁、不调用 ioctl
+        if (ops->submit != NULL && !(req->dir == XF_HAL_REQ_DIR_READ && dev->rx_ring != NULL)) {
+            xf_err_t err = ops->submit(dev, req);
+            if (err == XF_OK) {
+                return;
+            }
+            XF_LOGE(TAG, "driver submit failed:%d!", (int)err);
+            dev_req_finish(dev, req, XF_HAL_REQ_STATE_DONE, (err > 0) ? -err : err);
+            continue;
+        }
+
+        // 同步完成时参数经配置下发，轮到该请求时才下发，排队的请求互不覆盖
+        if (prepare != NULL) {
+            xf_err_t err = prepare(dev, req);
+            if (err != XF_OK) {
+                XF_LOGE(TAG, "req prepare failed:%d!", (int)err);
+                dev_req_finish(dev, req, XF_HAL_REQ_STATE_DONE, (err > 0) ? -err : err);
+                continue;
+            }
+        }
+
+        // 驱动不支持异步时同步完成
+        int ret = (req->dir == XF_HAL_REQ_DIR_WRITE) ?
+                  DEV_PORT_WRITE(dev, req->buf, req->count) :
+                  DEV_RX_READ(dev, req->buf, req->count);
+        dev_req_finish(dev, req, XF_HAL_REQ_STATE_DONE, ret);
+    }
+}
+
+static bool dev_req_finish(xf_hal_dev_t *dev, xf_hal_req_t *req, uint8_t state, int result)
+{
+    bool finished = false;
+
+    uint32_t lock_state = dev_req_lock(dev);
+
+    if (dev->req_active == req) {
+        dev->req_active = NULL;
+        req->result = result;
+        req->state = state;
+        finished = true;
+    }
+
+    dev_req_unlock(dev, lock_state);
+
+    if (finished && req->cb) {
+        // 回调中可能重新初始化并提交该请求，追踪记录完成时的长度
+        size_t count = req->count;
+        UNUSED(count);
+        XF_HAL_TRACE_BEGIN(trace_start);
+        req->cb(req);
+        XF_HAL_TRACE_END(XF_HAL_TRACE_EV_CALLBACK, dev, trace_start, count, result);
+    }
 
-    xf_list_t *dev_list = &dev_table[type].dev_list;
-    xf_list_for_each_entry(dev, dev_list, xf_hal_dev_t, node) {
-        if (dev->id == id) {
+    return finished;
+}
+
+static void dev_req_cancel_all(xf_hal_dev_t *dev)
+{
+    for (;;) {
+        xf_hal_req_t *req = NULL;
+
+        uint32_t lock_state = dev_req_lock(dev);
+
+        if (!xf_list_empty(&dev->req_queue)) {
+            req = xf_list_first_entry(&dev->req_queue, xf_hal_req_t, node);
+        }
+
+        dev_req_unlock(dev, lock_state);
+
+        if (req == NULL) {
             break;
         }
+        xf_hal_driver_cancel(dev, req);
     }
 
+    const xf_driver_ops_t *ops = &dev_table[dev->type].driver_ops;
+    xf_hal_req_t *active = dev->req_active;
+    if (active != NULL && ops->cancel != NULL) {
+        xf_hal_driver_cancel(dev, active);
+    }
+}
+
+static void dev_rx_poll_update(xf_hal_dev_t *dev, xf_hal_ring_t *ring)
+{
+#if XF_HAL_POSIX_IS_ENABLE
+    if (xf_hal_ring_used(ring) == 0) {
+        xf_hal_driver_poll_clear(dev, XF_HAL_POLLIN);
+        // 清除前刚写入的数据已置位过 POLLIN，重新检查避免丢失就绪事件
+        if (xf_hal_ring_used(ring) != 0) {
+            xf_hal_driver_poll_set(dev, XF_HAL_POLLIN);
+        }
+    }
+#else
+    UNUSED(dev);
+    UNUSED(ring);
+#endif
+}
+
+#if XF_HAL_SHADOW_CONFIG_IS_ENABLE
+static uint32_t dev_shadow_diff(xf_hal_driver_t *driver, xf_hal_dev_t *dev, uint32_t cmd, const void *config)
+{
+    // 没有字段描述的命令位无法比较，一律保留
+    uint32_t covered = 0;
+    uint32_t changed = 0;
+
 #if XF_HAL_LOCK_IS_ENABLE
-    xf_lock_unlock(dev_table[type].mutex);
+    xf_lock_lock(dev->mutex);
 #endif
 
-    if (&dev->node == dev_list) {
-        dev = NULL;
+    for (uint32_t i = 0; i < driver->field_num; i++) {
+        const xf_hal_config_field_t *field = &driver->fields[i];
+        if (!(field->cmd & cmd)) {
+            continue;
+        }
+        covered |= field->cmd;
+        if (!dev_field_equal(field, config, DEV_SHADOW(driver, dev))) {
+            changed |= field->cmd;
+        }
     }
 
-    return dev;
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->mutex);
+#endif
+
+    return cmd & (changed | ~covered);
 }
 
-/* ==================== [Static Functions] ================================== */
+static void dev_shadow_update(xf_hal_driver_t *driver, xf_hal_dev_t *dev, uint32_t cmd, const void *config)
+{
+    uint8_t *shadow = DEV_SHADOW(driver, dev);
+    const uint8_t *src = (const uint8_t *)config;
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(dev->mutex);
+#endif
+
+    if (cmd == XF_HAL_DEV_CMD_ALL) {
+        memcpy(shadow, src, driver->config_size);
+    } else {
+        for (uint32_t i = 0; i < driver->field_num; i++) {
+            const xf_hal_config_field_t *field = &driver->fields[i];
+            if (!(field->cmd & cmd)) {
+                continue;
+            }
+            if (field->mask == 0) {
+                memcpy(shadow + field->offset, src + field->offset, field->size);
+            } else {
+                // 位域只更新本字段的位，同一个字里其他字段保持已下发的值
+                uint32_t old_word, new_word;
+                memcpy(&old_word, shadow + field->offset, sizeof(old_word));
+                memcpy(&new_word, src + field->offset, sizeof(new_word));
+                old_word = (old_word & ~field->mask) | (new_word & field->mask);
+                memcpy(shadow + field->offset, &old_word, sizeof(old_word));
+            }
+        }
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(dev->mutex);
+#endif
+}
+
+static bool dev_field_equal(const xf_hal_config_field_t *field, const uint8_t *a, const uint8_t *b)
+{
+    if (field->mask == 0) {
+        return memcmp(a + field->offset, b + field->offset, field->size) == 0;
+    }
+
+    uint32_t word_a, word_b;
+    memcpy(&word_a, a + field->offset, sizeof(word_a));
+    memcpy(&word_b, b + field->offset, sizeof(word_b));
+
+    return ((word_a ^ word_b) & field->mask) == 0;
+}
+#endif
+
+#if XF_HAL_STATIC_DISPATCH_IS_ENABLE
+static xf_err_t dev_port_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config)
+{
+    switch (dev->type) {
+#define XF_HAL_TABLE_CASE(dev_name) \
+    case XF_HAL_##dev_name: \
+        return xf_hal_port_##dev_name##_ioctl(dev, cmd, config);
+#include "../device/xf_hal_reg_table.inc"
+#undef XF_HAL_TABLE_CASE
+    default:
+        return XF_ERR_NOT_SUPPORTED;
+    }
+}
+
+static int dev_port_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    switch (dev->type) {
+#define XF_HAL_TABLE_CASE(dev_name) \
+    case XF_HAL_##dev_name: \
+        return xf_hal_port_##dev_name##_read(dev, buf, count);
+#include "../device/xf_hal_reg_table.inc"
+#undef XF_HAL_TABLE_CASE
+    default:
+        return -XF_ERR_NOT_SUPPORTED;
+    }
+}
+
+static int dev_port_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    switch (dev->type) {
+#define XF_HAL_TABLE_CASE(dev_name) \
+    case XF_HAL_##dev_name: \
+        return xf_hal_port_##dev_name##_write(dev, buf, count);
+#include "../device/xf_hal_reg_table.inc"
+#undef XF_HAL_TABLE_CASE
+    default:
+        return -XF_ERR_NOT_SUPPORTED;
+    }
+}
+#endif
@@ -15,6 +15,13 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_hal_kernel_config.h"
+#include "../device/xf_hal_device_config.h"  // 须在类型枚举之前包含，注册表在枚举内展开
+#include "xf_hal_pool.h"
+#include "xf_hal_io.h"
+#include "xf_hal_ring.h"
+#include "xf_hal_stats.h"
+#include "xf_hal_trace.h"
+#include <stddef.h>
 
 /**
  * @ingroup group_xf_hal_internal
@@ -32,6 +39,13 @@ extern "C" {
 #define XF_HAL_DEV_CMD_DEFAULT  0x0
 #define XF_HAL_DEV_CMD_ALL      0x7FFFFFFF
 
+/**
+ * @brief 设备就绪事件，取值与 posix poll 一致，见 xf_hal_driver_poll_set。
+ */
+#define XF_HAL_POLLIN           0x0001  /*!< 可读：收到数据、gpio 边沿、定时器到期 */
+#define XF_HAL_POLLOUT          0x0004  /*!< 可写：发送端有空间 */
+#define XF_HAL_POLLERR          0x0008  /*!< 设备出错 */
+
 /* ==================== [Typedefs] ========================================== */
 
 typedef struct _xf_hal_dev_t xf_hal_dev_t;
@@ -45,6 +59,17 @@ typedef enum _xf_hal_type_t {
 
 typedef xf_hal_dev_t *(*xf_hal_dev_create_t)(uint32_t id);
 
+/**
+ * @brief 设置之后读写的设备地址（如 i2c 从机内存地址），由设备类实现，见 xf_hal_driver_set_seek。
+ */
+typedef xf_err_t (*xf_hal_dev_seek_t)(xf_hal_dev_t *dev, uint32_t offset);
+
+/**
+ * @brief 请求同步完成前下发其传输参数（如 i2c 内存地址与超时），由设备类实现，见 xf_hal_driver_set_req_prepare。
+ *        只在驱动未对接 submit、由任务同步读写时调用，可以加锁并调用 ioctl。
+ */
+typedef xf_err_t (*xf_hal_req_prepare_t)(xf_hal_dev_t *dev, const xf_hal_req_t *req);
+
 typedef enum _xf_hal_flag_t {
     _XF_HAL_FLAG_NOT_USE = 0x00,
     XF_HAL_FLAG_ONLY_READ = 0x01 << 0,
@@ -58,20 +83,61 @@ typedef struct _xf_driver_ops_t {
     int (*read)(xf_hal_dev_t *dev, void *buf, size_t count);
     int (*write)(xf_hal_dev_t *dev, const void *buf, size_t count);
     xf_err_t (*close)(xf_hal_dev_t *dev);
+    int (*readv)(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);         /*!< 可选，为 NULL 时逐段调用 read */
+    int (*writev)(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);        /*!< 可选，为 NULL 时逐段调用 write */
+    xf_err_t (*submit)(xf_hal_dev_t *dev, xf_hal_req_t *req);  /*!< 可选，按 req 中的地址与超时启动异步传输，完成后调用 xf_hal_driver_complete */
+    xf_err_t (*cancel)(xf_hal_dev_t *dev, xf_hal_req_t *req);  /*!< 可选，中止正在进行的异步传输 */
+    int (*read_nonblock)(xf_hal_dev_t *dev, void *buf, size_t count);          /*!< 可选，只取已缓存的数据，没有时返回 0 */
+    int (*write_nonblock)(xf_hal_dev_t *dev, const void *buf, size_t count);   /*!< 可选，只写入发送缓冲能容纳的数据，已满时返回 0 */
 } xf_driver_ops_t;
 
+/**
+ * @brief 配置字段描述，说明某个命令位对应配置结构体中的哪个字段。
+ * 用于影子配置比较字段是否改变。
+ */
+typedef struct _xf_hal_config_field_t {
+    uint32_t cmd;       /*!< 字段对应的命令位 */
+    uint16_t offset;    /*!< 字段在配置结构体中的偏移 */
+    uint16_t size;      /*!< 字段大小，位域字段为所在 uint32_t 的大小 */
+    uint32_t mask;      /*!< 位域字段在所在 uint32_t 中的掩码，非位域字段为 0 */
+} xf_hal_config_field_t;
+
 typedef struct _xf_hal_dev_t {
     xf_list_t node;
     uint32_t type;              /*!< 保存外设类型 */
     uint32_t id;                /*!< id 用于保存设备唯一标识符 */
     void *platform_data;        /*!< 用户通过该参数穿越不同的 ops 之间 */
+    xf_hal_dev_t *hash_next;    /*!< 哈希桶链表，用于 id 较大的设备查找 */
+    const xf_driver_ops_t *ops; /*!< 驱动操作集缓存，用于句柄直接调用 */
+    uint32_t dirty;             /*!< 尚未下发的配置命令，非 0 时后续配置命令继续累积 */
+    uint8_t batch;              /*!< 配置事务嵌套深度，非 0 时配置命令只累积到 dirty */
+    xf_list_t req_queue;        /*!< 等待处理的异步请求队列 */
+    xf_hal_req_t *req_active;   /*!< 正在由驱动处理的异步请求 */
+    xf_hal_ring_t *rx_ring;     /*!< 接收环形缓冲区，非 NULL 时读取只从中取出数据，见 xf_hal_driver_rx_push */
+#if XF_HAL_STATS_IS_ENABLE
+    xf_hal_dev_stats_t stats;   /*!< 读写与 ioctl 统计 */
+#endif
+#if XF_HAL_POSIX_IS_ENABLE
+    uint32_t poll_events;       /*!< 当前就绪事件，由驱动通过 xf_hal_driver_poll_set / clear 维护 */
+#if XF_HAL_LOCK_IS_ENABLE
+    void *seek_mutex;           /*!< 定位与随后的读写之间持有，只在支持按地址访问的设备上创建 */
+#endif
+#endif
 #if XF_HAL_LOCK_IS_ENABLE
     void *mutex;
 #endif
 } xf_hal_dev_t;
 
+typedef void (*xf_hal_device_cb_t)(xf_hal_dev_t *dev, void *user_data);
+
 /* ==================== [Global Prototypes] ================================= */
 
+#if XF_HAL_STATIC_DISPATCH_IS_ENABLE
+// 对接层通过 XF_HAL_PORT_EXPORT 导出的操作函数，如 xf_hal_port_GPIO_write
+#define XF_HAL_TABLE_PORT_OPS
+#include "../device/xf_hal_reg_table.inc"
+#endif
+
 xf_err_t xf_hal_driver_register(xf_hal_type_t type, xf_hal_flag_t flag, xf_hal_dev_create_t constructor,
                                 const xf_driver_ops_t *driver_ops);
 
@@ -80,15 +146,231 @@ xf_hal_dev_t *xf_hal_driver_create(xf_hal_type_t type, uint32_t id);
 
 xf_err_t xf_hal_driver_open(xf_hal_dev_t *dev, xf_hal_type_t type, uint32_t id);
 xf_err_t xf_hal_driver_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config);
+
+/**
+ * @brief 立即下发 ioctl，不受配置事务与延迟配置影响。
+ *        用于读写前必须生效的传输参数（如 i2c 内存地址、超时），其余累积的命令位仍在提交时下发。
+ */
+xf_err_t xf_hal_driver_ioctl_now(xf_hal_dev_t *dev, uint32_t cmd, void *config);
 int xf_hal_driver_read(xf_hal_dev_t *dev, void *buf, size_t count);
 int xf_hal_driver_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+int xf_hal_driver_readv(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
+
+/**
+ * @brief 非阻塞读写，返回实际读写的字节数，无法立即读写时返回 0。
+ *        驱动未实现 read_nonblock / write_nonblock 时，启用 posix 层则按 XF_HAL_POLLIN / XF_HAL_POLLOUT
+ *        判断：未就绪返回 0，就绪时调用阻塞的 read / write；未启用 posix 层时直接调用阻塞接口。
+ */
+int xf_hal_driver_read_nonblock(xf_hal_dev_t *dev, void *buf, size_t count);
+int xf_hal_driver_write_nonblock(xf_hal_dev_t *dev, const void *buf, size_t count);
+int xf_hal_driver_writev(xf_hal_dev_t *dev, const xf_hal_iovec_t *iov, size_t iovcnt);
+xf_err_t xf_hal_driver_submit(xf_hal_dev_t *dev, xf_hal_req_t *req);
+xf_err_t xf_hal_driver_cancel(xf_hal_dev_t *dev, xf_hal_req_t *req);
+
+/**
+ * @brief 驱动完成当前请求，调用请求的回调并启动下一个请求。
+ *        默认请求队列由设备互斥锁保护，只能在任务中调用；在 xf_hal_config.h 中定义
+ *        XF_HAL_REQ_CRITICAL_ENTER / EXIT 为关中断后可直接在 DMA 完成等中断中调用。
+ */
+void xf_hal_driver_complete(xf_hal_dev_t *dev, xf_hal_req_t *req, int result);
 xf_err_t xf_hal_driver_close(xf_hal_dev_t *dev);
+xf_err_t xf_hal_driver_commit(xf_hal_dev_t *dev);
+
+#if XF_HAL_POSIX_IS_ENABLE
+/**
+ * @brief 驱动上报就绪事件（XF_HAL_POLLIN 等），唤醒阻塞在 poll 中的线程。可在中断中调用。
+ *        设备打开时按读写能力默认置位 POLLIN / POLLOUT，能上报就绪状态的驱动应在 open 中先清除。
+ */
+void xf_hal_driver_poll_set(xf_hal_dev_t *dev, uint32_t events);
+
+/**
+ * @brief 驱动清除就绪事件，如接收数据被读空、边沿标志被读取后。可在中断中调用。
+ */
+void xf_hal_driver_poll_clear(xf_hal_dev_t *dev, uint32_t events);
+
+/**
+ * @brief 生成 posix 层的路径解析表并创建 fd 表的锁，由 xf_hal_driver_register 调用，只有第一次调用生效。
+ *        与驱动注册一样须在其他线程调用 open 之前完成。
+ */
+void xf_hal_posix_init(void);
+#else
+#define xf_hal_driver_poll_set(dev, events)     ((void)(dev), (void)(events))
+#define xf_hal_driver_poll_clear(dev, events)   ((void)(dev), (void)(events))
+#define xf_hal_posix_init()                     ((void)0)
+#endif
+
+/**
+ * @brief 设置设备的接收环形缓冲区，ring 为 NULL 时取消。
+ *        设置后 read、readv、非阻塞读与异步读请求都只从缓冲区取出已收到的数据，没有数据时返回 0，
+ *        不再调用驱动的 read；驱动在接收中断中通过 xf_hal_driver_rx_push 写入。
+ *        应在驱动开始写入前设置，取消前需先停止写入。
+ */
+void xf_hal_driver_set_rx_ring(xf_hal_dev_t *dev, xf_hal_ring_t *ring);
+
+/**
+ * @brief 驱动写入接收数据，并置位 XF_HAL_POLLIN。可在中断中调用，同一设备只能有一个写入者。
+ *        缓冲区满时丢弃超出的部分并计入溢出计数；未设置接收缓冲区时丢弃全部数据。
+ *
+ * @return uint32_t 实际写入的字节数。
+ */
+uint32_t xf_hal_driver_rx_push(xf_hal_dev_t *dev, const void *data, uint32_t count);
+
+/**
+ * @brief 从接收环形缓冲区取出数据，取空时清除 XF_HAL_POLLIN。设备必须已设置接收缓冲区。
+ */
+int xf_hal_driver_rx_read(xf_hal_dev_t *dev, void *buf, size_t count);
+
+/**
+ * @brief 借出接收环形缓冲区中的全部数据（最多两段），不拷贝。设备必须已设置接收缓冲区。
+ *        见 xf_hal_ring_peek。
+ */
+uint32_t xf_hal_driver_rx_peek(xf_hal_dev_t *dev, xf_hal_iovec_t iov[2]);
+
+/**
+ * @brief 释放借出数据中最前面的 count 个字节，最多释放上次借出的字节数，取空时清除 XF_HAL_POLLIN。
+ *        设备必须已设置接收缓冲区。见 xf_hal_ring_consume。
+ */
+uint32_t xf_hal_driver_rx_consume(xf_hal_dev_t *dev, uint32_t count);
+
+xf_err_t xf_hal_dev_config_begin(xf_hal_dev_t *dev);
+
+/**
+ * @brief 结束配置事务，最外层结束时下发累积的配置。
+ *        不在事务中调用时只下发延迟配置累积的命令，可用于显式下发。
+ */
+xf_err_t xf_hal_dev_config_commit(xf_hal_dev_t *dev);
+
+xf_err_t xf_hal_driver_set_pool(xf_hal_type_t type, xf_hal_pool_t *pool);
+xf_err_t xf_hal_driver_set_fields(xf_hal_type_t type, const xf_hal_config_field_t *fields, uint32_t field_num,
+                                  uint32_t config_size);
+uint32_t xf_hal_driver_get_suppressed_count(xf_hal_type_t type);
+
+/**
+ * @brief 设备类登记地址定位函数，posix 层据此把文件偏移映射为设备地址（pread / pwrite / lseek）。
+ *        未启用 posix 层时不保存，xf_hal_driver_seek_begin 总是返回 XF_ERR_NOT_SUPPORTED。
+ */
+xf_err_t xf_hal_driver_set_seek(xf_hal_type_t type, xf_hal_dev_seek_t seek);
+bool xf_hal_driver_is_seekable(xf_hal_type_t type);
+
+/**
+ * @brief 设备类登记请求参数下发函数。排队的请求各自携带参数，轮到该请求时才下发，
+ *        不会被之后提交的请求覆盖。下发失败时请求以该错误完成。
+ *        对接了 submit 的驱动不经过该函数，须在 submit 中读取 req->addr、addr_en 与 timeout_ms。
+ */
+xf_err_t xf_hal_driver_set_req_prepare(xf_hal_type_t type, xf_hal_req_prepare_t prepare);
+
+/**
+ * @brief 把设备定位到 offset，成功时持有设备的定位锁直到 xf_hal_driver_seek_end，
+ *        期间的读写使用该地址，其他线程的定位等待本次读写完成。失败时不持有锁。
+ *
+ * @return xf_err_t 地址超出设备地址宽度时返回 XF_ERR_INVALID_ARG，设备不支持时返回 XF_ERR_NOT_SUPPORTED。
+ */
+xf_err_t xf_hal_driver_seek_begin(xf_hal_dev_t *dev, uint32_t offset);
+void xf_hal_driver_seek_end(xf_hal_dev_t *dev);
+void xf_hal_config_field_probe(xf_hal_config_field_t *fields, uint32_t field_num, uint32_t cmd,
+                               const void *probe, uint32_t size);
 
 xf_err_t xf_hal_device_add(xf_hal_dev_t *dev);
 xf_hal_dev_t *xf_hal_device_find(xf_hal_type_t type, uint32_t id);
 
+/**
+ * @brief 按类型依次遍历所有已打开的设备。
+ *        回调期间持有设备类型的锁，回调中不能创建或关闭设备。
+ */
+void xf_hal_device_foreach(xf_hal_device_cb_t cb, void *user_data);
+
+/**
+ * @brief 以给定的驱动读函数读取，不做查找与检查。设置了接收缓冲区时从缓冲区取出。
+ *        read 为常量时（如静态分发的对接函数）内联后成为直接调用。
+ */
+static inline int xf_hal_dev_read_with(xf_hal_dev_t *dev, void *buf, size_t count,
+                                       int (*read)(xf_hal_dev_t *dev, void *buf, size_t count))
+{
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    int ret = (dev->rx_ring != NULL) ? xf_hal_driver_rx_read(dev, buf, count) : read(dev, buf, count);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_READ, dev, trace_start, count, ret);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_READ, stats_start, ret);
+    return ret;
+}
+
+/**
+ * @brief 以给定的驱动写函数写入，不做查找与检查。
+ *        write 为常量时（如静态分发的对接函数）内联后成为直接调用。
+ */
+static inline int xf_hal_dev_write_with(xf_hal_dev_t *dev, const void *buf, size_t count,
+                                        int (*write)(xf_hal_dev_t *dev, const void *buf, size_t count))
+{
+    if (dev->dirty) {
+        xf_hal_driver_commit(dev);
+    }
+    XF_HAL_STATS_BEGIN(stats_start);
+    XF_HAL_TRACE_BEGIN(trace_start);
+    int ret = write(dev, buf, count);
+    XF_HAL_TRACE_END(XF_HAL_TRACE_EV_WRITE, dev, trace_start, count, ret);
+    XF_HAL_STATS_END(&dev->stats, XF_HAL_STATS_OP_WRITE, stats_start, ret);
+    return ret;
+}
+
+/**
+ * @brief 直接调用设备缓存的驱动读函数，不做查找与检查。
+ *        仅用于句柄等已确认设备有效的快速路径。
+ */
+static inline int xf_hal_dev_read(xf_hal_dev_t *dev, void *buf, size_t count)
+{
+    return xf_hal_dev_read_with(dev, buf, count, dev->ops->read);
+}
+
+/**
+ * @brief 直接调用设备缓存的驱动写函数，不做查找与检查。
+ *        仅用于句柄等已确认设备有效的快速路径。
+ */
+static inline int xf_hal_dev_write(xf_hal_dev_t *dev, const void *buf, size_t count)
+{
+    return xf_hal_dev_write_with(dev, buf, count, dev->ops->write);
+}
+
 /* ==================== [Macros] ============================================ */
 
+/**
+ * @brief 设备类的快速读写，name 为注册表中的类型名（GPIO、UART 等）。
+ *        开启静态分发时直接调用对接层导出的函数，否则同 xf_hal_dev_read / xf_hal_dev_write。
+ */
+#if XF_HAL_STATIC_DISPATCH_IS_ENABLE
+#define XF_HAL_DEV_READ(name, dev, buf, count) \
+    xf_hal_dev_read_with((dev), (buf), (count), xf_hal_port_##name##_read)
+#define XF_HAL_DEV_WRITE(name, dev, buf, count) \
+    xf_hal_dev_write_with((dev), (buf), (count), xf_hal_port_##name##_write)
+#else
+#define XF_HAL_DEV_READ(name, dev, buf, count)  xf_hal_dev_read((dev), (buf), (count))
+#define XF_HAL_DEV_WRITE(name, dev, buf, count) xf_hal_dev_write((dev), (buf), (count))
+#endif
+
+/**
+ * @brief 普通字段描述。
+ */
+#define XF_HAL_CONFIG_FIELD(cmd, type, member) \
+    { (cmd), (uint16_t)offsetof(type, member), (uint16_t)sizeof(((type *)0)->member), 0 }
+
+/**
+ * @brief 位域字段描述。偏移和掩码需要通过 XF_HAL_CONFIG_BITS_PROBE 在运行时填充。
+ */
+#define XF_HAL_CONFIG_BITS(cmd) \
+    { (cmd), 0, (uint16_t)sizeof(uint32_t), 0 }
+
+/**
+ * @brief 填充位域字段描述的偏移和掩码。
+ */
+#define XF_HAL_CONFIG_BITS_PROBE(fields, cmd, type, member) \
+    do { \
+        type _probe = {0}; \
+        _probe.member = _probe.member - 1; \
+        xf_hal_config_field_probe((fields), sizeof(fields) / sizeof((fields)[0]), (cmd), &_probe, sizeof(_probe)); \
+    } while (0)
+
 #ifdef __cplusplus
 } /* extern "C" */
 #endif
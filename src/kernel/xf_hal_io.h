@@ -0,0 +1,130 @@
+/**
+ * @file xf_hal_io.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 设备读写公共类型，包括分散/聚集读写和异步请求。
+ * @version 0.1
+ * @date 2024-07-18
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+#ifndef __XF_HAL_IO_H__
+#define __XF_HAL_IO_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "../xf_hal_config_internal.h"
+
+/**
+ * @ingroup group_xf_hal_user
+ * @defgroup group_xf_hal_user_io io
+ * @brief 设备读写公共类型。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 分散/聚集读写的数据段。
+ */
+typedef struct _xf_hal_iovec_t {
+    void *buf;      /*!< 数据段指针，写入时只读 */
+    size_t count;   /*!< 数据段长度 */
+} xf_hal_iovec_t;
+
+/**
+ * @brief 异步请求的传输方向。
+ */
+typedef enum _xf_hal_req_dir_t {
+    XF_HAL_REQ_DIR_READ = 0,    /*!< 读取 */
+    XF_HAL_REQ_DIR_WRITE,       /*!< 写入 */
+} xf_hal_req_dir_t;
+
+/**
+ * @brief 异步请求的状态。
+ */
+typedef enum _xf_hal_req_state_t {
+    XF_HAL_REQ_STATE_IDLE = 0,  /*!< 未提交 */
+    XF_HAL_REQ_STATE_PENDING,   /*!< 已提交，在设备请求队列中等待 */
+    XF_HAL_REQ_STATE_ACTIVE,    /*!< 已交给驱动，正在传输 */
+    XF_HAL_REQ_STATE_DONE,      /*!< 已完成，结果见 result */
+    XF_HAL_REQ_STATE_CANCELED,  /*!< 已取消 */
+} xf_hal_req_state_t;
+
+typedef struct _xf_hal_req_t xf_hal_req_t;
+
+/**
+ * @brief 异步请求完成回调。
+ *
+ * @note 驱动不支持异步时，请求由正在处理该设备请求队列的任务同步完成，
+ * 通常即提交者自身；否则在驱动调用 xf_hal_driver_complete 的上下文中被调用，
+ * 定义了 XF_HAL_REQ_CRITICAL_ENTER 时可能是中断。回调中可以再次提交该请求。
+ *
+ * @param req 完成的请求。
+ */
+typedef void (*xf_hal_req_cb_t)(xf_hal_req_t *req);
+
+/**
+ * @brief 异步请求。请求对象由调用者持有，在完成或取消之前不能释放或修改。
+ */
+struct _xf_hal_req_t {
+    xf_list_t node;             /*!< 内部使用，挂载到设备的请求队列 */
+    void *buf;                  /*!< 数据指针，写入时只读 */
+    size_t count;               /*!< 数据长度 */
+    uint8_t dir;                /*!< 传输方向，见 @ref xf_hal_req_dir_t */
+    volatile uint8_t state;     /*!< 请求状态，见 @ref xf_hal_req_state_t */
+    int result;                 /*!< 完成结果，非负数为实际传输大小，负数为错误码 */
+    xf_hal_req_cb_t cb;         /*!< 完成回调，可为 NULL */
+    void *user_data;            /*!< 用户数据 */
+    uint32_t addr;              /*!< 设备地址（如 i2c 从机内存地址），addr_en 非 0 时有效，由 xf_hal_xxx_submit 填写，驱动的 submit 读取 */
+    uint32_t timeout_ms;        /*!< 传输超时，由 xf_hal_xxx_submit 填写，驱动的 submit 读取 */
+    uint8_t addr_en;            /*!< 传输前先发送 addr */
+};
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化异步请求。
+ *
+ * @param req 请求。
+ * @param dir 传输方向，见 @ref xf_hal_req_dir_t.
+ * @param buf 数据指针。
+ * @param count 数据长度。
+ * @param cb 完成回调，可为 NULL。
+ * @param user_data 用户数据。
+ */
+static inline void xf_hal_req_init(xf_hal_req_t *req, xf_hal_req_dir_t dir, void *buf, size_t count,
+                                   xf_hal_req_cb_t cb, void *user_data)
+{
+    xf_list_init(&req->node);
+    req->buf = buf;
+    req->count = count;
+    req->dir = (uint8_t)dir;
+    req->state = XF_HAL_REQ_STATE_IDLE;
+    req->result = 0;
+    req->cb = cb;
+    req->user_data = user_data;
+    req->addr = 0;
+    req->timeout_ms = 0;
+    req->addr_en = 0;
+}
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_hal_user_io
+ * @}
+ */
+
+#endif // __XF_HAL_IO_H__
@@ -34,6 +34,132 @@ extern "C" {
 #   define XF_HAL_POSIX_IS_ENABLE  (1)
 #endif
 
+/**
+ * @brief posix 层同时打开的文件描述符数量，同一设备的每次 open 各占一个。
+ */
+#if !defined(XF_HAL_POSIX_FD_MAX)
+#   define XF_HAL_POSIX_FD_MAX     (16)
+#endif
+
+/**
+ * @brief posix 层分配的第一个文件描述符，默认跳过标准输入、输出与错误。
+ */
+#if !defined(XF_HAL_POSIX_FD_BASE)
+#   define XF_HAL_POSIX_FD_BASE    (3)
+#endif
+
+/**
+ * @brief 延迟配置。开启后创建设备时只填充默认参数，之后的配置命令先累积在设备中，
+ * 直到 enable、首次读写或调用 xf_hal_driver_commit 时合并为一次 ioctl 下发。
+ */
+#if (!defined(XF_HAL_DEFERRED_CONFIG_ENABLE))||(!XF_HAL_DEFERRED_CONFIG_ENABLE)
+#   define XF_HAL_DEFERRED_CONFIG_IS_ENABLE  (0)
+#else
+#   define XF_HAL_DEFERRED_CONFIG_IS_ENABLE  (1)
+#endif
+
+/**
+ * @brief 影子配置。开启后 kernel 为每个设备保存一份已下发到驱动的配置，
+ * xf_hal_driver_ioctl 会丢弃对应字段未改变的命令，整条命令都未改变时不再调用驱动。
+ */
+#if (!defined(XF_HAL_SHADOW_CONFIG_ENABLE))||(!XF_HAL_SHADOW_CONFIG_ENABLE)
+#   define XF_HAL_SHADOW_CONFIG_IS_ENABLE  (0)
+#else
+#   define XF_HAL_SHADOW_CONFIG_IS_ENABLE  (1)
+#endif
+
+/**
+ * @brief 设备统计。开启后 kernel 在读写和 ioctl 路径上为每个设备记录调用次数、字节数、
+ * 错误次数、各命令位的 ioctl 次数以及按 2 的幂分桶的耗时直方图。
+ */
+#if (!defined(XF_HAL_STATS_ENABLE))||(!XF_HAL_STATS_ENABLE)
+#   define XF_HAL_STATS_IS_ENABLE  (0)
+#else
+#   define XF_HAL_STATS_IS_ENABLE  (1)
+#endif
+
+/**
+ * @brief 耗时直方图的桶数。第 0 桶记录耗时为 0 的调用，第 n 桶记录耗时在 [2^(n-1), 2^n) 的调用，
+ * 最后一个桶同时记录更长的耗时。
+ */
+#if !defined(XF_HAL_STATS_HIST_SIZE)
+#   define XF_HAL_STATS_HIST_SIZE  (16)
+#endif
+
+/**
+ * @brief 事件跟踪。开启后 kernel 把设备的 open、ioctl、read、write、close 以及异步请求回调
+ * 记录到固定大小的环形缓冲区中，可导出后在主机端转换为 Chrome trace 格式查看时间线。
+ */
+#if (!defined(XF_HAL_TRACE_ENABLE))||(!XF_HAL_TRACE_ENABLE)
+#   define XF_HAL_TRACE_IS_ENABLE  (0)
+#else
+#   define XF_HAL_TRACE_IS_ENABLE  (1)
+#endif
+
+/**
+ * @brief 事件跟踪环形缓冲区能保存的事件数，必须为 2 的幂。缓冲区满后覆盖最早的事件。
+ */
+#if !defined(XF_HAL_TRACE_SIZE)
+#   define XF_HAL_TRACE_SIZE       (256)
+#endif
+
+/**
+ * @brief 静态分发。只链接一个对接层的固件可开启：各设备类型的 ioctl、read、write 在链接时绑定到
+ * 对接层通过 XF_HAL_PORT_EXPORT 导出的具名函数，不再经过 dev_table 中的函数指针，
+ * 配合 LTO 可把对接函数内联进设备接口。开启后注册表中的每个类型都必须由对接层导出。
+ */
+#if (!defined(XF_HAL_STATIC_DISPATCH_ENABLE))||(!XF_HAL_STATIC_DISPATCH_ENABLE)
+#   define XF_HAL_STATIC_DISPATCH_IS_ENABLE  (0)
+#else
+#   define XF_HAL_STATIC_DISPATCH_IS_ENABLE  (1)
+#endif
+
+/**
+ * @brief 异步请求队列的临界区。驱动在中断中调用 xf_hal_driver_complete 时，
+ * 须在 xf_hal_config.h 中同时定义 XF_HAL_REQ_CRITICAL_ENTER 与 XF_HAL_REQ_CRITICAL_EXIT 为关中断与恢复中断。
+ * ENTER 返回关中断前的状态（可转换为 uint32_t），EXIT 以该状态为参数恢复，任务与中断中均可调用，例如：
+ * @code
+ * #define XF_HAL_REQ_CRITICAL_ENTER()       taskENTER_CRITICAL_FROM_ISR()
+ * #define XF_HAL_REQ_CRITICAL_EXIT(state)   taskEXIT_CRITICAL_FROM_ISR(state)
+ * @endcode
+ * 未定义时请求队列由设备互斥锁保护，xf_hal_driver_complete 只能在任务中调用。
+ */
+#if defined(XF_HAL_REQ_CRITICAL_ENTER) && defined(XF_HAL_REQ_CRITICAL_EXIT)
+#   define XF_HAL_REQ_CRITICAL_IS_ENABLE  (1)
+#else
+#   define XF_HAL_REQ_CRITICAL_IS_ENABLE  (0)
+#endif
+
+/**
+ * @brief 判断当前是否处于中断上下文（如读取 Cortex-M 的 IPSR）。定义后，未定义请求队列临界区时
+ * 在中断中调用 xf_hal_driver_complete 会报错返回，而不是在中断中获取互斥锁。
+ */
+#if !defined(XF_HAL_IN_ISR)
+#   define XF_HAL_IN_ISR()         (0)
+#endif
+
+/**
+ * @brief 设备索引表大小。id 小于该值的设备直接通过数组下标查找。
+ */
+#if !defined(XF_HAL_DEV_INDEX_SIZE)
+#   define XF_HAL_DEV_INDEX_SIZE   (32)
+#endif
+
+/**
+ * @brief 设备哈希桶数量。id 大于等于 XF_HAL_DEV_INDEX_SIZE 的设备通过哈希桶查找。
+ */
+#if !defined(XF_HAL_DEV_HASH_SIZE)
+#   define XF_HAL_DEV_HASH_SIZE    (16)
+#endif
+
+/**
+ * @brief 缓存行大小。环形缓冲区的生产者与消费者字段之间按此大小填充，避免两端写入同一缓存行；
+ * 没有数据缓存的单核 MCU 可设为 0 以节省内存。
+ */
+#if !defined(XF_HAL_CACHE_LINE_SIZE)
+#   define XF_HAL_CACHE_LINE_SIZE  (64)
+#endif
+
 /* ==================== [Typedefs] ========================================== */
 
 /* ==================== [Global Prototypes] ================================= */
@@ -0,0 +1,114 @@
+/**
+ * @file xf_hal_pool.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 固定大小对象池。
+ * @version 0.1
+ * @date 2024-07-16
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_pool.h"
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "hal_pool"
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static bool pool_owns(const xf_hal_pool_t *pool, const void *ptr);
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_hal_pool_init(xf_hal_pool_t *pool)
+{
+    XF_ASSERT(pool, XF_ERR_INVALID_ARG, TAG, "pool must not be NULL");
+
+#if XF_HAL_LOCK_IS_ENABLE
+    if (pool->mutex == NULL) {
+        xf_err_t err = xf_lock_init(&pool->mutex);
+        XF_ASSERT(!err, err, TAG, "lock init failed!");
+    }
+#endif
+
+    return XF_OK;
+}
+
+void *xf_hal_pool_alloc(xf_hal_pool_t *pool)
+{
+    XF_ASSERT(pool, NULL, TAG, "pool must not be NULL");
+
+    void *block = NULL;
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(pool->mutex);
+#endif
+
+    if (pool->free_list != NULL) {
+        block = pool->free_list;
+        pool->free_list = *(void **)block;
+    } else if (pool->used < pool->block_num) {
+        block = pool->buf + (uint32_t)pool->used * pool->block_size;
+        pool->used++;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(pool->mutex);
+#endif
+
+    if (block == NULL) {
+        if (pool->block_num != 0) {
+            XF_LOGD(TAG, "pool exhausted, fall back to heap");
+        }
+        block = xf_malloc(pool->block_size);
+    }
+
+    return block;
+}
+
+void xf_hal_pool_free(xf_hal_pool_t *pool, void *ptr)
+{
+    if (ptr == NULL) {
+        return;
+    }
+
+    if (pool == NULL || !pool_owns(pool, ptr)) {
+        xf_free(ptr);
+        return;
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(pool->mutex);
+#endif
+
+    *(void **)ptr = pool->free_list;
+    pool->free_list = ptr;
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(pool->mutex);
+#endif
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static bool pool_owns(const xf_hal_pool_t *pool, const void *ptr)
+{
+    const uint8_t *p = (const uint8_t *)ptr;
+
+    if (p < pool->buf || p >= pool->buf + (uint32_t)pool->block_num * pool->block_size) {
+        return false;
+    }
+
+    XF_ASSERT((uint32_t)(p - pool->buf) % pool->block_size == 0, false, TAG, "ptr is not a pool block");
+
+    return true;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file xf_hal_pool.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 固定大小对象池。
+ * @version 0.1
+ * @date 2024-07-16
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 对象池在编译期分配存储区，分配与释放均为 O(1)。
+ * 对象池耗尽时自动退回 xf_malloc 分配，释放时根据地址自动区分。
+ * 用法：
+ * @code
+ * XF_HAL_POOL_DEFINE(s_pool, sizeof(my_obj_t), 8);
+ * xf_hal_pool_init(&s_pool);
+ * my_obj_t *obj = xf_hal_pool_alloc(&s_pool);
+ * xf_hal_pool_free(&s_pool, obj);
+ * @endcode
+ */
+
+#ifndef __XF_HAL_POOL_H__
+#define __XF_HAL_POOL_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+
+/**
+ * @ingroup group_xf_hal_internal
+ * @defgroup group_xf_hal_internal_pool pool
+ * @brief 固定大小对象池。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _xf_hal_pool_t {
+    void *free_list;        /*!< 已释放块组成的空闲链表 */
+    uint8_t *buf;           /*!< 块存储区 */
+    uint32_t block_size;    /*!< 块大小，按指针大小对齐 */
+    uint16_t block_num;     /*!< 块数量，为 0 时所有分配都使用堆 */
+    uint16_t used;          /*!< 已从存储区切分出的块数量 */
+#if XF_HAL_LOCK_IS_ENABLE
+    void *mutex;
+#endif
+} xf_hal_pool_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+xf_err_t xf_hal_pool_init(xf_hal_pool_t *pool);
+void *xf_hal_pool_alloc(xf_hal_pool_t *pool);
+void xf_hal_pool_free(xf_hal_pool_t *pool, void *ptr);
+
+/* ==================== [Macros] ============================================ */
+
+#define XF_HAL_POOL_BLOCK_WORDS(size) (((size) + sizeof(void *) - 1) / sizeof(void *))
+
+/**
+ * @brief 定义一个静态对象池。
+ *
+ * @param name 对象池变量名。
+ * @param size 单个对象大小。
+ * @param num 对象数量，为 0 时不占用存储区。
+ */
+#define XF_HAL_POOL_DEFINE(name, size, num) \
+    static void *name##_buf[((num) > 0) ? XF_HAL_POOL_BLOCK_WORDS(size) * (num) : 1]; \
+    static xf_hal_pool_t name = { \
+        .free_list = NULL, \
+        .buf = (uint8_t *)name##_buf, \
+        .block_size = XF_HAL_POOL_BLOCK_WORDS(size) * sizeof(void *), \
+        .block_num = (num), \
+        .used = 0, \
+    }
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_hal_internal_pool
+ * @}
+ */
+
+#endif // __XF_HAL_POOL_H__
@@ -17,13 +17,17 @@
 
 #include "xf_hal_posix.h"
 #include "xf_hal_dev.h"
+#include "xf_hal_atomic.h"
 #include <stdarg.h>
+#include <string.h>
 
 /* ==================== [Defines] =========================================== */
 
 #define DEV_STR_NUM (sizeof(dev_str) / sizeof(const char *))
 #define TAG "hal_posix"
 
+#define NAME_HASH_SIZE  32  /*!< 类型名哈希表大小，需为 2 的幂且大于外设类型数量 */
+
 /* ==================== [Typedefs] ========================================== */
 
 typedef struct dev_name_t {
@@ -31,11 +35,29 @@ typedef struct dev_name_t {
     uint16_t id;
 } dev_name_t;
 
+/**
+ * @brief 文件描述符表项。dev 非空表示该 fd 已打开，读写路径只读取表项，不查找设备。
+ */
+typedef struct _xf_hal_fd_t {
+    xf_hal_dev_t *dev;  /*!< open 时解析出的设备 */
+    int flags;          /*!< open 时的 flags */
+    uint32_t pos;       /*!< 当前位置，读写成功后累加 */
+    bool owner;         /*!< 设备由 posix 层创建，最后一个引用关闭时负责关闭设备 */
+    bool seekable;      /*!< 设备支持按地址读写 */
+    bool positioned;    /*!< 已通过 lseek 定位，read / write 前先把设备定位到 pos；否则不改变设备地址 */
+} xf_hal_fd_t;
+
 /* ==================== [Static Prototypes] ================================= */
 
-static const char *is_prefix(const char *substr, const char *str);
-static bool _atoi(const char *src, uint16_t *num);
+static uint32_t name_hash(const char *name, size_t len);
 static bool name_to_type_and_id(const char *pathname, uint16_t *type, uint16_t *id);
+static bool flags_check(xf_hal_flag_t hal_flag, int flags);
+static xf_hal_fd_t *fd_get(int fd);
+static int fd_seek_begin(xf_hal_fd_t *file, bool positioned, uint32_t offset);
+static void fd_seek_end(xf_hal_fd_t *file, bool positioned);
+static int fd_write(xf_hal_fd_t *file, const void *buf, size_t count, bool positioned, uint32_t offset);
+static int fd_read(xf_hal_fd_t *file, void *buf, size_t count, bool positioned, uint32_t offset);
+static int poll_scan(struct pollfd *fds, nfds_t nfds);
 
 /* ==================== [Static Variables] ================================== */
 
@@ -44,11 +66,28 @@ static const char *dev_str[] = {
 #include "../device/xf_hal_reg_table.inc"
 };
 
+// 类型名到类型的开放寻址哈希表，存放 type + 1，0 表示空；第一个驱动注册时由 dev_str 生成，之后只读
+static uint8_t s_name_table[NAME_HASH_SIZE] = {0};
+static bool s_name_ready = false;
+typedef char name_table_size_check[(NAME_HASH_SIZE > DEV_STR_NUM) ? 1 : -1];
+
+static xf_hal_fd_t s_fd_table[XF_HAL_POSIX_FD_MAX] = {0};
+static size_t s_fd_hint = 0;    // 该下标之前的表项都已占用
+static size_t s_fd_top = 0;     // 该下标及之后的表项从未使用过
+
+#if XF_HAL_LOCK_IS_ENABLE
+// 只保护 fd 的分配与释放，读写路径不加锁
+static void *s_fd_mutex = NULL;
+#endif
+
+static xf_hal_poll_wait_t s_poll_wait = NULL;
+static xf_hal_poll_wake_t s_poll_wake = NULL;
+static uint32_t s_poll_seq = 0;     // 每次上报就绪事件加一，poll 据此判断扫描期间是否有新事件
+
 /* ==================== [Macros] ============================================ */
 
-#define FD_TO_ID(fd) ((fd) & 0xffff)
-#define FD_TO_TYPE(fd) (((fd) >> 16) & 0xffff)
-#define TYPE_ID_TO_FD(type, id) (((type) << 16) | (id))
+#define FD_TO_INDEX(fd) ((fd) - XF_HAL_POSIX_FD_BASE)
+#define INDEX_TO_FD(index) ((int)(index) + XF_HAL_POSIX_FD_BASE)
 
 /* ==================== [Global Functions] ================================== */
 
@@ -56,51 +95,70 @@ int open(const char *pathname, int flags)
 {
     uint16_t type;
     uint16_t id;
-    xf_hal_flag_t hal_flag;
-    int fp;
+    int fd = -1;
+    bool owner = false;
 
     if (!name_to_type_and_id(pathname, &type, &id)) {
         XF_LOGE(TAG, "pathname not paser to type and id");
         XF_LOGE(TAG, "pathname: %s", pathname);
-        XF_LOGE(TAG, "type: %d", type);
-        XF_LOGE(TAG, "type: %d", id);
         return -1;
     }
 
-    xf_hal_dev_t *dev = xf_hal_driver_create(type, id);
-    if (dev == NULL) {
-        XF_LOGE(TAG, "open failed!");
-        XF_LOGE(TAG, "type: %d", type);
-        XF_LOGE(TAG, "type: %d", id);
+    if (!flags_check(xf_hal_driver_get_flag(type), flags)) {
+        XF_LOGE(TAG, "flags error!");
+        XF_LOGE(TAG, "flags:%d", flags);
         return -1;
     }
 
-    fp = TYPE_ID_TO_FD(type, id);
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(s_fd_mutex);
+#endif
 
-    hal_flag = xf_hal_driver_get_flag(type);
+    // 与 posix 一致分配最小的空闲 fd
+    size_t index = s_fd_hint;
+    while (index < XF_HAL_POSIX_FD_MAX && s_fd_table[index].dev != NULL) {
+        index++;
+    }
+    s_fd_hint = index;
 
-    if (BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_READ) &&
-            !BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_WRITE) &&
-            flags == O_RDONLY) {
-        return fp;
+    if (index == XF_HAL_POSIX_FD_MAX) {
+        XF_LOGE(TAG, "no free fd!");
+        goto out;
     }
 
-    if (!BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_READ) &&
-            BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_WRITE) &&
-            flags == O_WRONLY) {
-        return fp;
+    // 同一设备可以被多次打开，已存在的设备（包括通过 xf_hal_xxx_init 创建的）直接引用
+    xf_hal_dev_t *dev = xf_hal_device_find(type, id);
+    if (dev == NULL) {
+        dev = xf_hal_driver_create(type, id);
+        owner = true;
     }
 
-    if (BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_READ) &&
-            BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_WRITE) &&
-            flags == O_RDWR) {
+    if (dev == NULL) {
+        XF_LOGE(TAG, "open failed!");
+        XF_LOGE(TAG, "type: %d", type);
+        XF_LOGE(TAG, "id: %d", id);
+        goto out;
+    }
 
-        return fp;
+    s_fd_table[index].flags = flags;
+    s_fd_table[index].pos = 0;
+    s_fd_table[index].owner = owner;
+    s_fd_table[index].seekable = xf_hal_driver_is_seekable(type);
+    s_fd_table[index].positioned = false;
+    XF_HAL_ATOMIC_STORE(&s_fd_table[index].dev, dev);
+    fd = INDEX_TO_FD(index);
+
+    s_fd_hint = index + 1;
+    if (s_fd_top < s_fd_hint) {
+        s_fd_top = s_fd_hint;
     }
 
-    XF_LOGE(TAG, "flags error!");
-    XF_LOGE(TAG, "flags:%d", flags);
-    return -1;
+out:
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(s_fd_mutex);
+#endif
+
+    return fd;
 }
 
 int ioctl(int fd, unsigned long request, ...)
@@ -108,21 +166,17 @@ int ioctl(int fd, unsigned long request, ...)
     int ret = 0;
     va_list args;
     void *arg_in = NULL;
-    uint16_t type = FD_TO_ID(fd);
-    uint16_t id = FD_TO_TYPE(fd);
-    xf_hal_dev_t *dev = xf_hal_device_find(type, id);
+    xf_hal_fd_t *file = fd_get(fd);
 
-    if (dev == NULL) {
-        XF_LOGE(TAG, "not find this device");
-        XF_LOGE(TAG, "type;%d", type);
-        XF_LOGE(TAG, "id;%d", id);
+    if (file == NULL) {
+        return -1;
     }
 
     va_start(args, request);
     arg_in = va_arg(args, void *);
     va_end(args);
 
-    ret = xf_hal_driver_ioctl(dev, request, arg_in);
+    ret = xf_hal_driver_ioctl(file->dev, request, arg_in);
     if (ret) {
         XF_LOGE(TAG, "ioctl failed!");
     }
@@ -132,20 +186,15 @@ int ioctl(int fd, unsigned long request, ...)
 
 size_t write(int fd, const void *buf, size_t count)
 {
-    int ret = 0;
-    uint16_t type = FD_TO_ID(fd);
-    uint16_t id = FD_TO_TYPE(fd);
-    xf_hal_dev_t *dev = xf_hal_device_find(type, id);
+    xf_hal_fd_t *file = fd_get(fd);
 
-    if (dev == NULL) {
-        XF_LOGE(TAG, "not find this device");
-        XF_LOGE(TAG, "type;%d", type);
-        XF_LOGE(TAG, "id;%d", id);
+    if (file == NULL || (file->flags & O_ACCMODE) == O_RDONLY) {
+        return -1;
     }
 
-    ret = xf_hal_driver_write(dev, buf, count);
-    if (ret < 0) {
-        XF_LOGE(TAG, "write failed!");
+    int ret = fd_write(file, buf, count, file->positioned, file->pos);
+    if (ret > 0) {
+        file->pos += ret;
     }
 
     return ret;
@@ -153,88 +202,427 @@ size_t write(int fd, const void *buf, size_t count)
 
 size_t read(int fd, void *buf, size_t count)
 {
-    int ret = 0;
-    uint16_t type = FD_TO_ID(fd);
-    uint16_t id = FD_TO_TYPE(fd);
-    xf_hal_dev_t *dev = xf_hal_device_find(type, id);
+    xf_hal_fd_t *file = fd_get(fd);
 
-    if (dev == NULL) {
-        XF_LOGE(TAG, "not find this device");
-        XF_LOGE(TAG, "type;%d", type);
-        XF_LOGE(TAG, "id;%d", id);
+    if (file == NULL || (file->flags & O_ACCMODE) == O_WRONLY) {
+        return -1;
     }
 
-    ret = xf_hal_driver_read(dev, buf, count);
-    if (ret < 0) {
-        XF_LOGE(TAG, "read failed!");
+    int ret = fd_read(file, buf, count, file->positioned, file->pos);
+    if (ret > 0) {
+        file->pos += ret;
     }
 
     return ret;
 }
 
+size_t pwrite(int fd, const void *buf, size_t count, long offset)
+{
+    xf_hal_fd_t *file = fd_get(fd);
+
+    if (file == NULL || (file->flags & O_ACCMODE) == O_RDONLY) {
+        return -1;
+    }
+
+    if (!file->seekable) {
+        return -ESPIPE;
+    }
+
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    return fd_write(file, buf, count, true, (uint32_t)offset);
+}
+
+size_t pread(int fd, void *buf, size_t count, long offset)
+{
+    xf_hal_fd_t *file = fd_get(fd);
+
+    if (file == NULL || (file->flags & O_ACCMODE) == O_WRONLY) {
+        return -1;
+    }
+
+    if (!file->seekable) {
+        return -ESPIPE;
+    }
+
+    if (offset < 0) {
+        return -EINVAL;
+    }
+
+    return fd_read(file, buf, count, true, (uint32_t)offset);
+}
+
+long lseek(int fd, long offset, int whence)
+{
+    xf_hal_fd_t *file = fd_get(fd);
+    long pos;
+
+    if (file == NULL) {
+        return -1;
+    }
+
+    if (!file->seekable) {
+        return -ESPIPE;
+    }
+
+    // 设备容量未知，不支持 SEEK_END
+    switch (whence) {
+    case SEEK_SET:
+        pos = offset;
+        break;
+    case SEEK_CUR:
+        pos = (long)file->pos + offset;
+        break;
+    default:
+        return -EINVAL;
+    }
+
+    if (pos < 0 || (unsigned long)pos > UINT32_MAX) {
+        return -EINVAL;
+    }
+
+    file->pos = (uint32_t)pos;
+    file->positioned = true;
+
+    return pos;
+}
+
 int close(int fd)
 {
     int ret = 0;
-    uint16_t type = FD_TO_ID(fd);
-    uint16_t id = FD_TO_TYPE(fd);
-    xf_hal_dev_t *dev = xf_hal_device_find(type, id);
+    xf_hal_fd_t *file = fd_get(fd);
 
-    if (dev == NULL) {
-        XF_LOGE(TAG, "not find this device");
-        XF_LOGE(TAG, "type;%d", type);
-        XF_LOGE(TAG, "id;%d", id);
+    if (file == NULL) {
+        return -1;
     }
 
-    ret = xf_hal_driver_close(dev);
-    if (ret) {
-        XF_LOGE(TAG, "read failed!");
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_lock(s_fd_mutex);
+#endif
+
+    xf_hal_dev_t *dev = file->dev;
+    bool owner = file->owner;
+
+    size_t index = file - s_fd_table;
+
+    XF_HAL_ATOMIC_STORE(&file->dev, NULL);
+    if (s_fd_hint > index) {
+        s_fd_hint = index;
+    }
+
+    // 设备仍被其他 fd 引用时只释放本 fd，关闭设备的责任交给其中一个
+    for (size_t i = 0; owner && i < s_fd_top; i++) {
+        if (s_fd_table[i].dev == dev) {
+            s_fd_table[i].owner = true;
+            owner = false;
+        }
+    }
+
+#if XF_HAL_LOCK_IS_ENABLE
+    xf_lock_unlock(s_fd_mutex);
+#endif
+
+    if (owner) {
+        ret = xf_hal_driver_close(dev);
+        if (ret) {
+            XF_LOGE(TAG, "close failed!");
+        }
     }
 
     return ret;
 }
 
-/* ==================== [Static Functions] ================================== */
+int fcntl(int fd, int cmd, ...)
+{
+    va_list args;
+    int flags = 0;
+    xf_hal_fd_t *file = fd_get(fd);
 
-static const char *is_prefix(const char *substr, const char *str)
+    if (file == NULL) {
+        return -1;
+    }
+
+    switch (cmd) {
+    case F_GETFL:
+        return file->flags;
+    case F_SETFL:
+        va_start(args, cmd);
+        flags = va_arg(args, int);
+        va_end(args);
+        file->flags = (file->flags & O_ACCMODE) | (flags & O_NONBLOCK);
+        return 0;
+    default:
+        XF_LOGE(TAG, "fcntl cmd not supported:%d", cmd);
+        return -1;
+    }
+}
+
+int poll(struct pollfd *fds, nfds_t nfds, int timeout)
 {
-    while (*substr != '\0') {
-        if (*substr != *str) {
-            return NULL;
+    XF_ASSERT(fds || !nfds, -1, TAG, "fds must not be NULL");
+
+    for (;;) {
+        uint32_t seq = XF_HAL_ATOMIC_LOAD(&s_poll_seq);
+
+        int ready = poll_scan(fds, nfds);
+        if (ready > 0 || timeout == 0 || s_poll_wait == NULL) {
+            return ready;
+        }
+
+        // 扫描期间已有新事件时直接重新扫描，否则等待唤醒；之前的唤醒不会丢失
+        if (XF_HAL_ATOMIC_LOAD(&s_poll_seq) != seq) {
+            continue;
+        }
+
+        timeout = s_poll_wait(timeout);
+        if (timeout == 0) {
+            return poll_scan(fds, nfds);
         }
-        substr++;
-        str++;
     }
-    return str;
 }
 
-static bool _atoi(const char *src, uint16_t *num)
+void xf_hal_posix_init(void)
 {
-    *num = 0;
+    if (s_name_ready) {
+        return;
+    }
 
-    while (*src >= '0' && *src <= '9') {
-        *num = *num * 10 + (*src++ - '0');
+#if XF_HAL_LOCK_IS_ENABLE
+    if (xf_lock_init(&s_fd_mutex) != XF_OK) {
+        XF_LOGE(TAG, "lock init failed!");
+        return;
     }
+#endif
 
-    if (*src != '\0') {
-        return false;
+    for (size_t i = 0; i < DEV_STR_NUM; i++) {
+        uint32_t slot = name_hash(dev_str[i], strlen(dev_str[i]));
+        while (s_name_table[slot & (NAME_HASH_SIZE - 1)] != 0) {
+            slot++;
+        }
+        s_name_table[slot & (NAME_HASH_SIZE - 1)] = i + 1;
     }
 
-    return true;
+    s_name_ready = true;
 }
 
-static bool name_to_type_and_id(const char *pathname, uint16_t *type, uint16_t *id)
+void xf_hal_poll_set_waiter(xf_hal_poll_wait_t wait, xf_hal_poll_wake_t wake)
 {
-    for (size_t i = 0; i < DEV_STR_NUM; i++) {
-        const char *other = is_prefix(dev_str[i], pathname);
-        if (other == NULL) {
+    s_poll_wait = wait;
+    s_poll_wake = wake;
+}
+
+void xf_hal_driver_poll_set(xf_hal_dev_t *dev, uint32_t events)
+{
+    uint32_t old = XF_HAL_ATOMIC_FETCH_OR(&dev->poll_events, events);
+
+    // 只在出现新事件时唤醒，持续就绪的设备不会反复唤醒 poll
+    if ((old & events) != events) {
+        XF_HAL_ATOMIC_FETCH_ADD(&s_poll_seq, 1);
+        xf_hal_poll_wake_t wake = s_poll_wake;
+        if (wake != NULL) {
+            wake();
+        }
+    }
+}
+
+void xf_hal_driver_poll_clear(xf_hal_dev_t *dev, uint32_t events)
+{
+    XF_HAL_ATOMIC_FETCH_AND(&dev->poll_events, ~events);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static int poll_scan(struct pollfd *fds, nfds_t nfds)
+{
+    int ready = 0;
+
+    for (nfds_t i = 0; i < nfds; i++) {
+        int index = FD_TO_INDEX(fds[i].fd);
+
+        fds[i].revents = 0;
+        if (fds[i].fd < 0) {
             continue;
         }
-        _atoi(other, id);
-        *type = i;
-        return true;
+
+        xf_hal_dev_t *dev = (index >= 0 && index < XF_HAL_POSIX_FD_MAX)
+                            ? XF_HAL_ATOMIC_LOAD(&s_fd_table[index].dev) : NULL;
+        if (dev == NULL) {
+            fds[i].revents = POLLNVAL;
+        } else {
+            fds[i].revents = XF_HAL_ATOMIC_LOAD(&dev->poll_events) & (fds[i].events | POLLERR);
+        }
+
+        if (fds[i].revents) {
+            ready++;
+        }
+    }
+
+    return ready;
+}
+
+static uint32_t name_hash(const char *name, size_t len)
+{
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+
+    for (size_t i = 0; i < len; i++) {
+        hash = (hash ^ (uint8_t)name[i]) * 16777619u;
+    }
+
+    return hash;
+}
+
+static bool name_to_type_and_id(const char *pathname, uint16_t *type, uint16_t *id)
+{
+    // 路径为类型名加末尾的十进制编号（如 "I2C1"），类型名本身可以含数字，因此从末尾找编号
+    size_t len = strlen(pathname);
+    size_t name_len = len;
+    uint32_t num = 0;
+
+    while (name_len > 0 && pathname[name_len - 1] >= '0' && pathname[name_len - 1] <= '9') {
+        name_len--;
+    }
+
+    // 必须有类型名与编号，"UART" 这样没有编号的路径不能当作 0 号设备
+    if (name_len == 0 || name_len == len || len - name_len > 5) {
+        return false;
+    }
+
+    for (size_t i = name_len; i < len; i++) {
+        num = num * 10 + (pathname[i] - '0');
+    }
+
+    if (num > UINT16_MAX) {
+        return false;
+    }
+
+    if (!s_name_ready) {
+        return false;
+    }
+
+    uint32_t slot = name_hash(pathname, name_len);
+    for (size_t n = 0; n < NAME_HASH_SIZE; n++, slot++) {
+        uint8_t entry = s_name_table[slot & (NAME_HASH_SIZE - 1)];
+        if (entry == 0) {
+            break;
+        }
+
+        const char *name = dev_str[entry - 1];
+        if (strncmp(name, pathname, name_len) == 0 && name[name_len] == '\0') {
+            *type = entry - 1;
+            *id = (uint16_t)num;
+            return true;
+        }
     }
 
     return false;
 }
 
+static bool flags_check(xf_hal_flag_t hal_flag, int flags)
+{
+    bool can_read = BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_READ);
+    bool can_write = BITS_CHECK(hal_flag, XF_HAL_FLAG_ONLY_WRITE);
+
+    switch (flags & O_ACCMODE) {
+    case O_RDONLY:
+        return can_read;
+    case O_WRONLY:
+        return can_write;
+    case O_RDWR:
+        return can_read && can_write;
+    default:
+        return false;
+    }
+}
+
+static int fd_seek_begin(xf_hal_fd_t *file, bool positioned, uint32_t offset)
+{
+    if (!positioned) {
+        return 0;
+    }
+
+    // 地址只在变化时下发，同一设备上其他 fd 的定位与读写等待本次完成
+    xf_err_t err = xf_hal_driver_seek_begin(file->dev, offset);
+    if (err == XF_ERR_INVALID_ARG) {
+        return -EINVAL;
+    } else if (err != XF_OK) {
+        XF_LOGE(TAG, "seek failed!");
+        return (err > 0) ? -err : err;
+    }
+
+    return 0;
+}
+
+static void fd_seek_end(xf_hal_fd_t *file, bool positioned)
+{
+    if (positioned) {
+        xf_hal_driver_seek_end(file->dev);
+    }
+}
+
+static int fd_write(xf_hal_fd_t *file, const void *buf, size_t count, bool positioned, uint32_t offset)
+{
+    int ret = fd_seek_begin(file, positioned, offset);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (file->flags & O_NONBLOCK) {
+        ret = xf_hal_driver_write_nonblock(file->dev, buf, count);
+        if (ret == 0 && count > 0) {
+            ret = -EAGAIN;
+        }
+    } else {
+        ret = xf_hal_driver_write(file->dev, buf, count);
+    }
+
+    fd_seek_end(file, positioned);
+
+    if (ret < 0 && ret != -EAGAIN) {
+        XF_LOGE(TAG, "write failed!");
+    }
+
+    return ret;
+}
+
+static int fd_read(xf_hal_fd_t *file, void *buf, size_t count, bool positioned, uint32_t offset)
+{
+    int ret = fd_seek_begin(file, positioned, offset);
+    if (ret < 0) {
+        return ret;
+    }
+
+    if (file->flags & O_NONBLOCK) {
+        ret = xf_hal_driver_read_nonblock(file->dev, buf, count);
+        if (ret == 0 && count > 0) {
+            ret = -EAGAIN;
+        }
+    } else {
+        ret = xf_hal_driver_read(file->dev, buf, count);
+    }
+
+    fd_seek_end(file, positioned);
+
+    if (ret < 0 && ret != -EAGAIN) {
+        XF_LOGE(TAG, "read failed!");
+    }
+
+    return ret;
+}
+
+static xf_hal_fd_t *fd_get(int fd)
+{
+    int index = FD_TO_INDEX(fd);
+
+    if (index < 0 || index >= XF_HAL_POSIX_FD_MAX
+            || XF_HAL_ATOMIC_LOAD(&s_fd_table[index].dev) == NULL) {
+        XF_LOGE(TAG, "bad fd: %d", fd);
+        return NULL;
+    }
+
+    return &s_fd_table[index];
+}
+
 #endif
@@ -7,6 +7,21 @@
  *
  * @copyright Copyright (c) 2024, CorAL. All rights reserved.
  *
+ * @details open 解析路径（类型名加十进制编号，如 "UART0"，不带编号的路径无效）并在文件描述符表中记录设备指针、flags 与当前位置，
+ * 之后的 read / write / ioctl 直接按 fd 取表项，不再查找设备。
+ * 同一设备可以多次打开；设备由 open 创建时，最后一个引用它的 fd 关闭时才关闭设备，
+ * 已通过 xf_hal_xxx_init 创建的设备不会被 close 关闭。
+ * 表大小见 XF_HAL_POSIX_FD_MAX，fd 从 XF_HAL_POSIX_FD_BASE 开始分配。
+ *
+ * 支持按地址访问的设备（目前为 i2c，地址为从机内存地址）表现为文件：pread / pwrite 按偏移访问，
+ * lseek 之后的 read / write 从当前位置开始，完成后位置累加，一次调用即可完成 eeprom 等器件的读写。
+ * 未 lseek 的 fd 不改变设备地址，read / write 为原始传输。
+ *
+ * 以 O_NONBLOCK 打开（或通过 fcntl 设置）时，read 只取已缓存的数据，write 只写入发送缓冲能容纳的数据，
+ * 一个字节都无法读写时返回 -EAGAIN，见 xf_hal_driver_read_nonblock。
+ *
+ * poll 检查各设备由驱动上报的就绪事件（见 xf_hal_driver_poll_set），都未就绪时通过
+ * xf_hal_poll_set_waiter 设置的等待函数阻塞，驱动上报事件时唤醒，从而一个线程即可服务多个外设。
  */
 
 #ifndef __XF_HAL_POSIX_H__
@@ -15,6 +30,8 @@
 /* ==================== [Includes] ========================================== */
 
 #include "xf_hal_kernel_config.h"
+#include "xf_hal_dev.h"
+#include <errno.h>
 
 /**
  * @ingroup group_xf_hal_internal
@@ -34,9 +51,46 @@ extern "C" {
 #define O_RDONLY         0x00
 #define O_WRONLY         0x01
 #define O_RDWR           0x02
+#define O_ACCMODE        0x03       /*!< flags 中的访问模式位 */
+#define O_NONBLOCK       0x0800     /*!< 非阻塞读写，无法立即读写时返回 -EAGAIN */
+
+#ifndef SEEK_SET
+#define SEEK_SET         0
+#define SEEK_CUR         1
+#define SEEK_END         2
+#endif
+
+#define F_GETFL          3
+#define F_SETFL          4          /*!< 只能修改 O_NONBLOCK，访问模式不变 */
+
+#define POLLIN           XF_HAL_POLLIN
+#define POLLOUT          XF_HAL_POLLOUT
+#define POLLERR          XF_HAL_POLLERR
+#define POLLNVAL         0x0020     /*!< fd 无效，只在 revents 中返回 */
 
 /* ==================== [Typedefs] ========================================== */
 
+typedef unsigned int nfds_t;
+
+struct pollfd {
+    int fd;                 /*!< 文件描述符，小于 0 时忽略该项 */
+    short events;           /*!< 关心的事件 */
+    short revents;          /*!< 返回的事件，POLLERR 与 POLLNVAL 总会返回 */
+};
+
+/**
+ * @brief poll 的等待函数，在没有就绪事件时阻塞当前线程。
+ *
+ * @param timeout_ms 最长等待时间，-1 表示一直等待。
+ * @return int 剩余的等待时间；被唤醒前超时返回 0，timeout_ms 为 -1 时返回 -1。
+ */
+typedef int (*xf_hal_poll_wait_t)(int timeout_ms);
+
+/**
+ * @brief poll 的唤醒函数，在驱动上报就绪事件时调用，可能在中断中调用。
+ */
+typedef void (*xf_hal_poll_wake_t)(void);
+
 /* ==================== [Global Prototypes] ================================= */
 
 int open(const char *pathname, int flags);
@@ -45,6 +99,52 @@ size_t write(int fd, const void *buf, size_t count);
 size_t read(int fd, void *buf, size_t count);
 int close(int fd);
 
+/**
+ * @brief 在指定偏移处读写，不改变 fd 的当前位置。
+ *        只支持可按地址访问的设备（如 i2c 从机内存地址），偏移即设备地址；其他设备返回 -ESPIPE，
+ *        偏移超出设备地址宽度返回 -EINVAL。
+ *        不按器件页大小拆分，跨页写入由调用者处理。
+ */
+size_t pwrite(int fd, const void *buf, size_t count, long offset);
+size_t pread(int fd, void *buf, size_t count, long offset);
+
+/**
+ * @brief 设置 fd 的当前位置，之后该 fd 的 read / write 先把设备定位到当前位置，并顺序累加。
+ *
+ * @param whence SEEK_SET 或 SEEK_CUR，设备容量未知，不支持 SEEK_END。
+ * @return long 新的位置；设备不支持按地址访问时返回 -ESPIPE，参数错误返回 -EINVAL。
+ */
+long lseek(int fd, long offset, int whence);
+
+/**
+ * @brief 读取或修改 fd 的 flags。
+ *
+ * @param fd 文件描述符。
+ * @param cmd F_GETFL 或 F_SETFL。
+ * @param ... F_SETFL 时为新的 flags（int）。
+ * @return int F_GETFL 返回 flags，F_SETFL 成功返回 0，失败返回 -1。
+ */
+int fcntl(int fd, int cmd, ...);
+
+/**
+ * @brief 等待多个 fd 中的任意一个就绪。
+ *
+ * @param fds fd 与关心的事件。
+ * @param nfds fds 数量。
+ * @param timeout 最长等待时间（ms），0 表示立即返回，-1 表示一直等待。
+ * 未设置等待函数时不阻塞，等同于 timeout 为 0。
+ * @return int 有事件返回的 fd 数量，超时返回 0。
+ */
+int poll(struct pollfd *fds, nfds_t nfds, int timeout);
+
+/**
+ * @brief 设置 poll 的等待与唤醒函数。
+ *        两者需具备二值信号量的语义：在 wait 之前发生的 wake 不能丢失，
+ *        如 RTOS 的二值信号量、主机上的条件变量加标志位。
+ *        同一时间只应有一个线程调用 poll。
+ */
+void xf_hal_poll_set_waiter(xf_hal_poll_wait_t wait, xf_hal_poll_wake_t wake);
+
 /* ==================== [Macros] ============================================ */
 
 #ifdef __cplusplus
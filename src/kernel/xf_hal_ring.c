@@ -0,0 +1,142 @@
+/**
+ * @file xf_hal_ring.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 单生产者单消费者字节环形缓冲区。
+ * @version 0.1
+ * @date 2024-08-08
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_ring.h"
+#include "xf_hal_atomic.h"
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "hal_ring"
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+/* ==================== [Static Variables] ================================== */
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+xf_err_t xf_hal_ring_init(xf_hal_ring_t *ring, uint8_t *buf, uint32_t size)
+{
+    XF_ASSERT(ring, XF_ERR_INVALID_ARG, TAG, "ring must not be NULL");
+    XF_ASSERT(buf, XF_ERR_INVALID_ARG, TAG, "buf must not be NULL");
+    XF_ASSERT(size && !(size & (size - 1)), XF_ERR_INVALID_ARG, TAG, "size must be a power of 2:%u", (unsigned)size);
+
+    ring->buf = buf;
+    ring->mask = size - 1;
+    ring->head = 0;
+    ring->tail_cache = 0;
+    ring->overrun = 0;
+    ring->tail = 0;
+    ring->head_cache = 0;
+
+    return XF_OK;
+}
+
+uint32_t xf_hal_ring_write(xf_hal_ring_t *ring, const void *data, uint32_t count)
+{
+    uint32_t head = ring->head;
+    uint32_t size = ring->mask + 1;
+    uint32_t space = size - (head - ring->tail_cache);
+
+    // 缓存的读取位置只会落后，空间不足时才重新读取
+    if (space < count) {
+        ring->tail_cache = XF_HAL_ATOMIC_LOAD(&ring->tail);
+        space = size - (head - ring->tail_cache);
+    }
+
+    uint32_t n = (count < space) ? count : space;
+    if (n < count) {
+        XF_HAL_ATOMIC_STORE_RELAXED(&ring->overrun, ring->overrun + (count - n));
+    }
+
+    uint32_t index = head & ring->mask;
+    uint32_t first = (n < size - index) ? n : size - index;
+    memcpy(ring->buf + index, data, first);
+    memcpy(ring->buf, (const uint8_t *)data + first, n - first);
+
+    XF_HAL_ATOMIC_STORE(&ring->head, head + n);
+
+    return n;
+}
+
+uint32_t xf_hal_ring_read(xf_hal_ring_t *ring, void *buf, uint32_t count)
+{
+    uint32_t tail = ring->tail;
+    uint32_t size = ring->mask + 1;
+    uint32_t used = ring->head_cache - tail;
+
+    // 缓存的写入位置只会落后，数据不足时才重新读取
+    if (used < count) {
+        ring->head_cache = XF_HAL_ATOMIC_LOAD(&ring->head);
+        used = ring->head_cache - tail;
+    }
+
+    uint32_t n = (count < used) ? count : used;
+
+    uint32_t index = tail & ring->mask;
+    uint32_t first = (n < size - index) ? n : size - index;
+    memcpy(buf, ring->buf + index, first);
+    memcpy((uint8_t *)buf + first, ring->buf, n - first);
+
+    XF_HAL_ATOMIC_STORE(&ring->tail, tail + n);
+
+    return n;
+}
+
+uint32_t xf_hal_ring_peek(xf_hal_ring_t *ring, xf_hal_iovec_t iov[2])
+{
+    uint32_t tail = ring->tail;
+    uint32_t size = ring->mask + 1;
+
+    ring->head_cache = XF_HAL_ATOMIC_LOAD(&ring->head);
+    uint32_t used = ring->head_cache - tail;
+
+    uint32_t index = tail & ring->mask;
+    uint32_t first = (used < size - index) ? used : size - index;
+    iov[0].buf = ring->buf + index;
+    iov[0].count = first;
+    iov[1].buf = ring->buf;
+    iov[1].count = used - first;
+
+    return used;
+}
+
+uint32_t xf_hal_ring_consume(xf_hal_ring_t *ring, uint32_t count)
+{
+    uint32_t tail = ring->tail;
+
+    // 只释放上次借出时已看到的数据，之后到达的数据调用者还没有处理过，不能重新读取写入位置
+    uint32_t seen = ring->head_cache - tail;
+
+    uint32_t n = (count < seen) ? count : seen;
+    XF_HAL_ATOMIC_STORE(&ring->tail, tail + n);
+
+    return n;
+}
+
+uint32_t xf_hal_ring_used(xf_hal_ring_t *ring)
+{
+    uint32_t tail = XF_HAL_ATOMIC_LOAD(&ring->tail);
+    return XF_HAL_ATOMIC_LOAD(&ring->head) - tail;
+}
+
+uint32_t xf_hal_ring_overrun(xf_hal_ring_t *ring)
+{
+    return XF_HAL_ATOMIC_LOAD_RELAXED(&ring->overrun);
+}
+
+/* ==================== [Static Functions] ================================== */
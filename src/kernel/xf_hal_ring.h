@@ -0,0 +1,144 @@
+/**
+ * @file xf_hal_ring.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 单生产者单消费者字节环形缓冲区。
+ * @version 0.1
+ * @date 2024-08-08
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 用于接收中断（生产者）与读取任务（消费者）之间传递数据，无锁。
+ * 大小为 2 的幂，读写位置自由递增，只在下标处取模；两端只通过读写位置同步，
+ * 各自缓存对端的位置，空间或数据不足时才重新读取，减少跨核访问对端写入的缓存行。
+ * 两端写入的字段之间填充 XF_HAL_CACHE_LINE_SIZE 字节，不会落在同一缓存行。
+ * 同一时刻只能有一个生产者和一个消费者。
+ * 用法：
+ * @code
+ * static uint8_t s_buf[1024];
+ * xf_hal_ring_t ring;
+ * xf_hal_ring_init(&ring, s_buf, sizeof(s_buf));
+ * xf_hal_ring_write(&ring, data, len);   // 中断中
+ * xf_hal_ring_read(&ring, buf, sizeof(buf));
+ *
+ * // 或不拷贝，直接在缓冲区中处理后释放
+ * xf_hal_iovec_t iov[2];
+ * uint32_t n = xf_hal_ring_peek(&ring, iov);
+ * xf_hal_ring_consume(&ring, parse(iov, n));
+ * @endcode
+ */
+
+#ifndef __XF_HAL_RING_H__
+#define __XF_HAL_RING_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+#include "xf_hal_io.h"
+
+/**
+ * @ingroup group_xf_hal_internal
+ * @defgroup group_xf_hal_internal_ring ring
+ * @brief 单生产者单消费者环形缓冲区。
+ * @{
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+// 填充一整个缓存行，不依赖结构体的对齐即可保证前后两组字段不在同一缓存行
+#if XF_HAL_CACHE_LINE_SIZE > 0
+#define XF_HAL_RING_PAD(name)   uint8_t name[XF_HAL_CACHE_LINE_SIZE];
+#else
+#define XF_HAL_RING_PAD(name)
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+typedef struct _xf_hal_ring_t {
+    // 初始化后只读
+    uint8_t *buf;           /*!< 存储区 */
+    uint32_t mask;          /*!< 大小减 1 */
+    XF_HAL_RING_PAD(pad0)
+
+    // 只由生产者写入
+    uint32_t head;          /*!< 写入位置 */
+    uint32_t tail_cache;    /*!< 生产者缓存的读取位置 */
+    uint32_t overrun;       /*!< 缓冲区满时丢弃的字节数 */
+    XF_HAL_RING_PAD(pad1)
+
+    // 只由消费者写入
+    uint32_t tail;          /*!< 读取位置 */
+    uint32_t head_cache;    /*!< 消费者缓存的写入位置 */
+} xf_hal_ring_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 初始化环形缓冲区，清空数据与溢出计数。
+ *
+ * @param ring 环形缓冲区。
+ * @param buf 存储区，使用期间必须保持有效。
+ * @param size 存储区大小，必须为 2 的幂。
+ * @return xf_err_t
+ *      - XF_OK                 成功
+ *      - XF_ERR_INVALID_ARG    参数无效或 size 不是 2 的幂
+ */
+xf_err_t xf_hal_ring_init(xf_hal_ring_t *ring, uint8_t *buf, uint32_t size);
+
+/**
+ * @brief 生产者写入数据，空间不足时只写入能容纳的部分，其余丢弃并计入溢出计数。可在中断中调用。
+ *
+ * @return uint32_t 实际写入的字节数。
+ */
+uint32_t xf_hal_ring_write(xf_hal_ring_t *ring, const void *data, uint32_t count);
+
+/**
+ * @brief 消费者取出数据。
+ *
+ * @return uint32_t 实际取出的字节数，没有数据时为 0。
+ */
+uint32_t xf_hal_ring_read(xf_hal_ring_t *ring, void *buf, uint32_t count);
+
+/**
+ * @brief 消费者借出缓冲区中的全部数据，不拷贝、不移动读取位置。
+ *        数据在存储区末尾回绕时分为两段，iov[0] 在前；不足两段时其余段的 count 为 0。
+ *        借出的数据在 xf_hal_ring_consume 释放前不会被生产者覆盖。
+ *
+ * @param iov 输出两个数据段。
+ * @return uint32_t 借出的总字节数。
+ */
+uint32_t xf_hal_ring_peek(xf_hal_ring_t *ring, xf_hal_iovec_t iov[2]);
+
+/**
+ * @brief 消费者释放最前面的 count 个字节。count 超过上次 xf_hal_ring_peek 借出的字节数时
+ *        只释放借出的部分，借出之后新写入的数据保留到下次借出。
+ *
+ * @return uint32_t 实际释放的字节数。
+ */
+uint32_t xf_hal_ring_consume(xf_hal_ring_t *ring, uint32_t count);
+
+/**
+ * @brief 当前缓存的字节数。
+ */
+uint32_t xf_hal_ring_used(xf_hal_ring_t *ring);
+
+/**
+ * @brief 累计溢出丢弃的字节数。
+ */
+uint32_t xf_hal_ring_overrun(xf_hal_ring_t *ring);
+
+/* ==================== [Macros] ============================================ */
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+/**
+ * End of group_xf_hal_internal_ring
+ * @}
+ */
+
+#endif // __XF_HAL_RING_H__
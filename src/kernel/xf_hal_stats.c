@@ -0,0 +1,163 @@
+/**
+ * @file xf_hal_stats.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 设备读写统计。
+ * @version 0.1
+ * @date 2024-07-22
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+
+#if XF_HAL_STATS_IS_ENABLE
+
+#include "xf_hal_stats.h"
+#include "xf_hal_dev.h"
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "hal_stats"
+#define DEV_STR_NUM (sizeof(dev_str) / sizeof(const char *))
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static void stats_dump_dev(xf_hal_dev_t *dev, void *user_data);
+static void stats_dump_op(const char *name, const xf_hal_op_stats_t *op);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_stats_clock_t s_clock = NULL;
+
+static const char *dev_str[] = {
+#define XF_HAL_TABLE_STR
+#include "../device/xf_hal_reg_table.inc"
+};
+
+static const char *op_str[XF_HAL_STATS_OP_MAX] = {
+    "read", "write", "ioctl",
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_stats_set_clock(xf_hal_stats_clock_t clock)
+{
+    s_clock = clock;
+}
+
+uint32_t xf_hal_stats_now(void)
+{
+    xf_hal_stats_clock_t clock = s_clock;
+    return (clock != NULL) ? clock() : 0;
+}
+
+void xf_hal_stats_record(xf_hal_dev_stats_t *stats, xf_hal_stats_op_t op, uint32_t start, int ret)
+{
+    xf_hal_op_stats_t *op_stats = &stats->op[op];
+    uint32_t elapsed = xf_hal_stats_now() - start;
+
+    op_stats->calls++;
+    if (ret < 0) {
+        op_stats->errors++;
+    } else if (op != XF_HAL_STATS_OP_IOCTL) {
+        op_stats->bytes += (uint32_t)ret;
+    }
+
+    if (elapsed > op_stats->time_max) {
+        op_stats->time_max = elapsed;
+    }
+    op_stats->hist[xf_hal_stats_bucket(elapsed)]++;
+}
+
+void xf_hal_stats_record_cmd(xf_hal_dev_stats_t *stats, uint32_t cmd)
+{
+    if (cmd == XF_HAL_DEV_CMD_ALL) {
+        stats->ioctl_all++;
+        return;
+    }
+
+    for (uint32_t i = 0; cmd != 0 && i < XF_HAL_STATS_CMD_NUM; i++, cmd >>= 1) {
+        if (cmd & 0x01) {
+            stats->ioctl_cmd[i]++;
+        }
+    }
+}
+
+void xf_hal_stats_reset(xf_hal_dev_stats_t *stats)
+{
+    memset(stats, 0, sizeof(xf_hal_dev_stats_t));
+}
+
+uint32_t xf_hal_stats_bucket(uint32_t elapsed)
+{
+    uint32_t bucket = 0;
+
+    while (elapsed != 0 && bucket < XF_HAL_STATS_HIST_SIZE - 1) {
+        elapsed >>= 1;
+        bucket++;
+    }
+
+    return bucket;
+}
+
+void xf_hal_stats_dump(void)
+{
+    xf_hal_device_foreach(stats_dump_dev, NULL);
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static void stats_dump_dev(xf_hal_dev_t *dev, void *user_data)
+{
+    UNUSED(user_data);
+
+    const xf_hal_dev_stats_t *stats = &dev->stats;
+
+    XF_LOGI(TAG, "%s%u:", (dev->type < DEV_STR_NUM) ? dev_str[dev->type] : "?", (unsigned int)dev->id);
+
+    for (uint32_t i = 0; i < XF_HAL_STATS_OP_MAX; i++) {
+        stats_dump_op(op_str[i], &stats->op[i]);
+    }
+
+    if (stats->ioctl_all != 0) {
+        XF_LOGI(TAG, "  cmd all: %u", (unsigned int)stats->ioctl_all);
+    }
+
+    for (uint32_t i = 0; i < XF_HAL_STATS_CMD_NUM; i++) {
+        if (stats->ioctl_cmd[i] != 0) {
+            XF_LOGI(TAG, "  cmd bit%u: %u", (unsigned int)i, (unsigned int)stats->ioctl_cmd[i]);
+        }
+    }
+}
+
+static void stats_dump_op(const char *name, const xf_hal_op_stats_t *op)
+{
+    if (op->calls == 0) {
+        return;
+    }
+
+    XF_LOGI(TAG, "  %s calls:%u errors:%u bytes:%lu max:%u", name, (unsigned int)op->calls,
+            (unsigned int)op->errors, (unsigned long)op->bytes, (unsigned int)op->time_max);
+
+    // 第 n 桶的上界为 2^n，最后一个桶没有上界
+    for (uint32_t i = 0; i < XF_HAL_STATS_HIST_SIZE; i++) {
+        if (op->hist[i] == 0) {
+            continue;
+        }
+        if (i == XF_HAL_STATS_HIST_SIZE - 1) {
+            XF_LOGI(TAG, "    >=%lu: %u", 1UL << (i - 1), (unsigned int)op->hist[i]);
+        } else {
+            XF_LOGI(TAG, "    <%lu: %u", 1UL << i, (unsigned int)op->hist[i]);
+        }
+    }
+}
+
+#endif
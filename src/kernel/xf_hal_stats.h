@@ -0,0 +1,140 @@
+/**
+ * @file xf_hal_stats.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 设备读写统计。
+ * @version 0.1
+ * @date 2024-07-22
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 需要在 xf_hal_config.h 中开启 XF_HAL_STATS_ENABLE。
+ * 耗时由 xf_hal_stats_set_clock 设置的时钟计算，单位与时钟一致，未设置时钟时只统计次数。
+ * 统计值在调用路径上直接累加，不加锁，多任务同时访问同一设备时允许少量误差。
+ */
+
+#ifndef __XF_HAL_STATS_H__
+#define __XF_HAL_STATS_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+
+/**
+ * @ingroup group_xf_hal_internal
+ * @defgroup group_xf_hal_internal_stats stats
+ * @brief 设备读写统计。
+ * @{
+ */
+
+#if XF_HAL_STATS_IS_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_STATS_CMD_NUM    31  /*!< 统计的 ioctl 命令位数，对应 XF_HAL_DEV_CMD_ALL 的位数 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 统计时钟，返回单调递增的时间戳，允许溢出回绕。
+ */
+typedef uint32_t (*xf_hal_stats_clock_t)(void);
+
+typedef enum _xf_hal_stats_op_t {
+    XF_HAL_STATS_OP_READ = 0,   /*!< read 与 readv */
+    XF_HAL_STATS_OP_WRITE,      /*!< write 与 writev */
+    XF_HAL_STATS_OP_IOCTL,      /*!< 实际下发到驱动的 ioctl */
+    XF_HAL_STATS_OP_MAX,
+} xf_hal_stats_op_t;
+
+typedef struct _xf_hal_op_stats_t {
+    uint32_t calls;     /*!< 调用次数 */
+    uint32_t errors;    /*!< 驱动返回错误的次数 */
+    uint64_t bytes;     /*!< 成功传输的字节数，ioctl 不统计 */
+    uint32_t time_max;  /*!< 单次调用的最大耗时 */
+    uint32_t hist[XF_HAL_STATS_HIST_SIZE];  /*!< 耗时直方图 */
+} xf_hal_op_stats_t;
+
+typedef struct _xf_hal_dev_stats_t {
+    xf_hal_op_stats_t op[XF_HAL_STATS_OP_MAX];
+    uint32_t ioctl_cmd[XF_HAL_STATS_CMD_NUM];   /*!< 各命令位被下发的次数 */
+    uint32_t ioctl_all;     /*!< 下发全部配置的次数，不计入 ioctl_cmd */
+} xf_hal_dev_stats_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 设置统计时钟。
+ *
+ * @param clock 时钟函数，为 NULL 时不统计耗时。
+ */
+void xf_hal_stats_set_clock(xf_hal_stats_clock_t clock);
+
+/**
+ * @brief 获取统计时钟的当前时间戳，未设置时钟时返回 0。
+ */
+uint32_t xf_hal_stats_now(void);
+
+/**
+ * @brief 记录一次读写或 ioctl。
+ *
+ * @param stats 设备统计。
+ * @param op 操作类型，见 @ref xf_hal_stats_op_t.
+ * @param start 调用开始时由 xf_hal_stats_now 获取的时间戳。
+ * @param ret 驱动返回值，读写为实际传输大小，负数为错误。
+ */
+void xf_hal_stats_record(xf_hal_dev_stats_t *stats, xf_hal_stats_op_t op, uint32_t start, int ret);
+
+/**
+ * @brief 记录一次 ioctl 下发的命令位。
+ *
+ * @param stats 设备统计。
+ * @param cmd 下发到驱动的命令。
+ */
+void xf_hal_stats_record_cmd(xf_hal_dev_stats_t *stats, uint32_t cmd);
+
+/**
+ * @brief 清零统计。
+ *
+ * @param stats 设备统计。
+ */
+void xf_hal_stats_reset(xf_hal_dev_stats_t *stats);
+
+/**
+ * @brief 计算耗时对应的直方图桶序号。
+ */
+uint32_t xf_hal_stats_bucket(uint32_t elapsed);
+
+/**
+ * @brief 通过日志输出所有设备的统计。
+ */
+void xf_hal_stats_dump(void);
+
+/* ==================== [Macros] ============================================ */
+
+/**
+ * @brief 在调用驱动前记录开始时间，与 XF_HAL_STATS_END 成对使用。
+ */
+#define XF_HAL_STATS_BEGIN(start)               uint32_t start = xf_hal_stats_now()
+#define XF_HAL_STATS_END(stats, op, start, ret) xf_hal_stats_record((stats), (op), (start), (ret))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#else
+
+#define XF_HAL_STATS_BEGIN(start)               (void)0
+#define XF_HAL_STATS_END(stats, op, start, ret) do {} while (0)
+
+#endif
+
+/**
+ * End of group_xf_hal_internal_stats
+ * @}
+ */
+
+#endif // __XF_HAL_STATS_H__
@@ -10,7 +10,8 @@
  *
  * @details 用法：
  * 在包含本文件前定义 `XF_HAL_TABLE_TYPE` 或 `XF_HAL_TABLE_STR` 可以
- * 生成枚举值或生成字符串。
+ * 生成枚举值或生成字符串；定义 `XF_HAL_TABLE_PORT_OPS` 声明静态分发的对接函数；
+ * 定义 `XF_HAL_TABLE_CASE(dev_name)` 按设备类型生成 switch 分支。
  */
 
 /* ==================== [Includes] ========================================== */
@@ -32,8 +33,22 @@
 #   define XF_HAL_REG(dev_name) XF_TO_STR(dev_name),
 #endif
 
+// 用于声明静态分发时对接层导出的操作函数
+#ifdef XF_HAL_TABLE_PORT_OPS
+#   define XF_HAL_REG(dev_name) \
+        xf_err_t xf_hal_port_##dev_name##_ioctl(xf_hal_dev_t *dev, uint32_t cmd, void *config); \
+        int xf_hal_port_##dev_name##_read(xf_hal_dev_t *dev, void *buf, size_t count); \
+        int xf_hal_port_##dev_name##_write(xf_hal_dev_t *dev, const void *buf, size_t count);
+#endif
+
+// 用于生成 switch 分支，包含前定义 XF_HAL_TABLE_CASE(dev_name)，包含后自行 undef
+#ifdef XF_HAL_TABLE_CASE
+#   define XF_HAL_REG(dev_name) XF_HAL_TABLE_CASE(dev_name)
+#endif
+
 #undef XF_HAL_TABLE_TYPE
 #undef XF_HAL_TABLE_STR
+#undef XF_HAL_TABLE_PORT_OPS
 
 /* ==================== [Typedefs] ========================================== */
 
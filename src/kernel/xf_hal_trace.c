@@ -0,0 +1,147 @@
+/**
+ * @file xf_hal_trace.c
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 设备事件跟踪。
+ * @version 0.1
+ * @date 2024-07-24
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ */
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+
+#if XF_HAL_TRACE_IS_ENABLE
+
+#include "xf_hal_trace.h"
+#include "xf_hal_atomic.h"
+#include <string.h>
+
+/* ==================== [Defines] =========================================== */
+
+#define TAG "hal_trace"
+#define DEV_STR_NUM (sizeof(dev_str) / sizeof(const char *))
+#define TRACE_MASK  (XF_HAL_TRACE_SIZE - 1)
+
+#if (XF_HAL_TRACE_SIZE & TRACE_MASK) != 0
+#   error "XF_HAL_TRACE_SIZE must be a power of 2"
+#endif
+
+/* ==================== [Typedefs] ========================================== */
+
+/* ==================== [Static Prototypes] ================================= */
+
+static bool trace_copy(uint32_t index, xf_hal_trace_event_t *event);
+
+/* ==================== [Static Variables] ================================== */
+
+static xf_hal_trace_event_t s_ring[XF_HAL_TRACE_SIZE];
+static uint32_t s_head = 0;     /*!< 累计预留的事件数，下一个事件的序号 */
+static xf_hal_trace_clock_t s_clock = NULL;
+static uint32_t s_clock_hz = 0;
+
+static const char *dev_str[] = {
+#define XF_HAL_TABLE_STR
+#include "../device/xf_hal_reg_table.inc"
+};
+
+/* ==================== [Macros] ============================================ */
+
+/* ==================== [Global Functions] ================================== */
+
+void xf_hal_trace_set_clock(xf_hal_trace_clock_t clock, uint32_t clock_hz)
+{
+    s_clock = clock;
+    s_clock_hz = clock_hz;
+}
+
+uint32_t xf_hal_trace_now(void)
+{
+    xf_hal_trace_clock_t clock = s_clock;
+    return (clock != NULL) ? clock() : 0;
+}
+
+void xf_hal_trace_record(xf_hal_trace_ev_t ev, uint32_t type, uint32_t id, uint32_t start, uint32_t arg, int32_t ret)
+{
+    uint32_t now = xf_hal_trace_now();
+    uint32_t index = XF_HAL_ATOMIC_FETCH_ADD(&s_head, 1);
+    xf_hal_trace_event_t *event = &s_ring[index & TRACE_MASK];
+
+    // 先把序号清零，读者看到 0 或序号不一致时丢弃该事件
+    XF_HAL_ATOMIC_STORE_RELAXED(&event->seq, 0);
+    XF_HAL_ATOMIC_FENCE_RELEASE();
+
+    event->start = start;
+    event->duration = now - start;
+    event->ev = (uint8_t)ev;
+    event->type = (uint8_t)type;
+    event->id = (uint16_t)id;
+    event->arg = arg;
+    event->ret = ret;
+
+    XF_HAL_ATOMIC_STORE(&event->seq, index + 1);
+}
+
+void xf_hal_trace_clear(void)
+{
+    memset(s_ring, 0, sizeof(s_ring));
+    XF_HAL_ATOMIC_STORE(&s_head, 0);
+}
+
+uint32_t xf_hal_trace_dump(xf_hal_trace_output_t output, void *user_data)
+{
+    XF_ASSERT(output, 0, TAG, "output must not be NULL");
+
+    uint32_t head = XF_HAL_ATOMIC_LOAD(&s_head);
+    uint32_t num = (head < XF_HAL_TRACE_SIZE) ? head : XF_HAL_TRACE_SIZE;
+
+    xf_hal_trace_header_t header = {
+        .magic = XF_HAL_TRACE_MAGIC,
+        .version = XF_HAL_TRACE_VERSION,
+        .event_size = sizeof(xf_hal_trace_event_t),
+        .clock_hz = s_clock_hz,
+        .total = head,
+        .event_num = num,
+        .type_num = DEV_STR_NUM,
+    };
+    output(&header, sizeof(header), user_data);
+
+    for (uint32_t i = 0; i < DEV_STR_NUM; i++) {
+        char name[XF_HAL_TRACE_NAME_SIZE] = {0};
+        strncpy(name, dev_str[i], sizeof(name) - 1);
+        output(name, sizeof(name), user_data);
+    }
+
+    // 导出时仍可能有新事件写入，被覆盖的事件以 seq 为 0 输出，保持事件数与头部一致
+    uint32_t valid = 0;
+    for (uint32_t index = head - num; index != head; index++) {
+        xf_hal_trace_event_t event;
+        if (trace_copy(index, &event)) {
+            valid++;
+        } else {
+            memset(&event, 0, sizeof(event));
+        }
+        output(&event, sizeof(event), user_data);
+    }
+
+    return valid;
+}
+
+/* ==================== [Static Functions] ================================== */
+
+static bool trace_copy(uint32_t index, xf_hal_trace_event_t *event)
+{
+    const xf_hal_trace_event_t *slot = &s_ring[index & TRACE_MASK];
+
+    if (XF_HAL_ATOMIC_LOAD(&slot->seq) != index + 1) {
+        return false;
+    }
+    memcpy(event, slot, sizeof(xf_hal_trace_event_t));
+    XF_HAL_ATOMIC_FENCE_ACQUIRE();
+
+    return XF_HAL_ATOMIC_LOAD_RELAXED(&slot->seq) == index + 1;
+}
+
+#endif
@@ -0,0 +1,164 @@
+/**
+ * @file xf_hal_trace.h
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 设备事件跟踪。
+ * @version 0.1
+ * @date 2024-07-24
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 需要在 xf_hal_config.h 中开启 XF_HAL_TRACE_ENABLE。
+ * 事件写入固定大小的环形缓冲区，写入只使用原子操作预留位置，可以在中断中调用。
+ * 对接层可以在中断和回调入口调用 xf_hal_trace_record 记录 XF_HAL_TRACE_EV_ISR 等事件。
+ * 导出的二进制数据由 tools/xf_hal_trace.py 转换为 Chrome trace 格式（chrome://tracing 或 Perfetto）。
+ * 用法：
+ * @code
+ * uint32_t start = xf_hal_trace_now();
+ * // 中断处理
+ * xf_hal_trace_record(XF_HAL_TRACE_EV_ISR, XF_HAL_UART, 1, start, len, 0);
+ * @endcode
+ */
+
+#ifndef __XF_HAL_TRACE_H__
+#define __XF_HAL_TRACE_H__
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal_kernel_config.h"
+
+/**
+ * @ingroup group_xf_hal_internal
+ * @defgroup group_xf_hal_internal_trace trace
+ * @brief 设备事件跟踪。
+ * @{
+ */
+
+#if XF_HAL_TRACE_IS_ENABLE
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+#define XF_HAL_TRACE_MAGIC      0x52544658  /*!< 导出数据的魔数，小端存储为 "XFTR" */
+#define XF_HAL_TRACE_VERSION    1
+#define XF_HAL_TRACE_NAME_SIZE  8           /*!< 导出数据中每个设备类型名的长度 */
+
+/* ==================== [Typedefs] ========================================== */
+
+/**
+ * @brief 跟踪时钟，返回单调递增的时间戳，允许溢出回绕。
+ */
+typedef uint32_t (*xf_hal_trace_clock_t)(void);
+
+/**
+ * @brief 导出函数，把 size 字节数据写到串口、文件等输出。
+ */
+typedef void (*xf_hal_trace_output_t)(const void *data, size_t size, void *user_data);
+
+typedef enum _xf_hal_trace_ev_t {
+    XF_HAL_TRACE_EV_OPEN = 0,   /*!< 设备打开 */
+    XF_HAL_TRACE_EV_CLOSE,      /*!< 设备关闭 */
+    XF_HAL_TRACE_EV_IOCTL,      /*!< 下发到驱动的 ioctl，arg 为命令 */
+    XF_HAL_TRACE_EV_READ,       /*!< 读取，arg 为请求大小 */
+    XF_HAL_TRACE_EV_WRITE,      /*!< 写入，arg 为请求大小 */
+    XF_HAL_TRACE_EV_SUBMIT,     /*!< 提交异步请求，arg 为请求大小 */
+    XF_HAL_TRACE_EV_CALLBACK,   /*!< 异步请求完成回调，ret 为请求结果 */
+    XF_HAL_TRACE_EV_ISR,        /*!< 对接层中断入口 */
+    XF_HAL_TRACE_EV_USER,       /*!< 对接层或应用自定义事件 */
+    XF_HAL_TRACE_EV_MAX,
+} xf_hal_trace_ev_t;
+
+/**
+ * @brief 跟踪事件，导出时按此布局（小端）原样输出。
+ */
+typedef struct _xf_hal_trace_event_t {
+    uint32_t seq;       /*!< 写入序号加 1，为 0 表示正在写入 */
+    uint32_t start;     /*!< 开始时间戳 */
+    uint32_t duration;  /*!< 持续时间 */
+    uint8_t ev;         /*!< 事件类型，见 @ref xf_hal_trace_ev_t */
+    uint8_t type;       /*!< 设备类型 */
+    uint16_t id;        /*!< 设备 id */
+    uint32_t arg;       /*!< 命令或长度 */
+    int32_t ret;        /*!< 返回值 */
+} xf_hal_trace_event_t;
+
+/**
+ * @brief 导出数据头，之后依次为 type_num 个设备类型名和 event_num 个事件。
+ */
+typedef struct _xf_hal_trace_header_t {
+    uint32_t magic;         /*!< XF_HAL_TRACE_MAGIC */
+    uint16_t version;       /*!< XF_HAL_TRACE_VERSION */
+    uint16_t event_size;    /*!< sizeof(xf_hal_trace_event_t) */
+    uint32_t clock_hz;      /*!< 时钟频率，为 0 时按微秒处理 */
+    uint32_t total;         /*!< 累计记录的事件数，大于 event_num 时说明最早的事件已被覆盖 */
+    uint32_t event_num;     /*!< 导出的事件数 */
+    uint8_t type_num;       /*!< 设备类型名数量 */
+    uint8_t reserved[3];
+} xf_hal_trace_header_t;
+
+/* ==================== [Global Prototypes] ================================= */
+
+/**
+ * @brief 设置跟踪时钟。
+ *
+ * @param clock 时钟函数，为 NULL 时时间戳均为 0。
+ * @param clock_hz 时钟频率，用于主机端换算时间，为 0 时按微秒处理。
+ */
+void xf_hal_trace_set_clock(xf_hal_trace_clock_t clock, uint32_t clock_hz);
+
+/**
+ * @brief 获取跟踪时钟的当前时间戳，未设置时钟时返回 0。
+ */
+uint32_t xf_hal_trace_now(void);
+
+/**
+ * @brief 记录一个事件，可以在中断中调用。
+ *
+ * @param ev 事件类型，见 @ref xf_hal_trace_ev_t.
+ * @param type 设备类型。
+ * @param id 设备 id。
+ * @param start 事件开始时由 xf_hal_trace_now 获取的时间戳，持续时间计算到本次调用。
+ * @param arg 命令或长度。
+ * @param ret 返回值。
+ */
+void xf_hal_trace_record(xf_hal_trace_ev_t ev, uint32_t type, uint32_t id, uint32_t start, uint32_t arg, int32_t ret);
+
+/**
+ * @brief 清空环形缓冲区。不能与 xf_hal_trace_record 同时调用。
+ */
+void xf_hal_trace_clear(void);
+
+/**
+ * @brief 按时间顺序导出缓冲区中的事件。导出期间新写入的事件可能被跳过。
+ *
+ * @param output 导出函数。
+ * @param user_data 传给导出函数的用户数据。
+ * @return uint32_t 导出的事件数
+ */
+uint32_t xf_hal_trace_dump(xf_hal_trace_output_t output, void *user_data);
+
+/* ==================== [Macros] ============================================ */
+
+#define XF_HAL_TRACE_BEGIN(start)                           uint32_t start = xf_hal_trace_now()
+#define XF_HAL_TRACE_END(ev, dev, start, arg, ret) \
+    xf_hal_trace_record((ev), (dev)->type, (dev)->id, (start), (uint32_t)(arg), (int32_t)(ret))
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#else
+
+#define XF_HAL_TRACE_BEGIN(start)                           (void)0
+#define XF_HAL_TRACE_END(ev, dev, start, arg, ret)          do {} while (0)
+
+#endif
+
+/**
+ * End of group_xf_hal_internal_trace
+ * @}
+ */
+
+#endif // __XF_HAL_TRACE_H__
@@ -0,0 +1,1295 @@
+/**
+ * @file xf_hal.hpp
+ * @author cangyu (sky.kirto@qq.com)
+ * @brief xf_hal 的 C++17 封装，仅头文件。
+ * @version 0.1
+ * @date 2024-08-05
+ *
+ * @copyright Copyright (c) 2024, CorAL. All rights reserved.
+ *
+ * @details 设备号为模板参数，如 `xf::hal::Gpio<5>`、`xf::hal::Spi<1>`，每个设备号是一个独立的类型，
+ * 所有方法均为静态方法，也可以通过对象调用。
+ *
+ * 配置通过 constexpr 构建器（GpioConfig、SpiConfig 等）在编译期填充 xf_hal_*_config_t，
+ * init 在一次配置事务中只下发构建器设置过的字段；构建器为 constexpr 时未设置字段的分支在编译期消去。
+ *
+ * init 之后缓存设备句柄，gpio、tim、adc、uart 的读写直接经 xf_hal_dev_read / xf_hal_dev_write
+ * 调用驱动，不做设备查找也不经过 C 接口的参数检查；开启静态分发（XF_HAL_STATIC_DISPATCH_ENABLE）
+ * 时进一步成为对对接函数的直接调用。其余设备的读写需要先设置超时、地址等，仍调用 C 的句柄接口。
+ *
+ * 通过 C 接口 deinit 设备后缓存的句柄失效，应使用本文件的 deinit。
+ *
+ * 以 C++20 编译时 uart、spi、i2c 另提供 read_async / write_async 等可等待对象，
+ * 建立在异步请求（xf_hal_*_submit）之上：`int n = co_await Uart<1>::read_async(buf, sizeof(buf));`
+ * 等待期间协程挂起而不阻塞线程，请求完成回调中恢复协程，见 set_resume_hook。
+ */
+
+#ifndef __XF_HAL_HPP__
+#define __XF_HAL_HPP__
+
+#if __cplusplus < 201703L
+#error "xf_hal.hpp requires C++17"
+#endif
+
+/* ==================== [Includes] ========================================== */
+
+#include "xf_hal.h"
+#include "kernel/xf_hal_dev.h"
+#include <cstddef>
+#include <cstdint>
+
+#if defined(__cpp_impl_coroutine) && defined(__has_include)
+#if __has_include(<coroutine>)
+#   define XF_HAL_CO_IS_ENABLE  (1)
+#endif
+#endif
+
+#if !defined(XF_HAL_CO_IS_ENABLE)
+#   define XF_HAL_CO_IS_ENABLE  (0)
+#endif
+
+#if XF_HAL_CO_IS_ENABLE
+#include <atomic>
+#include <coroutine>
+#endif
+
+/* ==================== [Defines] =========================================== */
+
+/* ==================== [Typedefs] ========================================== */
+
+namespace xf {
+namespace hal {
+
+namespace detail {
+
+/**
+ * @brief 驱动读写返回值转为错误码，成功返回 XF_OK。
+ */
+inline xf_err_t to_err(int ret)
+{
+    return (ret < 0) ? (xf_err_t)(-ret) : XF_OK;
+}
+
+#if XF_HAL_CO_IS_ENABLE
+using resume_hook_t = void (*)(std::coroutine_handle<> handle);
+
+inline resume_hook_t s_resume_hook = nullptr;
+#endif
+
+} // namespace detail
+
+#if XF_HAL_CO_IS_ENABLE
+/**
+ * @brief 设置协程恢复钩子。
+ *
+ * 请求完成回调在驱动完成传输的上下文中执行（可能是中断）。未设置钩子时直接在该上下文中恢复协程；
+ * 设置后改为调用钩子，由钩子把协程投递到执行器的就绪队列。
+ *
+ * @param hook 恢复钩子，nullptr 恢复为直接恢复。
+ */
+inline void set_resume_hook(detail::resume_hook_t hook)
+{
+    detail::s_resume_hook = hook;
+}
+
+/**
+ * @brief 异步传输的可等待对象，由 read_async / write_async 等返回，co_await 得到与同步读写相同的返回值：
+ * 非负数为实际传输大小，负数为错误码。
+ *
+ * 请求在 co_await 时才提交；驱动不支持异步时请求在提交中同步完成，协程不会挂起。
+ * 协程挂起期间不能销毁，否则请求在完成前失效。
+ */
+class Transfer {
+public:
+    using submit_t = xf_err_t (*)(xf_hal_req_t *req, uint32_t timeout_ms, uint32_t mem_addr);
+
+    Transfer(submit_t submit, xf_hal_req_dir_t dir, const void *buf, size_t count, uint32_t timeout_ms = 0,
+             uint32_t mem_addr = 0)
+        : m_submit(submit), m_timeout_ms(timeout_ms), m_mem_addr(mem_addr), m_done(false)
+    {
+        xf_hal_req_init(&m_req, dir, const_cast<void *>(buf), count, on_complete, this);
+    }
+
+    // 请求挂在设备队列中，不能复制或移动
+    Transfer(const Transfer &) = delete;
+    Transfer &operator=(const Transfer &) = delete;
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) noexcept
+    {
+        m_handle = handle;
+
+        xf_err_t err = m_submit(&m_req, m_timeout_ms, m_mem_addr);
+        if (err != XF_OK) {
+            m_req.result = -(int)err;
+            return false;
+        }
+
+        // 与完成回调竞争，后到的一方负责恢复：回调已先执行时不挂起
+        return !m_done.exchange(true, std::memory_order_acq_rel);
+    }
+
+    int await_resume() const noexcept
+    {
+        return m_req.result;
+    }
+
+private:
+    static void on_complete(xf_hal_req_t *req)
+    {
+        Transfer *self = static_cast<Transfer *>(req->user_data);
+
+        if (!self->m_done.exchange(true, std::memory_order_acq_rel)) {
+            return;
+        }
+
+        if (detail::s_resume_hook != nullptr) {
+            detail::s_resume_hook(self->m_handle);
+        } else {
+            self->m_handle.resume();
+        }
+    }
+
+    xf_hal_req_t m_req;
+    submit_t m_submit;
+    uint32_t m_timeout_ms;
+    uint32_t m_mem_addr;
+    std::atomic<bool> m_done;
+    std::coroutine_handle<> m_handle;
+};
+#endif // XF_HAL_CO_IS_ENABLE
+
+#if XF_HAL_GPIO_IS_ENABLE
+/**
+ * @brief gpio 配置构建器，方向为必填项。
+ */
+class GpioConfig {
+public:
+    constexpr explicit GpioConfig(xf_hal_gpio_dir_t direction) : m_config(), m_cmd(XF_HAL_GPIO_CMD_DIRECTION)
+    {
+        m_config.direction = direction;
+    }
+
+    constexpr GpioConfig pull(xf_hal_gpio_pull_t pull) const
+    {
+        GpioConfig c = *this;
+        c.m_config.pull = pull;
+        c.m_cmd |= XF_HAL_GPIO_CMD_PULL;
+        return c;
+    }
+
+    constexpr GpioConfig speed(uint32_t speed) const
+    {
+        GpioConfig c = *this;
+        c.m_config.speed = speed;
+        c.m_cmd |= XF_HAL_GPIO_CMD_SPEED;
+        return c;
+    }
+
+    /**
+     * @brief 中断类型与回调（运行于异步任务），设置后 init 会启用中断。
+     */
+    constexpr GpioConfig intr(xf_hal_gpio_intr_type_t type, xf_hal_gpio_irq_cb_t callback,
+                              void *user_data = nullptr) const
+    {
+        GpioConfig c = *this;
+        c.m_config.intr_type = type;
+        c.m_config.intr_enable = 1;
+        c.m_config.cb.callback = callback;
+        c.m_config.cb.user_data = user_data;
+        c.m_cmd |= XF_HAL_GPIO_CMD_INTR_TYPE | XF_HAL_GPIO_CMD_INTR_ENABLE | XF_HAL_GPIO_CMD_INTR_CB;
+        return c;
+    }
+
+    /**
+     * @brief 中断类型与中断服务函数（运行于中断），设置后 init 会启用中断。
+     */
+    constexpr GpioConfig intr_isr(xf_hal_gpio_intr_type_t type, xf_hal_gpio_irq_cb_t callback,
+                                  void *user_data = nullptr) const
+    {
+        GpioConfig c = *this;
+        c.m_config.intr_type = type;
+        c.m_config.intr_enable = 1;
+        c.m_config.isr.callback = callback;
+        c.m_config.isr.user_data = user_data;
+        c.m_cmd |= XF_HAL_GPIO_CMD_INTR_TYPE | XF_HAL_GPIO_CMD_INTR_ENABLE | XF_HAL_GPIO_CMD_INTR_ISR;
+        return c;
+    }
+
+    constexpr const xf_hal_gpio_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_gpio_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief gpio 设备。
+ *
+ * @tparam N gpio 号。
+ */
+template <xf_gpio_num_t N>
+class Gpio {
+public:
+    static constexpr xf_gpio_num_t num = N;
+
+    static xf_err_t init(const GpioConfig &config)
+    {
+        const xf_hal_gpio_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_gpio_init(N, (xf_hal_gpio_dir_t)c.direction);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_gpio_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_GPIO_CMD_PULL)) {
+            err = xf_hal_gpio_set_pull(N, (xf_hal_gpio_pull_t)c.pull);
+        }
+        if (err == XF_OK && config.has(XF_HAL_GPIO_CMD_SPEED)) {
+            err = xf_hal_gpio_set_speed(N, c.speed);
+        }
+        if (err == XF_OK && config.has(XF_HAL_GPIO_CMD_INTR_CB)) {
+            err = xf_hal_gpio_set_intr_cb(N, c.cb.callback, c.cb.user_data);
+        }
+        if (err == XF_OK && config.has(XF_HAL_GPIO_CMD_INTR_ISR)) {
+            err = xf_hal_gpio_set_intr_isr(N, c.isr.callback, c.isr.user_data);
+        }
+        if (err == XF_OK && config.has(XF_HAL_GPIO_CMD_INTR_TYPE)) {
+            err = xf_hal_gpio_set_intr_type(N, (xf_hal_gpio_intr_type_t)c.intr_type);
+        }
+        if (err == XF_OK && config.has(XF_HAL_GPIO_CMD_INTR_ENABLE)) {
+            err = xf_hal_gpio_set_intr_enable(N);
+        }
+        xf_err_t commit = xf_hal_gpio_config_commit(N);
+
+        s_handle = xf_hal_gpio_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_gpio_deinit(N);
+    }
+
+    static xf_err_t set_level(bool level)
+    {
+        if (s_handle == nullptr) {
+            return XF_ERR_UNINIT;
+        }
+        return detail::to_err(XF_HAL_DEV_WRITE(GPIO, (xf_hal_dev_t *)s_handle, &level, 1));
+    }
+
+    static bool get_level()
+    {
+        bool level = false;
+        if (s_handle != nullptr) {
+            XF_HAL_DEV_READ(GPIO, (xf_hal_dev_t *)s_handle, &level, 1);
+        }
+        return level;
+    }
+
+    static xf_hal_gpio_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+    static inline xf_hal_gpio_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_GPIO_IS_ENABLE
+
+#if XF_HAL_TIM_IS_ENABLE
+/**
+ * @brief 定时器配置构建器，计数频率为必填项。
+ */
+class TimConfig {
+public:
+    constexpr explicit TimConfig(uint32_t tick_freq_hz, xf_hal_tim_count_dir_t count_dir = XF_HAL_TIM_COUNT_DIR_UP,
+                                 bool auto_reload = true)
+        : m_config(), m_cmd(0)
+    {
+        m_config.tick_freq_hz = tick_freq_hz;
+        m_config.count_dir = count_dir;
+        m_config.auto_reload = auto_reload;
+    }
+
+    constexpr TimConfig callback(xf_hal_tim_cb_t callback, void *user_data = nullptr) const
+    {
+        TimConfig c = *this;
+        c.m_config.cb.callback = callback;
+        c.m_config.cb.user_data = user_data;
+        c.m_cmd |= XF_HAL_TIM_CMD_CB;
+        return c;
+    }
+
+    constexpr TimConfig isr(xf_hal_tim_cb_t callback, void *user_data = nullptr) const
+    {
+        TimConfig c = *this;
+        c.m_config.isr.callback = callback;
+        c.m_config.isr.user_data = user_data;
+        c.m_cmd |= XF_HAL_TIM_CMD_ISR;
+        return c;
+    }
+
+    constexpr const xf_hal_tim_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_tim_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief 定时器设备。
+ *
+ * @tparam N 定时器号。
+ */
+template <xf_tim_num_t N>
+class Tim {
+public:
+    static constexpr xf_tim_num_t num = N;
+
+    static xf_err_t init(const TimConfig &config)
+    {
+        const xf_hal_tim_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_tim_init(N, c.tick_freq_hz, (xf_hal_tim_count_dir_t)c.count_dir, c.auto_reload);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_tim_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_TIM_CMD_CB)) {
+            err = xf_hal_tim_set_cb(N, c.cb.callback, c.cb.user_data);
+        }
+        if (err == XF_OK && config.has(XF_HAL_TIM_CMD_ISR)) {
+            err = xf_hal_tim_set_isr(N, c.isr.callback, c.isr.user_data);
+        }
+        xf_err_t commit = xf_hal_tim_config_commit(N);
+
+        s_handle = xf_hal_tim_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_tim_deinit(N);
+    }
+
+    static xf_err_t start(uint32_t target_ticks)
+    {
+        return xf_hal_tim_start(N, target_ticks);
+    }
+
+    static xf_err_t stop()
+    {
+        return xf_hal_tim_stop(N);
+    }
+
+    static xf_err_t set_raw_ticks(uint32_t ticks)
+    {
+        if (s_handle == nullptr) {
+            return XF_ERR_UNINIT;
+        }
+        return detail::to_err(XF_HAL_DEV_WRITE(TIM, (xf_hal_dev_t *)s_handle, &ticks, 1));
+    }
+
+    static uint32_t get_raw_ticks()
+    {
+        uint32_t ticks = 0;
+        if (s_handle != nullptr) {
+            XF_HAL_DEV_READ(TIM, (xf_hal_dev_t *)s_handle, &ticks, 1);
+        }
+        return ticks;
+    }
+
+    static xf_hal_tim_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+    static inline xf_hal_tim_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_TIM_IS_ENABLE
+
+#if XF_HAL_PWM_IS_ENABLE
+/**
+ * @brief pwm 配置构建器，频率与占空比为必填项。
+ */
+class PwmConfig {
+public:
+    constexpr PwmConfig(uint32_t freq, uint32_t duty) : m_config(), m_cmd(0)
+    {
+        m_config.freq = freq;
+        m_config.duty = duty;
+    }
+
+    constexpr PwmConfig duty_resolution(uint32_t duty_resolution) const
+    {
+        PwmConfig c = *this;
+        c.m_config.duty_resolution = duty_resolution;
+        c.m_cmd |= XF_HAL_PWM_CMD_DUTY_RESOLUTION;
+        return c;
+    }
+
+    constexpr PwmConfig gpio(xf_gpio_num_t io_num) const
+    {
+        PwmConfig c = *this;
+        c.m_config.io_num = io_num;
+        c.m_cmd |= XF_HAL_PWM_CMD_IO_NUM;
+        return c;
+    }
+
+    constexpr const xf_hal_pwm_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_pwm_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief pwm 设备。
+ *
+ * @tparam N pwm 号。
+ */
+template <xf_pwm_num_t N>
+class Pwm {
+public:
+    static constexpr xf_pwm_num_t num = N;
+
+    static xf_err_t init(const PwmConfig &config)
+    {
+        const xf_hal_pwm_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_pwm_init(N, c.freq, c.duty);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_pwm_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_PWM_CMD_DUTY_RESOLUTION)) {
+            err = xf_hal_pwm_set_duty_resolution(N, c.duty_resolution);
+        }
+        if (err == XF_OK && config.has(XF_HAL_PWM_CMD_IO_NUM)) {
+            err = xf_hal_pwm_set_gpio(N, c.io_num);
+        }
+        xf_err_t commit = xf_hal_pwm_config_commit(N);
+
+        s_handle = xf_hal_pwm_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_pwm_deinit(N);
+    }
+
+    static xf_err_t enable()
+    {
+        return xf_hal_pwm_enable(N);
+    }
+
+    static xf_err_t disable()
+    {
+        return xf_hal_pwm_disable(N);
+    }
+
+    static xf_err_t set_duty(uint32_t duty)
+    {
+        return xf_hal_pwm_handle_set_duty(s_handle, duty);
+    }
+
+    static xf_hal_pwm_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+    static inline xf_hal_pwm_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_PWM_IS_ENABLE
+
+#if XF_HAL_ADC_IS_ENABLE
+/**
+ * @brief adc 配置构建器。
+ */
+class AdcConfig {
+public:
+    constexpr AdcConfig() : m_config(), m_cmd(0)
+    {
+    }
+
+    constexpr AdcConfig resolution(uint8_t resolution) const
+    {
+        AdcConfig c = *this;
+        c.m_config.resolution = resolution;
+        c.m_cmd |= XF_HAL_ADC_CMD_RESOLUTION;
+        return c;
+    }
+
+    constexpr AdcConfig sample_rate(uint32_t sample_rate) const
+    {
+        AdcConfig c = *this;
+        c.m_config.sample_rate = sample_rate;
+        c.m_cmd |= XF_HAL_ADC_CMD_SAMPLE_RATE;
+        return c;
+    }
+
+    constexpr const xf_hal_adc_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_adc_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief adc 设备。
+ *
+ * @tparam N adc 号。
+ */
+template <xf_adc_num_t N>
+class Adc {
+public:
+    static constexpr xf_adc_num_t num = N;
+
+    static xf_err_t init(const AdcConfig &config = AdcConfig())
+    {
+        const xf_hal_adc_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_adc_init(N);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_adc_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_ADC_CMD_RESOLUTION)) {
+            err = xf_hal_adc_set_resolution(N, c.resolution);
+        }
+        if (err == XF_OK && config.has(XF_HAL_ADC_CMD_SAMPLE_RATE)) {
+            err = xf_hal_adc_set_sample_rate(N, c.sample_rate);
+        }
+        xf_err_t commit = xf_hal_adc_config_commit(N);
+
+        s_handle = xf_hal_adc_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_adc_deinit(N);
+    }
+
+    static xf_err_t enable()
+    {
+        return xf_hal_adc_enable(N);
+    }
+
+    static xf_err_t disable()
+    {
+        return xf_hal_adc_disable(N);
+    }
+
+    static uint32_t read_raw()
+    {
+        uint32_t data = 0;
+        if (s_handle != nullptr) {
+            XF_HAL_DEV_READ(ADC, (xf_hal_dev_t *)s_handle, &data, 1);
+        }
+        return data;
+    }
+
+    static xf_hal_adc_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+    static inline xf_hal_adc_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_ADC_IS_ENABLE
+
+#if XF_HAL_DAC_IS_ENABLE
+/**
+ * @brief dac 配置构建器。
+ */
+class DacConfig {
+public:
+    constexpr DacConfig() : m_config(), m_cmd(0)
+    {
+    }
+
+    constexpr DacConfig resolution(uint8_t resolution) const
+    {
+        DacConfig c = *this;
+        c.m_config.resolution = resolution;
+        c.m_cmd |= XF_HAL_DAC_CMD_RESOLUTION;
+        return c;
+    }
+
+    constexpr DacConfig speed(uint32_t speed) const
+    {
+        DacConfig c = *this;
+        c.m_config.speed = speed;
+        c.m_cmd |= XF_HAL_DAC_CMD_SPEED;
+        return c;
+    }
+
+    constexpr const xf_hal_dac_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_dac_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief dac 设备。
+ *
+ * @tparam N dac 号。
+ */
+template <xf_dac_num_t N>
+class Dac {
+public:
+    static constexpr xf_dac_num_t num = N;
+
+    static xf_err_t init(const DacConfig &config = DacConfig())
+    {
+        const xf_hal_dac_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_dac_init(N);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_dac_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_DAC_CMD_RESOLUTION)) {
+            err = xf_hal_dac_set_resolution(N, c.resolution);
+        }
+        if (err == XF_OK && config.has(XF_HAL_DAC_CMD_SPEED)) {
+            err = xf_hal_dac_set_speed(N, c.speed);
+        }
+        xf_err_t commit = xf_hal_dac_config_commit(N);
+
+        s_handle = xf_hal_dac_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_dac_deinit(N);
+    }
+
+    static xf_err_t enable()
+    {
+        return xf_hal_dac_enable(N);
+    }
+
+    static xf_err_t disable()
+    {
+        return xf_hal_dac_disable(N);
+    }
+
+    /**
+     * @brief 写入数值，需检查是否超出 value_max，因此调用 C 的句柄接口。
+     */
+    static xf_err_t write(uint32_t value)
+    {
+        return xf_hal_dac_handle_write(s_handle, value);
+    }
+
+    static xf_err_t write_mv(uint32_t mv)
+    {
+        return xf_hal_dac_write_mv(N, mv);
+    }
+
+    static xf_hal_dac_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+    static inline xf_hal_dac_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_DAC_IS_ENABLE
+
+#if XF_HAL_UART_IS_ENABLE
+/**
+ * @brief uart 配置构建器，波特率为必填项。
+ */
+class UartConfig {
+public:
+    constexpr explicit UartConfig(uint32_t baudrate) : m_config(), m_cmd(0)
+    {
+        m_config.baudrate = baudrate;
+    }
+
+    constexpr UartConfig format(xf_hal_uart_data_bits_t data_bits, xf_hal_uart_stop_bits_t stop_bits,
+                                xf_hal_uart_parity_bits_t parity_bits) const
+    {
+        UartConfig c = *this;
+        c.m_config.data_bits = data_bits;
+        c.m_config.stop_bits = stop_bits;
+        c.m_config.parity_bits = parity_bits;
+        c.m_cmd |= XF_HAL_UART_CMD_DATA_BITS | XF_HAL_UART_CMD_STOP_BITS | XF_HAL_UART_CMD_PARITY_BITS;
+        return c;
+    }
+
+    constexpr UartConfig gpio(xf_gpio_num_t tx_num, xf_gpio_num_t rx_num) const
+    {
+        UartConfig c = *this;
+        c.m_config.tx_num = tx_num;
+        c.m_config.rx_num = rx_num;
+        c.m_cmd |= XF_HAL_UART_CMD_TX_NUM | XF_HAL_UART_CMD_RX_NUM;
+        return c;
+    }
+
+    constexpr UartConfig flow_control(xf_hal_uart_flow_control_t flow_control, xf_gpio_num_t rts_num,
+                                      xf_gpio_num_t cts_num) const
+    {
+        UartConfig c = *this;
+        c.m_config.flow_control = flow_control;
+        c.m_config.rts_num = rts_num;
+        c.m_config.cts_num = cts_num;
+        c.m_cmd |= XF_HAL_UART_CMD_FLOW_CONTROL | XF_HAL_UART_CMD_RTS_NUM | XF_HAL_UART_CMD_CTS_NUM;
+        return c;
+    }
+
+    constexpr const xf_hal_uart_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_uart_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief uart 设备。
+ *
+ * @tparam N uart 号。
+ */
+template <xf_uart_num_t N>
+class Uart {
+public:
+    static constexpr xf_uart_num_t num = N;
+
+    static xf_err_t init(const UartConfig &config)
+    {
+        const xf_hal_uart_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_uart_init(N, c.baudrate);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_uart_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_UART_CMD_DATA_BITS)) {
+            err = xf_hal_uart_set_config(N, (xf_hal_uart_data_bits_t)c.data_bits,
+                                         (xf_hal_uart_stop_bits_t)c.stop_bits,
+                                         (xf_hal_uart_parity_bits_t)c.parity_bits);
+        }
+        if (err == XF_OK && config.has(XF_HAL_UART_CMD_TX_NUM)) {
+            err = xf_hal_uart_set_gpio(N, c.tx_num, c.rx_num);
+        }
+        if (err == XF_OK && config.has(XF_HAL_UART_CMD_FLOW_CONTROL)) {
+            err = xf_hal_uart_set_flow_control(N, (xf_hal_uart_flow_control_t)c.flow_control, c.rts_num, c.cts_num);
+        }
+        xf_err_t commit = xf_hal_uart_config_commit(N);
+
+        s_handle = xf_hal_uart_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_uart_deinit(N);
+    }
+
+    static xf_err_t enable()
+    {
+        return xf_hal_uart_enable(N);
+    }
+
+    static xf_err_t disable()
+    {
+        return xf_hal_uart_disable(N);
+    }
+
+    /**
+     * @brief 读取数据，返回读取的字节数，失败返回负的错误码。
+     */
+    static int read(uint8_t *data, uint32_t data_len)
+    {
+        if (s_handle == nullptr) {
+            return -XF_ERR_UNINIT;
+        }
+        return XF_HAL_DEV_READ(UART, (xf_hal_dev_t *)s_handle, data, data_len);
+    }
+
+    /**
+     * @brief 发送数据，返回发送的字节数，失败返回负的错误码。
+     */
+    static int write(const uint8_t *data, uint32_t data_len)
+    {
+        if (s_handle == nullptr) {
+            return -XF_ERR_UNINIT;
+        }
+        return XF_HAL_DEV_WRITE(UART, (xf_hal_dev_t *)s_handle, data, data_len);
+    }
+
+#if XF_HAL_CO_IS_ENABLE
+    static Transfer read_async(uint8_t *data, uint32_t data_len)
+    {
+        return Transfer(submit, XF_HAL_REQ_DIR_READ, data, data_len);
+    }
+
+    static Transfer write_async(const uint8_t *data, uint32_t data_len)
+    {
+        return Transfer(submit, XF_HAL_REQ_DIR_WRITE, data, data_len);
+    }
+#endif
+
+    static xf_hal_uart_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+#if XF_HAL_CO_IS_ENABLE
+    static xf_err_t submit(xf_hal_req_t *req, uint32_t /* timeout_ms */, uint32_t /* mem_addr */)
+    {
+        return xf_hal_uart_submit(N, req);
+    }
+#endif
+
+    static inline xf_hal_uart_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_UART_IS_ENABLE
+
+#if XF_HAL_I2C_IS_ENABLE
+/**
+ * @brief i2c 配置构建器，主从模式与速度为必填项。
+ */
+class I2cConfig {
+public:
+    constexpr I2cConfig(xf_hal_i2c_hosts_t hosts, uint32_t speed) : m_config(), m_cmd(0)
+    {
+        m_config.hosts = hosts;
+        m_config.speed = speed;
+    }
+
+    constexpr I2cConfig gpio(xf_gpio_num_t scl_num, xf_gpio_num_t sda_num) const
+    {
+        I2cConfig c = *this;
+        c.m_config.scl_num = scl_num;
+        c.m_config.sda_num = sda_num;
+        c.m_cmd |= XF_HAL_I2C_CMD_SCL_NUM | XF_HAL_I2C_CMD_SDA_NUM;
+        return c;
+    }
+
+    constexpr I2cConfig address(uint16_t address,
+                                xf_hal_i2c_address_width_t width = XF_HAL_I2C_ADDRESS_WIDTH_7BIT) const
+    {
+        I2cConfig c = *this;
+        c.m_config.address = address;
+        c.m_config.address_width = width;
+        c.m_cmd |= XF_HAL_I2C_CMD_ADDRESS | XF_HAL_I2C_CMD_ADDRESS_WIDTH;
+        return c;
+    }
+
+    constexpr I2cConfig mem_addr_width(xf_hal_i2c_mem_addr_width_t width) const
+    {
+        I2cConfig c = *this;
+        c.m_config.mem_addr_width = width;
+        c.m_cmd |= XF_HAL_I2C_CMD_MEM_ADDR_WIDTH;
+        return c;
+    }
+
+    constexpr const xf_hal_i2c_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_i2c_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief i2c 设备。
+ *
+ * @tparam N i2c 号。
+ */
+template <xf_i2c_num_t N>
+class I2c {
+public:
+    static constexpr xf_i2c_num_t num = N;
+
+    static xf_err_t init(const I2cConfig &config)
+    {
+        const xf_hal_i2c_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_i2c_init(N, (xf_hal_i2c_hosts_t)c.hosts, c.speed);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_i2c_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_I2C_CMD_SCL_NUM)) {
+            err = xf_hal_i2c_set_gpio(N, c.scl_num, c.sda_num);
+        }
+        if (err == XF_OK && config.has(XF_HAL_I2C_CMD_ADDRESS_WIDTH)) {
+            err = xf_hal_i2c_set_address_width(N, (xf_hal_i2c_address_width_t)c.address_width);
+        }
+        if (err == XF_OK && config.has(XF_HAL_I2C_CMD_ADDRESS)) {
+            err = xf_hal_i2c_set_address(N, c.address);
+        }
+        if (err == XF_OK && config.has(XF_HAL_I2C_CMD_MEM_ADDR_WIDTH)) {
+            err = xf_hal_i2c_set_mem_addr_width(N, (xf_hal_i2c_mem_addr_width_t)c.mem_addr_width);
+        }
+        xf_err_t commit = xf_hal_i2c_config_commit(N);
+
+        s_handle = xf_hal_i2c_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_i2c_deinit(N);
+    }
+
+    static xf_err_t enable()
+    {
+        return xf_hal_i2c_enable(N);
+    }
+
+    static xf_err_t disable()
+    {
+        return xf_hal_i2c_disable(N);
+    }
+
+    static int write(const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return xf_hal_i2c_handle_write(s_handle, buffer, size, timeout_ms);
+    }
+
+    static int read(uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return xf_hal_i2c_handle_read(s_handle, buffer, size, timeout_ms);
+    }
+
+    static int write_mem(uint32_t mem_addr, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return xf_hal_i2c_handle_write_mem(s_handle, mem_addr, buffer, size, timeout_ms);
+    }
+
+    static int read_mem(uint32_t mem_addr, uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return xf_hal_i2c_handle_read_mem(s_handle, mem_addr, buffer, size, timeout_ms);
+    }
+
+#if XF_HAL_CO_IS_ENABLE
+    static Transfer write_async(const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return Transfer(submit, XF_HAL_REQ_DIR_WRITE, buffer, size, timeout_ms);
+    }
+
+    static Transfer read_async(uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return Transfer(submit, XF_HAL_REQ_DIR_READ, buffer, size, timeout_ms);
+    }
+
+    static Transfer write_mem_async(uint32_t mem_addr, const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return Transfer(submit_mem, XF_HAL_REQ_DIR_WRITE, buffer, size, timeout_ms, mem_addr);
+    }
+
+    static Transfer read_mem_async(uint32_t mem_addr, uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return Transfer(submit_mem, XF_HAL_REQ_DIR_READ, buffer, size, timeout_ms, mem_addr);
+    }
+#endif
+
+    static xf_hal_i2c_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+#if XF_HAL_CO_IS_ENABLE
+    static xf_err_t submit(xf_hal_req_t *req, uint32_t timeout_ms, uint32_t /* mem_addr */)
+    {
+        return xf_hal_i2c_submit(N, req, timeout_ms);
+    }
+
+    static xf_err_t submit_mem(xf_hal_req_t *req, uint32_t timeout_ms, uint32_t mem_addr)
+    {
+        return xf_hal_i2c_submit_mem(N, mem_addr, req, timeout_ms);
+    }
+#endif
+
+    static inline xf_hal_i2c_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_I2C_IS_ENABLE
+
+#if XF_HAL_SPI_IS_ENABLE
+/**
+ * @brief spi 配置构建器，主从模式与速度为必填项。
+ */
+class SpiConfig {
+public:
+    constexpr SpiConfig(xf_hal_spi_hosts_t hosts, uint32_t speed) : m_config(), m_cmd(0)
+    {
+        m_config.hosts = hosts;
+        m_config.speed = speed;
+    }
+
+    constexpr SpiConfig mode(xf_hal_spi_mode_t mode) const
+    {
+        SpiConfig c = *this;
+        c.m_config.mode = mode;
+        c.m_cmd |= XF_HAL_SPI_CMD_MODE;
+        return c;
+    }
+
+    constexpr SpiConfig bit_order(xf_hal_spi_bit_order_t bit_order) const
+    {
+        SpiConfig c = *this;
+        c.m_config.bit_order = bit_order;
+        c.m_cmd |= XF_HAL_SPI_CMD_BIT_ORDER;
+        return c;
+    }
+
+    constexpr SpiConfig data_width(xf_hal_spi_data_width_t data_width) const
+    {
+        SpiConfig c = *this;
+        c.m_config.data_width = data_width;
+        c.m_cmd |= XF_HAL_SPI_CMD_DATA_WIDTH;
+        return c;
+    }
+
+    /**
+     * @brief 四线引脚，quad 模式的 data2 / data3 保持默认。
+     */
+    constexpr SpiConfig gpio(xf_gpio_num_t sclk_num, xf_gpio_num_t cs_num, xf_gpio_num_t mosi_num,
+                             xf_gpio_num_t miso_num) const
+    {
+        SpiConfig c = *this;
+        c.m_config.gpio.sclk_num = sclk_num;
+        c.m_config.gpio.cs_num = cs_num;
+        c.m_config.gpio.data0_num = mosi_num;
+        c.m_config.gpio.data1_num = miso_num;
+        c.m_cmd |= XF_HAL_SPI_CMD_GPIO;
+        return c;
+    }
+
+    constexpr SpiConfig prev_cb(xf_hal_spi_cb_t callback, void *user_data = nullptr) const
+    {
+        SpiConfig c = *this;
+        c.m_config.prev_cb.callback = callback;
+        c.m_config.prev_cb.user_data = user_data;
+        c.m_cmd |= XF_HAL_SPI_CMD_PREV_CB;
+        return c;
+    }
+
+    constexpr SpiConfig post_cb(xf_hal_spi_cb_t callback, void *user_data = nullptr) const
+    {
+        SpiConfig c = *this;
+        c.m_config.post_cb.callback = callback;
+        c.m_config.post_cb.user_data = user_data;
+        c.m_cmd |= XF_HAL_SPI_CMD_POST_CB;
+        return c;
+    }
+
+    constexpr const xf_hal_spi_config_t &raw() const
+    {
+        return m_config;
+    }
+
+    constexpr bool has(uint32_t cmd) const
+    {
+        return (m_cmd & cmd) != 0;
+    }
+
+private:
+    xf_hal_spi_config_t m_config;
+    uint32_t m_cmd;
+};
+
+/**
+ * @brief spi 设备。
+ *
+ * @tparam N spi 号。
+ */
+template <xf_spi_num_t N>
+class Spi {
+public:
+    static constexpr xf_spi_num_t num = N;
+
+    static xf_err_t init(const SpiConfig &config)
+    {
+        const xf_hal_spi_config_t &c = config.raw();
+
+        xf_err_t err = xf_hal_spi_init(N, (xf_hal_spi_hosts_t)c.hosts, c.speed);
+        if (err != XF_OK) {
+            return err;
+        }
+
+        xf_hal_spi_config_begin(N);
+        if (err == XF_OK && config.has(XF_HAL_SPI_CMD_MODE)) {
+            err = xf_hal_spi_set_mode(N, (xf_hal_spi_mode_t)c.mode);
+        }
+        if (err == XF_OK && config.has(XF_HAL_SPI_CMD_BIT_ORDER)) {
+            err = xf_hal_spi_set_bit_order(N, (xf_hal_spi_bit_order_t)c.bit_order);
+        }
+        if (err == XF_OK && config.has(XF_HAL_SPI_CMD_DATA_WIDTH)) {
+            err = xf_hal_spi_set_data_width(N, (xf_hal_spi_data_width_t)c.data_width);
+        }
+        if (err == XF_OK && config.has(XF_HAL_SPI_CMD_GPIO)) {
+            err = xf_hal_spi_set_gpio(N, &c.gpio);
+        }
+        if (err == XF_OK && config.has(XF_HAL_SPI_CMD_PREV_CB)) {
+            err = xf_hal_spi_set_prev_cb(N, c.prev_cb.callback, c.prev_cb.user_data);
+        }
+        if (err == XF_OK && config.has(XF_HAL_SPI_CMD_POST_CB)) {
+            err = xf_hal_spi_set_post_cb(N, c.post_cb.callback, c.post_cb.user_data);
+        }
+        xf_err_t commit = xf_hal_spi_config_commit(N);
+
+        s_handle = xf_hal_spi_get_handle(N);
+
+        return (err != XF_OK) ? err : commit;
+    }
+
+    static xf_err_t deinit()
+    {
+        s_handle = nullptr;
+        return xf_hal_spi_deinit(N);
+    }
+
+    static xf_err_t enable()
+    {
+        return xf_hal_spi_enable(N);
+    }
+
+    static xf_err_t disable()
+    {
+        return xf_hal_spi_disable(N);
+    }
+
+    static int write(const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return xf_hal_spi_handle_write(s_handle, buffer, size, timeout_ms);
+    }
+
+    static int read(uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return xf_hal_spi_handle_read(s_handle, buffer, size, timeout_ms);
+    }
+
+#if XF_HAL_CO_IS_ENABLE
+    static Transfer write_async(const uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return Transfer(submit, XF_HAL_REQ_DIR_WRITE, buffer, size, timeout_ms);
+    }
+
+    static Transfer read_async(uint8_t *buffer, uint32_t size, uint32_t timeout_ms)
+    {
+        return Transfer(submit, XF_HAL_REQ_DIR_READ, buffer, size, timeout_ms);
+    }
+#endif
+
+    static xf_hal_spi_handle_t handle()
+    {
+        return s_handle;
+    }
+
+private:
+#if XF_HAL_CO_IS_ENABLE
+    static xf_err_t submit(xf_hal_req_t *req, uint32_t timeout_ms, uint32_t /* mem_addr */)
+    {
+        return xf_hal_spi_submit(N, req, timeout_ms);
+    }
+#endif
+
+    static inline xf_hal_spi_handle_t s_handle = nullptr;
+};
+#endif // XF_HAL_SPI_IS_ENABLE
+
+} // namespace hal
+} // namespace xf
+
+/* ==================== [Global Prototypes] ================================= */
+
+/* ==================== [Macros] ============================================ */
+
+#endif // __XF_HAL_HPP__
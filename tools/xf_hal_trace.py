@@ -0,0 +1,159 @@
+#!/usr/bin/env python3
+# -*- coding: utf-8 -*-
+"""
+xf_hal 事件跟踪解码工具。
+
+把 xf_hal_trace_dump 导出的二进制数据转换为 Chrome trace 格式的 JSON，
+可以用 chrome://tracing 或 https://ui.perfetto.dev 打开查看。
+每种设备类型显示为一个进程，每个设备显示为一个线程，
+读写、ioctl、回调和中断事件按持续时间显示，可以看出总线占用和回调延迟。
+
+用法：
+    python3 tools/xf_hal_trace.py trace.bin -o trace.json
+"""
+
+import argparse
+import json
+import struct
+import sys
+
+HEADER = struct.Struct("<IHHIIIB3x")
+EVENT = struct.Struct("<IIIBBHIi")
+
+MAGIC = 0x52544658
+VERSION = 1
+NAME_SIZE = 8
+
+EV_NAMES = ["open", "close", "ioctl", "read", "write", "submit", "callback", "isr", "user"]
+EV_SUBMIT = 5
+EV_IOCTL = 2
+
+
+def parse(data):
+    if len(data) < HEADER.size:
+        raise ValueError("trace data too short")
+
+    magic, version, event_size, clock_hz, total, event_num, type_num = HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("bad magic 0x%08x" % magic)
+    if version != VERSION:
+        raise ValueError("unsupported version %d" % version)
+    if event_size < EVENT.size:
+        raise ValueError("bad event size %d" % event_size)
+
+    offset = HEADER.size
+    names = []
+    for _ in range(type_num):
+        raw = data[offset:offset + NAME_SIZE]
+        names.append(raw.split(b"\0", 1)[0].decode("ascii", "replace"))
+        offset += NAME_SIZE
+
+    events = []
+    for _ in range(event_num):
+        if offset + event_size > len(data):
+            break
+        seq, start, duration, ev, dev_type, dev_id, arg, ret = EVENT.unpack_from(data, offset)
+        offset += event_size
+        # seq 为 0 的事件在导出时已被覆盖
+        if seq == 0:
+            continue
+        events.append((seq, start, duration, ev, dev_type, dev_id, arg, ret))
+
+    return {
+        "clock_hz": clock_hz,
+        "total": total,
+        "names": names,
+        "events": events,
+    }
+
+
+def to_chrome(trace):
+    clock_hz = trace["clock_hz"]
+    names = trace["names"]
+    scale = 1000000.0 / clock_hz if clock_hz else 1.0
+
+    out = []
+    threads = set()
+    last = None
+    epoch = 0
+
+    for seq, start, duration, ev, dev_type, dev_id, arg, ret in trace["events"]:
+        # 32 位时间戳回绕时展开为单调时间
+        if last is None:
+            last = start
+        delta = (start - last) & 0xFFFFFFFF
+        if delta < 0x80000000:
+            epoch += delta
+        else:
+            epoch -= 0x100000000 - delta
+        last = start
+
+        dev_name = names[dev_type] if dev_type < len(names) else "type%d" % dev_type
+        ev_name = EV_NAMES[ev] if ev < len(EV_NAMES) else "ev%d" % ev
+        threads.add((dev_type, dev_id, "%s%d" % (dev_name, dev_id)))
+
+        args = {"seq": seq - 1, "ret": ret}
+        if ev == EV_IOCTL:
+            args["cmd"] = "0x%08x" % arg
+        else:
+            args["len"] = arg
+
+        item = {
+            "name": ev_name,
+            "cat": dev_name,
+            "pid": dev_type,
+            "tid": dev_id,
+            "ts": epoch * scale,
+            "args": args,
+        }
+        if ev == EV_SUBMIT:
+            item["ph"] = "i"
+            item["s"] = "t"
+        else:
+            item["ph"] = "X"
+            item["dur"] = duration * scale
+        out.append(item)
+
+    for index, name in enumerate(names):
+        out.append({"name": "process_name", "ph": "M", "pid": index, "args": {"name": name}})
+    for dev_type, dev_id, name in sorted(threads):
+        out.append({"name": "thread_name", "ph": "M", "pid": dev_type, "tid": dev_id, "args": {"name": name}})
+
+    lost = trace["total"] - len(trace["events"])
+    return {
+        "traceEvents": out,
+        "displayTimeUnit": "ns",
+        "otherData": {"total": trace["total"], "lost": lost if lost > 0 else 0},
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description="convert xf_hal trace dump to Chrome trace JSON")
+    parser.add_argument("input", help="binary trace dump, '-' for stdin")
+    parser.add_argument("-o", "--output", default="-", help="output JSON file, default stdout")
+    args = parser.parse_args()
+
+    if args.input == "-":
+        data = sys.stdin.buffer.read()
+    else:
+        with open(args.input, "rb") as f:
+            data = f.read()
+
+    try:
+        trace = parse(data)
+    except ValueError as e:
+        sys.stderr.write("xf_hal_trace: %s\n" % e)
+        return 1
+
+    result = json.dumps(to_chrome(trace), indent=1)
+    if args.output == "-":
+        sys.stdout.write(result + "\n")
+    else:
+        with open(args.output, "w") as f:
+            f.write(result + "\n")
+
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
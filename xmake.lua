@@ -9,10 +9,22 @@ function add_xf_hal()
     add_includedirs("src")
 end 
 
+-- 对接层选择：port 为打印示例，port_sim 按配置参数模拟线上时序（xmake f --port=port_sim）
+option("port")
+    set_default("port")
+    set_values("port", "port_sim")
+    set_showmenu(true)
+    set_description("Select the port directory: port, port_sim")
+option_end()
+
 -- xf_task移植的内容
 function add_port() 
-    add_files("port/*.c")
-    add_includedirs("port")
+    local dir = get_config("port") or "port"
+    add_files(dir .. "/*.c")
+    add_includedirs(dir)
+    if dir == "port_sim" then
+        add_syslinks("pthread")
+    end
 end
 
 -- 模板化添加示例工程
@@ -36,5 +48,90 @@ add_target("uart")
 add_target("i2c")
 add_target("spi")
 
+-- C++17 封装示例
+target("cpp")
+    set_kind("binary")
+    add_cflags("-Wall")
+    add_cflags("-std=gnu99 -O0")
+    add_cxxflags("-Wall")
+    add_cxxflags("-std=c++17 -O0")
+    add_files("example/cpp/*.cpp")
+    add_xf_hal()
+    add_port()
+
+-- C++20 协程示例
+target("cpp_co")
+    set_kind("binary")
+    add_cflags("-Wall")
+    add_cflags("-std=gnu99 -O0")
+    add_cxxflags("-Wall")
+    add_cxxflags("-std=c++20 -O0")
+    add_files("example/cpp_co/*.cpp")
+    add_xf_hal()
+    add_port()
+
+-- 模板化添加性能测试工程
+function add_bench(name, defines)
+    target("bench_" .. name)
+        set_kind("binary")
+        add_cflags("-Wall")
+        add_cflags("-std=gnu99 -O2")
+        add_defines("XF_HAL_LOCK_DISABLE=0")
+        if defines then
+            add_defines(defines)
+        end
+        add_files(string.format("bench/%s/*.c", name))
+        add_files("bench/common/*.c")
+        add_includedirs("bench/common")
+        add_syslinks("pthread")
+        add_xf_hal()
+        add_includedirs("port")
+end
+
+add_bench("kernel")
+add_bench("gpio")
+add_bench("tim")
+add_bench("pwm")
+add_bench("adc")
+add_bench("dac")
+add_bench("uart")
+add_bench("i2c")
+add_bench("spi")
+-- 常驻设备最多 1024 个，另为每个线程的 open/close 留出 fd
+add_bench("posix", {"XF_HAL_POSIX_DISABLE=0", "XF_HAL_POSIX_FD_MAX=1088"})
+
+-- 仿真对接层上的线上吞吐测试，始终使用 port_sim
+target("bench_sim")
+    set_kind("binary")
+    add_cflags("-Wall")
+    add_cflags("-std=gnu99 -O2")
+    add_defines("XF_HAL_LOCK_DISABLE=0")
+    add_files("bench/sim/*.c")
+    add_syslinks("pthread")
+    add_xf_hal()
+    add_files("port_sim/*.c")
+    add_includedirs("port_sim")
 
+-- 仿真对接层上启用 posix 层，使用 poll 等待虚拟时钟上的 uart 数据
+target("sim_poll")
+    set_kind("binary")
+    add_cflags("-Wall")
+    add_cflags("-std=gnu99 -O0")
+    add_defines("XF_HAL_LOCK_DISABLE=0", "XF_HAL_POSIX_DISABLE=0")
+    add_files("example/sim_poll/*.c")
+    add_syslinks("pthread")
+    add_xf_hal()
+    add_files("port_sim/*.c")
+    add_includedirs("port_sim")
 
+-- 仿真对接层上通过发送缓冲区异步发送，检查回调次数与收到的数据
+target("sim_uart_tx")
+    set_kind("binary")
+    add_cflags("-Wall")
+    add_cflags("-std=gnu99 -O0")
+    add_defines("XF_HAL_LOCK_DISABLE=0")
+    add_files("example/sim_uart_tx/*.c")
+    add_syslinks("pthread")
+    add_xf_hal()
+    add_files("port_sim/*.c")
+    add_includedirs("port_sim")